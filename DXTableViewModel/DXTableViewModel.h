@@ -8,13 +8,37 @@
 
 #import <UIKit/UIKit.h>
 
-@class DXTableViewSection, DXTableViewRow;
+@class DXTableViewSection, DXTableViewRow, DXTableViewModel;
+
+/**
+ The `DXTableViewModelInstrumentationSink` protocol is adopted by objects that receive instrumentation events
+ of table view model as they happen.
+
+ @see [DXTableViewModel instrumentationSink]
+ */
+@protocol DXTableViewModelInstrumentationSink <NSObject>
+
+/**
+ Tells the sink that timed event did happen.
+
+ @param tableViewModel Table view model object that did record the event.
+ @param event Name of the event: selector of data source or delegate method, or name of the measured operation
+ (e.g. "rowHeightBlock", "dequeueReusableCell", "configureCell").
+ @param reuseIdentifier Cell reuse identifier of the row the event relates to, or `nil`.
+ @param duration Duration of the event in seconds measured with monotonic clock.
+ */
+- (void)tableViewModel:(DXTableViewModel *)tableViewModel
+        didRecordEvent:(NSString *)event
+       reuseIdentifier:(NSString *)reuseIdentifier
+              duration:(NSTimeInterval)duration;
+
+@end
 
 /**
  `DXTableViewModel` represents data for table view. Essentially it is table view's delegate and datasource
  which customizes table view according to data that being provided by section and row objects.
  */
-@interface DXTableViewModel : NSObject <UITableViewDataSource, UITableViewDelegate>
+@interface DXTableViewModel : NSObject <UITableViewDataSource, UITableViewDelegate, UITableViewDataSourcePrefetching>
 
 /// @name General methods and properties
 #pragma mark - General methods and properties
@@ -23,6 +47,12 @@
  An table view object to be configured by receiver.
  
  Setter sets data source and delegate properties of given table view to the receiver.
+
+ Receiver responds to optional delegate methods for row and section heights, header and footer views and display
+ notifications only while some row or section needs them. Otherwise heights shared by all rows, headers or footers
+ are set to table view's `rowHeight`, `sectionHeaderHeight` and `sectionFooterHeight`, except for
+ `UITableViewAutomaticDimension`, which leaves table view's own heights. Table view's `estimatedRowHeight` is never
+ changed. When rows need another set of methods during a transaction, delegate is reassigned once after it.
  */
 @property (strong, nonatomic) UITableView *tableView;
 
@@ -37,6 +67,7 @@
  as result of data source method.
  
  @see sectionForSectionIndexTitleAtIndexBlock
+ @see groupItems:withCollation:keyBlock:rowBlock:animated:
  */
 @property (copy, nonatomic) NSArray *(^sectionIndexTitlesBlock)();
 
@@ -48,6 +79,7 @@
  Block won't be invoked unless [DXTableViewModel sectionIndexTitlesBlock] is provided.
  
  @see sectionIndexTitlesBlock
+ @see groupItems:withCollation:keyBlock:rowBlock:animated:
  */
 @property (copy, nonatomic) NSInteger (^sectionForSectionIndexTitleAtIndexBlock)(NSString *title, NSInteger index);
 
@@ -103,6 +135,17 @@
  */
 @property (nonatomic) BOOL showsDefaultTitleForDeleteConfirmationButton;
 
+/**
+ Number of `registerClass:` and `registerNib:` messages that the receiver sent to `tableView` for cells and
+ header-footer views since `tableView` was set.
+
+ The receiver remembers which class or nib was registered for each reuse identifier and skips registrations
+ that were already made, so this number grows with the number of distinct reuse identifiers rather than with
+ the number of rows. Registering different classes or nibs for one reuse identifier fails an assertion, when
+ assertions are disabled the latest registration wins, the same way as in `UITableView`.
+ */
+@property (nonatomic, readonly) NSUInteger numberOfRegistrations;
+
 /**
  Designated initializer. Returns configured table view model object.
  
@@ -133,6 +176,18 @@
  */
 - (void)insertSection:(DXTableViewSection *)section atIndex:(NSInteger)index;
 
+/**
+ Inserts section objects from given `sections` array at the given `indexes` into the receiver's contents in one step.
+ Order of the given `sections` is preserved.
+
+ @param sections An array containing section objects. Raises NSInvalidArgumentException if any section name is already
+ used in the receiver's contents or is repeated within `sections`.
+
+ @param indexes The indexes in the receiver's content at which to insert `sections` objects. The count of locations
+ in `indexes` must equal the count of `sections`. See `-[NSMutableArray insertObjects:atIndexes:]` for details.
+ */
+- (void)insertSections:(NSArray *)sections atIndexes:(NSIndexSet *)indexes;
+
 /**
  Removes section object from the receiver's contents.
  
@@ -155,6 +210,23 @@
  */
 - (NSInteger)indexOfSectionWithName:(NSString *)name;
 
+/**
+ Returns row object located at the given `indexPath`.
+
+ @param indexPath Index path object that identifies section and row in the receiver's contents.
+ */
+- (DXTableViewRow *)rowAtIndexPath:(NSIndexPath *)indexPath;
+
+/**
+ Returns row object located at the given `rowIndex` in the section at the given `sectionIndex`.
+
+ This method neither allocates index path object nor copies rows of the section, so it is suitable for frequent calls.
+
+ @param rowIndex The index of row in the section.
+ @param sectionIndex The index of section in the receiver's contents.
+ */
+- (DXTableViewRow *)rowAtIndex:(NSInteger)rowIndex inSectionAtIndex:(NSInteger)sectionIndex;
+
 /// @name Model building convenience methods
 #pragma mark - Model building convenience methods
 
@@ -211,19 +283,37 @@
 #pragma mark - Animated sections manipulations
 
 /**
- Begins series of method calls that manipulates sections with animation. Calls table view's beginUpdates method.
- 
+ Begins series of method calls that manipulate sections and rows. Calls table view's beginUpdates method.
+
+ Manipulations of sections and rows made until matching `endUpdates` call, animated or not, are not sent to table
+ view one by one: the receiver remembers rows of each section right before their first change and computes the
+ difference of changed sections on `endUpdates`, so a transaction costs as much as the sections it touches. Therefore
+ manipulations can be mixed in any order, rows inserted and then deleted cancel each other, and subsequent moves are
+ composed. Calls can be nested.
+
+ @warning Don't send insert, delete, move or reload messages to table view yourself between the calls: the receiver
+ already sends them for its own changes, so table view would get them twice.
+
  @see endUpdates
+ @see updating
  */
 - (void)beginUpdates;
 
 /**
- Ends series of method calls that manipulates sections with animation. Calls table view's endUpdates method.
- 
+ Ends series of method calls that manipulate sections and rows. On the outermost call sends minimal set of section
+ and row insertions, deletions, moves and reloads to table view and calls table view's endUpdates method. Sections
+ and rows keep the animation of the manipulation which inserted, deleted or reloaded them, the rest of changes are
+ animated with the animation of the last animated manipulation.
+
  @see beginUpdates
  */
 - (void)endUpdates;
 
+/**
+ Boolean value that indicates whether the receiver is between `beginUpdates` and `endUpdates` calls.
+ */
+@property (nonatomic, readonly, getter = isUpdating) BOOL updating;
+
 /**
  Inserts `newSection` object into receiver's contents after section with `name` and appropriate section into table view 
  with given `animation`.
@@ -275,19 +365,324 @@ beforeSectionWithName:(NSString *)name
  */
 - (void)moveSectionWithName:(NSString *)name animatedToSectionWithName:(NSString *)otherName;
 
+/// @name Row heights
+#pragma mark - Row heights
+
+/**
+ Returns height of given `row` object. Height produced by `[DXTableViewRow rowHeightBlock]` is cached until
+ the row is reloaded, its bound data is reloaded, or width of `tableView` changes.
+
+ @param row The row object inserted into the receiver.
+ */
+- (CGFloat)heightForRow:(DXTableViewRow *)row;
+
+/**
+ Starts measuring heights of rows that provide `[DXTableViewRow rowHeightForWidthBlock]` on a background queue.
+ Rows are measured in chunks walking outward from the middle of the visible window, each chunk is measured by single
+ operation and applied on the main queue before the next one is taken. The walk restarts from the new middle when
+ the visible window moves, so rows near it are measured first.
+
+ Invoked automatically when table view asks for height of such row that was not measured yet. Measurements in progress
+ are cancelled when bound data of the row is reloaded or width of `tableView` changes.
+ */
+- (void)precomputeRowHeights;
+
+/**
+ Starts measuring heights of rows of given `section` that provide `[DXTableViewRow rowHeightForWidthBlock]`
+ or size to their texts (see `[DXTableViewRow sizesRowHeightToCellText]`) on a background queue.
+
+ Use it to measure rows of a section before it is displayed, e.g. right after it is inserted.
+
+ @param section Section object inserted into the receiver.
+ */
+- (void)precomputeRowHeightsOfSection:(DXTableViewSection *)section;
+
+/**
+ Discards cached height of given `row` object.
+
+ @param row The row object inserted into the receiver.
+ */
+- (void)invalidateHeightForRow:(DXTableViewRow *)row;
+
+/**
+ Discards cached heights of all rows.
+ */
+- (void)invalidateRowHeights;
+
+/**
+ Total height of rows, headers and footers in the receiver's contents. Rows whose heights were not measured yet
+ contribute their estimated heights, headers and footers with `UITableViewAutomaticDimension` height contribute zero.
+ Virtualized sections are accounted as single span of rows of default height, so they cost the same however many rows
+ they have. Computed in O(log n) time from prefix sums of row heights.
+
+ Inserting or removing single row keeps known heights of other rows, the prefix sums are then constructed again
+ in linear time without asking rows for heights. Other changes of rows or sections ask every row for its height
+ again. Width change of table view asks only rows of sections whose rows don't share one fixed height.
+ */
+@property (nonatomic, readonly) CGFloat contentHeight;
+
+/**
+ Returns index path of the row located at given vertical `offset` from the top of content, or `nil` if there is
+ header, footer or nothing at that offset. Heights are accounted the same way as in `contentHeight`.
+ Computed in O(log n) time.
+
+ @param offset Vertical offset from the top of content.
+ */
+- (NSIndexPath *)indexPathForRowAtOffset:(CGFloat)offset;
+
+/// @name Snapshots
+#pragma mark - Snapshots
+
+/**
+ Replaces the receiver's contents with given `sections` and updates table view with minimal set of animated changes.
+
+ Sections are matched by `sectionName` and rows are matched by `[DXTableViewRow rowIdentifier]`. The difference between
+ current contents and `sections` is sent to table view as single `beginUpdates`/`endUpdates` batch of section and row
+ insertions, deletions, moves and reloads. Only sections and rows outside of the longest run which keeps its relative
+ order are moved, so the difference is computed in O(n log n) time for n rows. Matched rows are reloaded when
+ row objects differ.
+
+ Sections and rows that are already inserted into the receiver must not be altered before this call,
+ new section objects must be built instead. Section and row objects from `sections` are adopted by the receiver.
+
+ @param sections An array of section objects that represent desired contents. Section names must be unique.
+ @param animated If YES changes are animated with `UITableViewRowAnimationAutomatic`, otherwise table view is reloaded.
+ @see applySnapshot:withRowAnimation:
+ */
+- (void)applySnapshot:(NSArray *)sections animated:(BOOL)animated;
+
+/**
+ Replaces the receiver's contents with given `sections` and updates table view with minimal set of changes
+ animated with given `animation`.
+
+ Between beginUpdates and endUpdates the difference is computed once by endUpdates, which uses the animation
+ given last.
+
+ @param sections An array of section objects that represent desired contents. Section names must be unique.
+ @param animation A constant that indicates how insertions, deletions and reloads are to be animated.
+ @see applySnapshot:animated:
+ */
+- (void)applySnapshot:(NSArray *)sections withRowAnimation:(UITableViewRowAnimation)animation;
+
+/// @name Grouping
+#pragma mark - Grouping
+
+/**
+ Replaces sections of previously grouped items, if there are any, with sections built by grouping `items` by
+ `collation`. Other sections of the receiver stay where they are, sections of groups take the place of previous
+ groups or follow other sections. Names of other sections must differ from collation section titles.
+
+ Each item is placed into the collation section of the string returned by `keyBlock`, one `DXTableViewSection` per
+ non-empty collation section. Sections are named and titled by collation section titles and rows of each section are
+ sorted by localized comparison of item keys. Rows are created by `rowBlock`. While items are grouped, section index
+ titles are `[UILocalizedIndexedCollation sectionIndexTitles]` and section index titles are resolved to sections in
+ O(log n) time, unless `sectionIndexTitlesBlock` and `sectionForSectionIndexTitleAtIndexBlock` are provided.
+
+ @param items An array of items to group. Items must be unique.
+ @param collation Collation which defines groups and their order.
+ @param keyBlock Block which returns the string item is grouped and sorted by.
+ @param rowBlock Block which returns a new row for item.
+ @param animated If YES changes are animated as in `applySnapshot:animated:`, otherwise table view is reloaded.
+ */
+- (void)groupItems:(NSArray *)items
+     withCollation:(UILocalizedIndexedCollation *)collation
+          keyBlock:(NSString *(^)(id item))keyBlock
+          rowBlock:(DXTableViewRow *(^)(id item))rowBlock
+          animated:(BOOL)animated;
+
+/**
+ Adds `items` to their groups. Only sections of added items are changed, section is inserted if its group was empty.
+ Several items are inserted in one batch of updates.
+
+ @param items An array of items which aren't grouped yet.
+ @param animation Animation used for inserted sections and rows.
+ */
+- (void)insertGroupedItems:(NSArray *)items withRowAnimation:(UITableViewRowAnimation)animation;
+
+/**
+ Removes `items` from their groups. Only sections of removed items are changed, section is deleted once its group
+ becomes empty. Several items are deleted in one batch of updates.
+
+ @param items An array of grouped items.
+ @param animation Animation used for deleted sections and rows.
+ */
+- (void)deleteGroupedItems:(NSArray *)items withRowAnimation:(UITableViewRowAnimation)animation;
+
+/**
+ Moves `items` whose keys have changed to their new groups and positions, in one batch of updates.
+
+ @param items An array of grouped items.
+ @param animation Animation used for changed sections and rows.
+ */
+- (void)regroupItems:(NSArray *)items withRowAnimation:(UITableViewRowAnimation)animation;
+
+/**
+ Returns row of grouped `item` or `nil` if item isn't grouped.
+
+ @param item Grouped item.
+ */
+- (DXTableViewRow *)rowForGroupedItem:(id)item;
+
+/// @name Filtering
+#pragma mark - Filtering
+
+/**
+ Block object which decides whether row matches filter query. Takes two parameters: `boundData` - copy of row's bound
+ data (values accessible via subscript) along with row's `cellText` and `cellDetailText` under keys of the same names
+ unless bound data has such keys, and `query` - the query rows are filtered with. Block is invoked on background
+ queue.
+
+ @see filterRowsWithQuery:
+ @see filterNarrowsWithQueryPrefix
+ */
+@property (copy, nonatomic) BOOL (^filterBlock)(NSDictionary *boundData, NSString *query);
+
+/**
+ Predicate which is evaluated against the same copy of row's data as `filterBlock`, with `$query` variable substituted
+ by filter query, when `filterBlock` is `nil`. Predicate is evaluated on background queue.
+
+ @see filterRowsWithQuery:
+ @see filterNarrowsWithQueryPrefix
+ */
+@property (strong, nonatomic) NSPredicate *filterPredicate;
+
+/**
+ Boolean value that indicates whether a query which extends query of the currently shown result is evaluated only
+ against rows of that result. Set it to YES only if every row which matches a query matches every prefix of it, as
+ substring and prefix matches do. Default is NO, which means every query is evaluated against all rows.
+ */
+@property (nonatomic) BOOL filterNarrowsWithQueryPrefix;
+
+/**
+ Block object to be invoked on main queue after filtered rows have been published to table view.
+ */
+@property (copy, nonatomic) void (^didFilterRowsBlock)(DXTableViewModel *tableViewModel);
+
+/**
+ Query rows were last filtered with or `nil` if rows aren't filtered.
+ */
+@property (copy, nonatomic, readonly) NSString *filterQuery;
+
+/**
+ Filters rows of the receiver's sections with `query` using `filterBlock` or `filterPredicate`.
+
+ Rows are evaluated on background queue, evaluation of previous query is cancelled. When
+ `filterNarrowsWithQueryPrefix` is YES and `query` extends query of the currently shown result, only rows of that result
+ are evaluated. Result is applied to sections on main queue, rows that don't match are hidden without being copied or
+ detached from their sections, and table view receives a batch of animated row deletions and insertions, or is reloaded
+ when more than a thousand rows change. Copies of data of evaluated rows are taken on main queue before evaluation
+ begins and are kept by rows until their data changes, so evaluation never waits for main queue. Rows of virtualized and paged sections aren't filtered. Rows of filtered sections cannot be inserted, removed or moved.
+
+ @param query Query to filter rows with. Passing `nil` or empty string shows all rows immediately.
+ */
+- (void)filterRowsWithQuery:(NSString *)query;
+
+/**
+ Returns index path of the row at given filtered `indexPath` among all rows of its section.
+
+ @param indexPath Index path of a row shown by table view.
+ */
+- (NSIndexPath *)unfilteredIndexPathForIndexPath:(NSIndexPath *)indexPath;
+
+/**
+ Returns index path at which table view shows the row with given unfiltered `indexPath`, or `nil` if row is hidden.
+
+ @param indexPath Index path of a row among all rows of its section.
+ */
+- (NSIndexPath *)indexPathForUnfilteredIndexPath:(NSIndexPath *)indexPath;
+
+/// @name Prefetching
+#pragma mark - Prefetching
+
+/**
+ Maximum number of rows which prefetch blocks are running at once. Other rows wait in queue in order they were
+ requested by table view. Default is 4.
+
+ @see [DXTableViewRow prefetchBlock]
+ */
+@property (nonatomic) NSUInteger maximumNumberOfConcurrentPrefetches;
+
+/// @name Image cache
+#pragma mark - Image cache
+
+/**
+ Maximum number of bytes that decoded images of rows may occupy in the receiver's image cache. Least recently used
+ images are evicted first. Cache is also emptied on memory warning. Default is 20 MB.
+
+ @see [DXTableViewRow cellImageKey]
+ */
+@property (nonatomic) NSUInteger imageCacheByteBudget;
+
+/**
+ Discards all cached images.
+ */
+- (void)removeAllCachedImages;
+
+/// @name Instrumentation
+#pragma mark - Instrumentation
+
+/**
+ Boolean value that indicates whether the receiver measures its work. Default is NO.
+
+ When enabled, every data source and delegate method called by table view is timed, as well as dequeueing,
+ configuring cells and invoking blocks that compute cells, heights and section header and footer views, as well as
+ display and selection blocks. Durations are aggregated into histograms per event and per cell or header footer view
+ reuse identifier and are available via `instrumentationStatistics`. When disabled table view talks to the receiver
+ directly and the measured paths cost a nil check per step.
+
+ @see instrumentationSink
+ */
+@property (nonatomic, getter = isInstrumentationEnabled) BOOL instrumentationEnabled;
+
+/**
+ Object that receives every instrumentation event as it happens. Default is `nil`.
+ */
+@property (weak, nonatomic) id <DXTableViewModelInstrumentationSink> instrumentationSink;
+
+/**
+ Returns statistics collected since instrumentation was enabled or statistics were reset.
+
+ Dictionary contains three dictionaries: "events" maps event names to statistics, "reuseIdentifiers" maps cell reuse
+ identifiers to dictionaries of their events' statistics and "counters" maps names of counted events ("dequeue",
+ "configure", "blockInvocation", "prefetchHit", "prefetchMiss", "textMeasurementHit", "textMeasurementMiss") to numbers.
+ Statistics of an event are "count", "p50", "p99" and "max", durations are in seconds. Percentiles are approximated with logarithmic histogram buckets (within 10%).
+
+ @return Dictionary of statistics or `nil` if instrumentation is disabled.
+ */
+- (NSDictionary *)instrumentationStatistics;
+
+/**
+ Discards collected instrumentation statistics.
+ */
+- (void)resetInstrumentationStatistics;
+
 /// @name Data binding capabilities
 #pragma mark - Data binding capabilities
 
 /**
- Reloads data from boud object for each row.
+ Reloads data from boud object for each row. Only materialized rows of virtualized sections are reloaded.
  */
 - (void)reloadRowBoundData;
 
 /**
- Updates bound object of each row.
+ Updates bound object of each row which bound data was modified.
+ 
+ Rows report modifications of their bound data to the receiver, so only modified rows are visited and only modified
+ values are written: the cost depends on the number of edits rather than on the number of rows. Rows of virtualized
+ sections write their data when they are evicted.
+
+ @see updateRowObjectsReturningWrittenKeyPaths
+ @see [DXTableViewRow updateObject]
  */
 - (void)updateRowObjects;
 
+/**
+ Updates bound objects of modified rows like `updateRowObjects` does.
+
+ @return Map table of rows which bound objects were updated to sets of written key paths.
+ */
+- (NSMapTable *)updateRowObjectsReturningWrittenKeyPaths;
+
 @end
 
 #import "DXTableViewSection.h"
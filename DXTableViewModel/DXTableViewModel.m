@@ -9,12 +9,39 @@
 #import "DXTableViewModel.h"
 #import "DXTableViewSection.h"
 #import "DXTableViewRow.h"
+#import <mach/mach_time.h>
+
+static NSUInteger DXTableViewModelSectionsGeneration = 0;
+
+// rows measured by one background operation
+static const NSUInteger DXTableViewModelRowHeightChunkSize = 64;
+
+// Optional table view delegate methods which the model responds to only when some row or section needs them
+typedef NS_OPTIONS(NSUInteger, DXTableViewModelCallback) {
+    DXTableViewModelCallbackHeightForRow = 1 << 0,
+    DXTableViewModelCallbackWillDisplayCell = 1 << 1,
+    DXTableViewModelCallbackHeightForHeader = 1 << 2,
+    DXTableViewModelCallbackHeightForFooter = 1 << 3,
+    DXTableViewModelCallbackViewForHeader = 1 << 4,
+    DXTableViewModelCallbackViewForFooter = 1 << 5,
+    DXTableViewModelCallbackWillDisplayHeaderView = 1 << 6,
+    DXTableViewModelCallbackWillDisplayFooterView = 1 << 7,
+    DXTableViewModelCallbackDidEndDisplayingCell = 1 << 8,
+    DXTableViewModelCallbackDidEndDisplayingHeaderView = 1 << 9,
+    DXTableViewModelCallbackDidEndDisplayingFooterView = 1 << 10
+};
+
+typedef NS_ENUM(NSInteger, DXTableViewRowPrefetchState) {
+    DXTableViewRowPrefetchStateNone = 0,
+    DXTableViewRowPrefetchStatePending,
+    DXTableViewRowPrefetchStateLoading,
+    DXTableViewRowPrefetchStateDone
+};
 
 /* TODO
  - add reload sections method
  - check animated sections manipulations (check nested and grouped manipulations precisely)
  - implement missing delegate methods (those that were added in iOS 7)
- - rethink about section titles implementation, make it object oriented (e.g. per section title)
  - remove `__weak` for every row that is pass to row's block as argument (?)
  - add animation types properties: insertRowAnimation, deleteRowAnimation
  - add tests
@@ -24,264 +51,3318 @@
 @interface DXTableViewRow (ForTableViewModelEyes)
 
 @property (strong, nonatomic) id cell;
+@property (nonatomic) CGFloat cachedRowHeight;
+@property (nonatomic) NSUInteger cachedRowHeightGeneration;
+@property (nonatomic) NSUInteger rowHeightToken;
+@property (nonatomic) NSUInteger mergedRowCallbacks;
+@property (nonatomic) CGFloat mergedRowHeight;
+@property (strong, nonatomic) NSMutableDictionary *boundObjectData;
+@property (nonatomic) NSInteger prefetchState;
+@property (nonatomic) NSUInteger prefetchToken;
+@property (strong, nonatomic) NSArray *prefetchedKeyPaths;
+@property (nonatomic) NSUInteger preparedContentToken;
+@property (strong, nonatomic) id cellImageCacheKey;
+
++ (NSUInteger)templateGeneration;
+- (BOOL)reloadChangedBoundData;
+- (BOOL)hasPreparedContent;
+- (void)setPreparedContent:(id)content preparedWithBlock:(id (^)(NSDictionary *))block;
+- (void)setBoundValue:(id)value forKeyPath:(NSString *)keyPath;
+- (void)didChangeBoundData;
+- (NSDictionary *)filterData;
 
 @end
 
 @interface DXTableViewSection (ForTableViewModelEyes)
 
+- (DXTableViewRow *)existingRowAtIndex:(NSInteger)index;
+- (NSArray *)existingRows;
+
 @property (strong, nonatomic) DXTableViewModel *tableViewModel;
 
-@property (strong, nonatomic) UIView *headerView;
-@property (strong, nonatomic) UIView *footerView;
+@property (strong, nonatomic) UIView *headerView;
+@property (strong, nonatomic) UIView *footerView;
+
+@property (nonatomic) NSInteger cachedSectionIndex;
+@property (nonatomic) NSUInteger cachedSectionIndexGeneration;
+
+@property (copy, nonatomic, readonly) NSArray *unfilteredRows;
+@property (copy, nonatomic, readonly) NSIndexSet *filteredRowIndexes;
+
+- (void)registerNibOrClassForRows;
+- (void)filterRowsAtIndexes:(NSIndexSet *)indexes;
+- (BOOL)removeRowFilter;
+- (BOOL)sortsRows;
+- (void)loadPagesNearRowAtIndex:(NSInteger)index;
+
+@property (nonatomic) NSUInteger summarizedRowCallbacks;
+@property (nonatomic) CGFloat summarizedRowHeight;
+@property (nonatomic) BOOL rowCallbacksSummarized;
+@property (nonatomic) BOOL rowCallbacksSummaryExact;
+
+@end
+
+@class DXTableViewModelInstrumentation, DXTableViewModelInstrumentingProxy;
+
+@interface DXTableViewModel ()
+{
+    CGFloat *_slotHeights;
+    CGFloat *_heightTree;
+    NSUInteger *_sectionSlotStarts;
+    NSUInteger _slotCount;
+    NSUInteger _slotCapacity;
+    BOOL _heightTreeNeedsRebuild;
+    BOOL _heightTreeNeedsConstruction;
+    BOOL _rowHeightPrecomputationScheduled;
+    BOOL _rowHeightChunkInFlight;
+    BOOL _changedBoundDataReloadScheduled;
+    NSInteger _updatesDepth;
+    UITableViewRowAnimation _updatesAnimation;
+    NSUInteger _filterToken;
+    NSUInteger _neededCallbacks;
+    CGFloat _uniformRowHeight;
+    CGFloat _uniformHeaderHeight;
+    CGFloat _uniformFooterHeight;
+    NSUInteger _pushedUniformHeights;
+    BOOL _neededCallbacksUpdateScheduled;
+    BOOL _delegateRearmNeeded;
+    BOOL _relayoutNeeded;
+    BOOL _rowTemplateCheckScheduled;
+}
+
+@property (strong, nonatomic) NSMutableArray *mutableSections;
+@property (strong, nonatomic) NSMutableDictionary *sectionByName;
+@property (nonatomic) NSUInteger sectionsGeneration;
+@property (nonatomic) NSUInteger indexedSectionsGeneration;
+@property (strong, nonatomic) NSMutableDictionary *registeredCellNibOrClassByIdentifier;
+@property (strong, nonatomic) NSMutableDictionary *registeredHeaderFooterNibOrClassByIdentifier;
+@property (nonatomic) NSUInteger numberOfRegistrations;
+
+@property (nonatomic) NSUInteger rowHeightsGeneration;
+@property (nonatomic) CGFloat rowHeightsWidth;
+@property (nonatomic) NSUInteger rowTemplateGeneration;
+@property (strong, nonatomic) NSOperationQueue *rowHeightQueue;
+@property (strong, nonatomic) NSHashTable *rowsBeingMeasured;
+@property (strong, nonatomic) NSIndexPath *rowHeightCursorCenter;
+@property (strong, nonatomic) NSIndexPath *rowHeightForwardCursor;
+@property (strong, nonatomic) NSIndexPath *rowHeightBackwardCursor;
+
+@property (strong, nonatomic) NSMutableOrderedSet *rowsWithChangedBoundData;
+@property (strong, nonatomic) NSMutableOrderedSet *rowsWithModifiedBoundData;
+
+@property (strong, nonatomic) NSMutableOrderedSet *rowsWaitingForPrefetch;
+@property (strong, nonatomic) NSMutableSet *prefetchingRows;
+
+@property (strong, nonatomic) NSOperationQueue *contentPreparationQueue;
+@property (strong, nonatomic) NSHashTable *rowsBeingPrepared;
+
+@property (strong, nonatomic) DXTableViewModelImageCache *imageCache;
+
+@property (strong, nonatomic) DXTableViewModelInstrumentation *instrumentation;
+@property (strong, nonatomic) DXTableViewModelInstrumentingProxy *instrumentingProxy;
+
+@property (strong, nonatomic) UILocalizedIndexedCollation *groupingCollation;
+@property (copy, nonatomic) NSString *(^groupingKeyBlock)(id item);
+@property (copy, nonatomic) DXTableViewRow *(^groupingRowBlock)(id item);
+@property (copy, nonatomic) NSArray *groupedSectionIndexTitles;
+@property (strong, nonatomic) NSMutableArray *groupSections;
+@property (strong, nonatomic) NSMutableArray *groupCollationIndexes;
+@property (strong, nonatomic) NSMutableDictionary *groupKeysBySectionName;
+@property (strong, nonatomic) NSMapTable *groupedRowByItem;
+@property (strong, nonatomic) NSMapTable *groupedKeyByRow;
+
+@property (copy, nonatomic) NSString *filterQuery;
+@property (strong, nonatomic) NSOperationQueue *filterQueue;
+@property (strong, nonatomic) NSArray *filteredSections;
+@property (strong, nonatomic) NSArray *filteredRows;
+@property (copy, nonatomic) NSString *shownFilterQuery;
+@property (strong, nonatomic) NSArray *shownFilterIndexes;
+
+@property (strong, nonatomic) NSArray *sectionsBeforeUpdates;
+@property (strong, nonatomic) NSArray *sectionNamesBeforeUpdates;
+@property (strong, nonatomic) NSSet *sectionSetBeforeUpdates;
+@property (strong, nonatomic) NSMapTable *rowsBeforeUpdates;
+@property (strong, nonatomic) NSMapTable *rowAnimationsOnEndUpdates;
+@property (strong, nonatomic) NSMutableDictionary *sectionAnimationsOnEndUpdates;
+@property (strong, nonatomic) NSMutableSet *rowsReloadedOnEndUpdates;
+@property (strong, nonatomic) NSMutableSet *sectionNamesReloadedOnEndUpdates;
+
+- (DXTableViewRow *)existingRowAtIndexPath:(NSIndexPath *)indexPath;
+
+@end
+
+// Rows of section as captured for diffing, virtualized sections are captured by number of rows
+static id DXSectionContentsRows(DXTableViewSection *section)
+{
+    return section.isVirtualized ? @(section.numberOfRows) : section.rows;
+}
+
+// Fenwick tree over height slots: header, rows and footer of each section
+static void DXHeightTreeAdd(CGFloat *tree, NSUInteger count, NSUInteger slot, CGFloat delta)
+{
+    for (NSUInteger i = slot + 1; i <= count; i += i & (~i + 1))
+        tree[i - 1] += delta;
+}
+
+// Returns sum of heights of first `slotCount` slots
+static CGFloat DXHeightTreePrefixSum(CGFloat *tree, NSUInteger slotCount)
+{
+    CGFloat sum = 0;
+    for (NSUInteger i = slotCount; i > 0; i -= i & (~i + 1))
+        sum += tree[i - 1];
+    return sum;
+}
+
+// Returns index of the slot containing given offset, `count` if offset is beyond the total height
+static NSUInteger DXHeightTreeSlotAtOffset(CGFloat *tree, NSUInteger count, CGFloat offset)
+{
+    NSUInteger position = 0;
+    NSUInteger step = 1;
+    while (step <= count / 2)
+        step <<= 1;
+    for (; step > 0; step >>= 1) {
+        if (position + step <= count && tree[position + step - 1] <= offset) {
+            position += step;
+            offset -= tree[position - 1];
+        }
+    }
+    return position;
+}
+
+// Widths which accessories take from content view of UITableViewCell
+static const CGFloat DXCellDisclosureIndicatorWidth = 33;
+static const CGFloat DXCellDetailDisclosureButtonWidth = 67;
+static const CGFloat DXCellCheckmarkWidth = 39;
+static const CGFloat DXCellDetailButtonWidth = 47;
+
+// Sizes of system fonts of UITableViewCell labels, used when row doesn't give its fonts
+static const CGFloat DXCellTextFontSize = 17;
+static const CGFloat DXCellDetailTextFontSize = 12;
+
+/**
+ Key of measured text height. Text is kept by reference rather than formatted into a string, and is compared only
+ when everything else matches.
+ */
+@interface DXTextHeightKey : NSObject {
+    NSString *_text;
+    UIFont *_font;
+    NSInteger _numberOfLines;
+    NSInteger _width;
+    NSUInteger _hash;
+}
+
+- (instancetype)initWithText:(NSString *)text font:(UIFont *)font numberOfLines:(NSInteger)numberOfLines width:(NSInteger)width;
+
+@end
+
+@implementation DXTextHeightKey
+
+- (instancetype)initWithText:(NSString *)text font:(UIFont *)font numberOfLines:(NSInteger)numberOfLines width:(NSInteger)width
+{
+    self = [super init];
+    if (self) {
+        _text = text;
+        _font = font;
+        _numberOfLines = numberOfLines;
+        _width = width;
+        _hash = text.hash ^ (font.hash * 31) ^ ((NSUInteger)numberOfLines * 131) ^ ((NSUInteger)width * 8191);
+    }
+    return self;
+}
+
+- (NSUInteger)hash
+{
+    return _hash;
+}
+
+- (BOOL)isEqual:(id)object
+{
+    if (self == object)
+        return YES;
+    if (![object isKindOfClass:[DXTextHeightKey class]])
+        return NO;
+    DXTextHeightKey *key = object;
+    return _hash == key->_hash && _width == key->_width && _numberOfLines == key->_numberOfLines &&
+        [_font isEqual:key->_font] && [_text isEqualToString:key->_text];
+}
+
+@end
+
+// Heights of measured texts shared by all rows, keyed by font, number of lines, whole points of width and text
+static CGFloat DXTextHeight(NSString *text, UIFont *font, NSInteger numberOfLines, CGFloat width, BOOL *cacheHit)
+{
+    static NSCache *heightByKey;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        heightByKey = [[NSCache alloc] init];
+        heightByKey.countLimit = 10000;
+    });
+
+    DXTextHeightKey *key = [[DXTextHeightKey alloc] initWithText:text font:font numberOfLines:numberOfLines
+                                                           width:(NSInteger)floor(width)];
+    NSNumber *cachedHeight = [heightByKey objectForKey:key];
+    if (NULL != cacheHit)
+        *cacheHit = nil != cachedHeight;
+    if (nil != cachedHeight)
+        return (CGFloat)cachedHeight.doubleValue;
+
+    CGFloat maximumHeight = numberOfLines > 0 ? font.lineHeight * numberOfLines : CGFLOAT_MAX;
+    CGRect rect = [text boundingRectWithSize:CGSizeMake(floor(width), maximumHeight)
+                                     options:NSStringDrawingUsesLineFragmentOrigin
+                                  attributes:@{NSFontAttributeName: font}
+                                     context:nil];
+    CGFloat height = MIN(ceil(CGRectGetHeight(rect)), ceil(maximumHeight));
+    [heightByKey setObject:@(height) forKey:key];
+    return height;
+}
+
+// Width which accessory of given type takes from cell's content view
+static CGFloat DXCellAccessoryWidth(UITableViewCellAccessoryType accessoryType)
+{
+    switch (accessoryType) {
+        case UITableViewCellAccessoryDisclosureIndicator:
+            return DXCellDisclosureIndicatorWidth;
+        case UITableViewCellAccessoryDetailDisclosureButton:
+            return DXCellDetailDisclosureButtonWidth;
+        case UITableViewCellAccessoryCheckmark:
+            return DXCellCheckmarkWidth;
+        case UITableViewCellAccessoryDetailButton:
+            return DXCellDetailButtonWidth;
+        default:
+            return 0;
+    }
+}
+
+// Returns block that measures row's texts without touching the row, so it can be invoked on any thread.
+// Texts are measured for the width left by accessory and image view, separator is added to the height.
+static CGFloat (^DXCellTextHeightBlock(DXTableViewRow *row, CGFloat separatorHeight))(CGFloat width, BOOL *cacheHit)
+{
+    NSString *text = row.cellText;
+    NSString *detailText = row.cellDetailText;
+    UIFont *font = nil != row.cellTextFont ? row.cellTextFont : [UIFont systemFontOfSize:DXCellTextFontSize];
+    UIFont *detailFont = nil != row.cellDetailTextFont ? row.cellDetailTextFont : [UIFont systemFontOfSize:DXCellDetailTextFontSize];
+    NSInteger numberOfLines = row.cellTextNumberOfLines;
+    NSInteger detailNumberOfLines = row.cellDetailTextNumberOfLines;
+    UIEdgeInsets insets = row.cellTextInsets;
+    CGFloat imageWidth = row.cellImageSize.width > 0 ? row.cellImageSize.width : row.cellImage.size.width;
+    // image view is as far from texts as from cell's leading edge
+    CGFloat occupiedWidth = DXCellAccessoryWidth(row.cellAccessoryType) + (imageWidth > 0 ? imageWidth + insets.left : 0);
+    CGFloat minimumHeight = UITableViewAutomaticDimension != row.rowHeight ? row.rowHeight : 0;
+    return ^CGFloat (CGFloat width, BOOL *cacheHit) {
+        CGFloat textWidth = MAX(width - occupiedWidth - insets.left - insets.right, 1);
+        CGFloat height = insets.top + insets.bottom + separatorHeight;
+        BOOL textCacheHit = YES;
+        BOOL detailTextCacheHit = YES;
+        if (text.length > 0)
+            height += DXTextHeight(text, font, numberOfLines, textWidth, &textCacheHit);
+        if (detailText.length > 0)
+            height += DXTextHeight(detailText, detailFont, detailNumberOfLines, textWidth, &detailTextCacheHit);
+        if (NULL != cacheHit)
+            *cacheHit = textCacheHit && detailTextCacheHit;
+        return MAX(height, minimumHeight);
+    };
+}
+
+// Logarithmic histogram of durations: 8 buckets per power of two of nanoseconds, i.e. each bucket is ~9% wide
+#define DXHistogramBucketsPerPowerOfTwo 8
+#define DXHistogramBucketCount (64 * DXHistogramBucketsPerPowerOfTwo)
+
+@interface DXTableViewModelHistogram : NSObject {
+    uint64_t _buckets[DXHistogramBucketCount];
+}
+
+@property (nonatomic) uint64_t count;
+@property (nonatomic) uint64_t max;
+
+- (void)addDuration:(uint64_t)nanoseconds;
+- (NSDictionary *)statistics;
+
+@end
+
+@implementation DXTableViewModelHistogram
+
+- (void)addDuration:(uint64_t)nanoseconds
+{
+    NSUInteger bucket = nanoseconds > 1 ? (NSUInteger)(log2((double)nanoseconds) * DXHistogramBucketsPerPowerOfTwo) : 0;
+    ++_buckets[MIN(bucket, DXHistogramBucketCount - 1)];
+    ++_count;
+    _max = MAX(_max, nanoseconds);
+}
+
+- (double)durationAtQuantile:(double)quantile
+{
+    uint64_t rank = (uint64_t)ceil(quantile * _count);
+    uint64_t seen = 0;
+    for (NSUInteger bucket = 0; bucket < DXHistogramBucketCount; ++bucket) {
+        seen += _buckets[bucket];
+        if (seen >= rank && seen > 0)
+            return MIN(exp2((double)(bucket + 1) / DXHistogramBucketsPerPowerOfTwo), (double)_max) / NSEC_PER_SEC;
+    }
+    return (double)_max / NSEC_PER_SEC;
+}
+
+- (NSDictionary *)statistics
+{
+    return @{@"count": @(_count),
+             @"p50": @([self durationAtQuantile:0.5]),
+             @"p99": @([self durationAtQuantile:0.99]),
+             @"max": @((double)_max / NSEC_PER_SEC)};
+}
+
+@end
+
+// Draws image into bitmap of displayed size, so it is decoded here rather than on first drawing in main thread
+static UIImage *DXDecodedImage(UIImage *image, CGSize size, CGFloat scale)
+{
+    CGImageRef imageRef = image.CGImage;
+    if (NULL == imageRef)
+        return image;
+
+    CGFloat ratio = 1;
+    if (size.width > 0 && size.height > 0)
+        ratio = MIN(1, MIN(size.width / image.size.width, size.height / image.size.height));
+    size_t width = (size_t)ceil(image.size.width * ratio * scale);
+    size_t height = (size_t)ceil(image.size.height * ratio * scale);
+    if (0 == width || 0 == height)
+        return image;
+
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(NULL, width, height, 8, 0, colorSpace,
+                                                 kCGBitmapByteOrder32Host | kCGImageAlphaPremultipliedFirst);
+    CGColorSpaceRelease(colorSpace);
+    if (NULL == context)
+        return image;
+
+    CGContextDrawImage(context, CGRectMake(0, 0, width, height), imageRef);
+    CGImageRef decodedImageRef = CGBitmapContextCreateImage(context);
+    CGContextRelease(context);
+    UIImage *decodedImage = [UIImage imageWithCGImage:decodedImageRef scale:scale orientation:image.imageOrientation];
+    CGImageRelease(decodedImageRef);
+    return decodedImage;
+}
+
+/**
+ Key of decoded image in image cache: key of the image and size it was downscaled to. Rows keep their last key,
+ so configuring a cell doesn't build a new one.
+ */
+@interface DXTableViewModelImageCacheKey : NSObject <NSCopying>
+
+@property (copy, nonatomic, readonly) NSString *key;
+@property (nonatomic, readonly) CGSize size;
+
+- (instancetype)initWithKey:(NSString *)key size:(CGSize)size;
+- (BOOL)isKey:(NSString *)key ofSize:(CGSize)size;
+
+@end
+
+@implementation DXTableViewModelImageCacheKey {
+    NSUInteger _hash;
+}
+
+- (instancetype)initWithKey:(NSString *)key size:(CGSize)size
+{
+    self = [super init];
+    if (self) {
+        _key = [key copy];
+        _size = size;
+        _hash = _key.hash ^ ((NSUInteger)size.width << 16) ^ (NSUInteger)size.height;
+    }
+    return self;
+}
+
+- (BOOL)isKey:(NSString *)key ofSize:(CGSize)size
+{
+    return CGSizeEqualToSize(_size, size) && [_key isEqualToString:key];
+}
+
+- (BOOL)isEqual:(DXTableViewModelImageCacheKey *)object
+{
+    if (self == object)
+        return YES;
+    return [object isKindOfClass:[DXTableViewModelImageCacheKey class]] && [object isKey:_key ofSize:_size];
+}
+
+- (NSUInteger)hash
+{
+    return _hash;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    return self;
+}
+
+@end
+
+/**
+ Cache of decoded images limited by total cost in bytes. Evicts least recently used images first
+ and loads every image once no matter how many times it is requested while loading.
+ */
+@interface DXTableViewModelImageCache : NSObject
+
+@property (nonatomic) NSUInteger byteBudget;
+@property (nonatomic, readonly) NSUInteger totalCost;
+@property (strong, nonatomic) NSMutableDictionary *imageByKey;
+@property (strong, nonatomic) NSMutableDictionary *costByKey;
+@property (strong, nonatomic) NSMutableOrderedSet *recentlyUsedKeys;
+@property (strong, nonatomic) NSMutableDictionary *completionsByLoadingKey;
+@property (strong, nonatomic) NSOperationQueue *loadingQueue;
+
+@end
+
+@implementation DXTableViewModelImageCache
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _byteBudget = 20 * 1024 * 1024;
+        _imageByKey = [NSMutableDictionary dictionary];
+        _costByKey = [NSMutableDictionary dictionary];
+        _recentlyUsedKeys = [NSMutableOrderedSet orderedSet];
+        _completionsByLoadingKey = [NSMutableDictionary dictionary];
+        _loadingQueue = [[NSOperationQueue alloc] init];
+        _loadingQueue.name = @"DXTableViewModel.imageLoadingQueue";
+        _loadingQueue.maxConcurrentOperationCount = 4;
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(removeAllImages)
+                                                     name:UIApplicationDidReceiveMemoryWarningNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    [_loadingQueue cancelAllOperations];
+}
+
+- (void)setByteBudget:(NSUInteger)byteBudget
+{
+    _byteBudget = byteBudget;
+    [self evictImagesToFitBudget];
+}
+
+- (UIImage *)imageForKey:(DXTableViewModelImageCacheKey *)key
+{
+    UIImage *image = self.imageByKey[key];
+    if (nil != image) {
+        [self.recentlyUsedKeys removeObject:key];
+        [self.recentlyUsedKeys addObject:key];
+    }
+    return image;
+}
+
+- (void)setImage:(UIImage *)image forKey:(DXTableViewModelImageCacheKey *)key
+{
+    [self removeImageForKey:key];
+    CGImageRef imageRef = image.CGImage;
+    NSUInteger cost = NULL != imageRef ? CGImageGetBytesPerRow(imageRef) * CGImageGetHeight(imageRef) : 0;
+    // image that doesn't fit the whole budget is not cached at all
+    if (cost > _byteBudget)
+        return;
+
+    self.imageByKey[key] = image;
+    self.costByKey[key] = @(cost);
+    [self.recentlyUsedKeys addObject:key];
+    _totalCost += cost;
+    [self evictImagesToFitBudget];
+}
+
+- (void)removeImageForKey:(DXTableViewModelImageCacheKey *)key
+{
+    NSNumber *cost = self.costByKey[key];
+    if (nil == cost)
+        return;
+    _totalCost -= cost.unsignedIntegerValue;
+    [self.imageByKey removeObjectForKey:key];
+    [self.costByKey removeObjectForKey:key];
+    [self.recentlyUsedKeys removeObject:key];
+}
+
+- (void)evictImagesToFitBudget
+{
+    while (_totalCost > _byteBudget && self.recentlyUsedKeys.count > 0)
+        [self removeImageForKey:self.recentlyUsedKeys.firstObject];
+}
+
+- (void)removeAllImages
+{
+    [self.imageByKey removeAllObjects];
+    [self.costByKey removeAllObjects];
+    [self.recentlyUsedKeys removeAllObjects];
+    _totalCost = 0;
+}
+
+- (void)loadImageForKey:(DXTableViewModelImageCacheKey *)key usingBlock:(UIImage *(^)(void))block completion:(void (^)(UIImage *))completion
+{
+    NSMutableArray *completions = self.completionsByLoadingKey[key];
+    if (nil != completions) {
+        [completions addObject:[completion copy]];
+        return;
+    }
+    self.completionsByLoadingKey[key] = [NSMutableArray arrayWithObject:[completion copy]];
+
+    __weak DXTableViewModelImageCache *weakSelf = self;
+    [self.loadingQueue addOperationWithBlock:^{
+        UIImage *image = block();
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [weakSelf didLoadImage:image forKey:key];
+        });
+    }];
+}
+
+- (void)didLoadImage:(UIImage *)image forKey:(DXTableViewModelImageCacheKey *)key
+{
+    NSArray *completions = self.completionsByLoadingKey[key];
+    [self.completionsByLoadingKey removeObjectForKey:key];
+    if (nil != image)
+        [self setImage:image forKey:key];
+    for (void (^completion)(UIImage *) in completions)
+        completion(image);
+}
+
+@end
+
+@interface DXTableViewModelInstrumentation : NSObject
+
+@property (weak, nonatomic) DXTableViewModel *tableViewModel;
+@property (strong, nonatomic) NSMutableDictionary *histogramByEvent;
+@property (strong, nonatomic) NSMutableDictionary *histogramsByReuseIdentifier;
+@property (strong, nonatomic) NSMutableDictionary *counterByEvent;
+
+@end
+
+@implementation DXTableViewModelInstrumentation {
+    mach_timebase_info_data_t _timebase;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        mach_timebase_info(&_timebase);
+        [self reset];
+    }
+    return self;
+}
+
+- (void)reset
+{
+    _histogramByEvent = [NSMutableDictionary dictionary];
+    _histogramsByReuseIdentifier = [NSMutableDictionary dictionary];
+    _counterByEvent = [NSMutableDictionary dictionary];
+}
+
+- (void)recordEvent:(NSString *)event reuseIdentifier:(NSString *)reuseIdentifier startTime:(uint64_t)startTime
+{
+    uint64_t nanoseconds = (mach_absolute_time() - startTime) * _timebase.numer / _timebase.denom;
+
+    DXTableViewModelHistogram *histogram = _histogramByEvent[event];
+    if (nil == histogram) {
+        histogram = [[DXTableViewModelHistogram alloc] init];
+        _histogramByEvent[event] = histogram;
+    }
+    [histogram addDuration:nanoseconds];
+
+    if (nil != reuseIdentifier) {
+        NSMutableDictionary *histogramByEvent = _histogramsByReuseIdentifier[reuseIdentifier];
+        if (nil == histogramByEvent) {
+            histogramByEvent = [NSMutableDictionary dictionary];
+            _histogramsByReuseIdentifier[reuseIdentifier] = histogramByEvent;
+        }
+        histogram = histogramByEvent[event];
+        if (nil == histogram) {
+            histogram = [[DXTableViewModelHistogram alloc] init];
+            histogramByEvent[event] = histogram;
+        }
+        [histogram addDuration:nanoseconds];
+    }
+
+    DXTableViewModel *tableViewModel = self.tableViewModel;
+    [tableViewModel.instrumentationSink tableViewModel:tableViewModel
+                                        didRecordEvent:event
+                                       reuseIdentifier:reuseIdentifier
+                                              duration:(NSTimeInterval)nanoseconds / NSEC_PER_SEC];
+}
+
+- (void)countEvent:(NSString *)event
+{
+    [self countEvent:event times:1];
+}
+
+- (void)countEvent:(NSString *)event times:(NSUInteger)times
+{
+    if (0 == times)
+        return;
+    _counterByEvent[event] = @([_counterByEvent[event] unsignedLongLongValue] + times);
+}
+
+- (void)recordBlockEvent:(NSString *)event reuseIdentifier:(NSString *)reuseIdentifier startTime:(uint64_t)startTime
+{
+    [self countEvent:@"blockInvocation"];
+    [self recordEvent:event reuseIdentifier:reuseIdentifier startTime:startTime];
+}
+
+- (NSDictionary *)statistics
+{
+    NSMutableDictionary *events = [NSMutableDictionary dictionaryWithCapacity:_histogramByEvent.count];
+    [_histogramByEvent enumerateKeysAndObjectsUsingBlock:^(NSString *event, DXTableViewModelHistogram *histogram, BOOL *stop) {
+        events[event] = histogram.statistics;
+    }];
+    NSMutableDictionary *reuseIdentifiers = [NSMutableDictionary dictionaryWithCapacity:_histogramsByReuseIdentifier.count];
+    [_histogramsByReuseIdentifier enumerateKeysAndObjectsUsingBlock:^(NSString *reuseIdentifier, NSDictionary *histogramByEvent, BOOL *stop) {
+        NSMutableDictionary *identifierEvents = [NSMutableDictionary dictionaryWithCapacity:histogramByEvent.count];
+        [histogramByEvent enumerateKeysAndObjectsUsingBlock:^(NSString *event, DXTableViewModelHistogram *histogram, BOOL *stop) {
+            identifierEvents[event] = histogram.statistics;
+        }];
+        reuseIdentifiers[reuseIdentifier] = identifierEvents;
+    }];
+    return @{@"events": events, @"reuseIdentifiers": reuseIdentifiers, @"counters": _counterByEvent.copy};
+}
+
+@end
+
+// Instrumented steps are timed only while instrumentation is enabled, otherwise messages to nil instrumentation do nothing
+static inline uint64_t DXInstrumentationStartTime(DXTableViewModelInstrumentation *instrumentation)
+{
+    return nil != instrumentation ? mach_absolute_time() : 0;
+}
+
+/**
+ Stands for table view model as table view's data source and delegate while instrumentation is enabled
+ and times every forwarded call.
+ */
+@interface DXTableViewModelInstrumentingProxy : NSProxy
+
+@property (weak, nonatomic) DXTableViewModel *tableViewModel;
+@property (weak, nonatomic) DXTableViewModelInstrumentation *instrumentation;
+
+@end
+
+@implementation DXTableViewModelInstrumentingProxy
+
+- (BOOL)respondsToSelector:(SEL)aSelector
+{
+    return [self.tableViewModel respondsToSelector:aSelector];
+}
+
+- (BOOL)conformsToProtocol:(Protocol *)aProtocol
+{
+    return [self.tableViewModel conformsToProtocol:aProtocol];
+}
+
+- (NSMethodSignature *)methodSignatureForSelector:(SEL)aSelector
+{
+    return [self.tableViewModel methodSignatureForSelector:aSelector];
+}
+
+- (void)forwardInvocation:(NSInvocation *)invocation
+{
+    DXTableViewModel *tableViewModel = self.tableViewModel;
+    NSString *reuseIdentifier;
+    NSMethodSignature *signature = invocation.methodSignature;
+    for (NSUInteger i = 2; i < signature.numberOfArguments; ++i) {
+        if ('@' != [signature getArgumentTypeAtIndex:i][0])
+            continue;
+        __unsafe_unretained id argument;
+        [invocation getArgument:&argument atIndex:i];
+        if ([argument isKindOfClass:[NSIndexPath class]]) {
+            reuseIdentifier = [tableViewModel existingRowAtIndexPath:argument].cellReuseIdentifier;
+            break;
+        }
+    }
+
+    uint64_t startTime = mach_absolute_time();
+    [invocation invokeWithTarget:tableViewModel];
+    [self.instrumentation recordEvent:NSStringFromSelector(invocation.selector) reuseIdentifier:reuseIdentifier startTime:startTime];
+}
+
+@end
+
+@implementation DXTableViewModel
+
+#pragma DXTableViewModel
+
+- (id)init
+{
+    self = [super init];
+    if (nil == self)
+        return nil;
+
+    _showsDefaultTitleForDeleteConfirmationButton = YES;
+    _sectionsGeneration = ++DXTableViewModelSectionsGeneration;
+    _rowHeightsGeneration = 1;
+    _heightTreeNeedsRebuild = YES;
+    _maximumNumberOfConcurrentPrefetches = 4;
+    _uniformRowHeight = NAN;
+    _uniformHeaderHeight = NAN;
+    _uniformFooterHeight = NAN;
+
+    return self;
+}
+
+- (void)dealloc
+{
+    [_rowHeightQueue cancelAllOperations];
+    [_contentPreparationQueue cancelAllOperations];
+    [_filterQueue cancelAllOperations];
+    free(_slotHeights);
+    free(_heightTree);
+    free(_sectionSlotStarts);
+}
+
+- (instancetype)initWithTableView:(UITableView *)tableView
+{
+    self = [self init];
+    if (nil == self)
+        return nil;
+
+    self.tableView = tableView;
+
+    return self;
+}
+
+- (NSString *)description
+{
+    NSString *description = [NSString stringWithFormat:@"<%@: %p; sections=%@>", [self class], self, self.mutableSections];
+    return description;
+}
+
+- (void)setTableView:(UITableView *)tableView
+{
+    if (_tableView != tableView) {
+        _tableView = tableView;
+        _pushedUniformHeights = 0;
+        [self connectTableView];
+        _registeredCellNibOrClassByIdentifier = nil;
+        _registeredHeaderFooterNibOrClassByIdentifier = nil;
+        _numberOfRegistrations = 0;
+        [self invalidateRowHeights];
+        [self.mutableSections makeObjectsPerformSelector:@selector(registerNibOrClassForRows)];
+    }
+}
+
+// table view talks to instrumenting proxy while instrumentation is enabled
+- (void)connectTableView
+{
+    id delegate = nil != _instrumentingProxy ? _instrumentingProxy : self;
+    [self pushUniformHeights];
+    _tableView.dataSource = nil;
+    _tableView.delegate = nil;
+    _tableView.delegate = delegate;
+    _tableView.dataSource = delegate;
+    if ([_tableView respondsToSelector:@selector(setPrefetchDataSource:)])
+        _tableView.prefetchDataSource = delegate;
+}
+
+- (NSMutableArray *)mutableSections
+{
+    if (nil == _mutableSections) {
+        _mutableSections = [NSMutableArray array];
+    }
+    return _mutableSections;
+}
+
+- (NSMutableDictionary *)registeredCellNibOrClassByIdentifier
+{
+    if (nil == _registeredCellNibOrClassByIdentifier) {
+        _registeredCellNibOrClassByIdentifier = [NSMutableDictionary dictionary];
+    }
+    return _registeredCellNibOrClassByIdentifier;
+}
+
+- (NSMutableDictionary *)registeredHeaderFooterNibOrClassByIdentifier
+{
+    if (nil == _registeredHeaderFooterNibOrClassByIdentifier) {
+        _registeredHeaderFooterNibOrClassByIdentifier = [NSMutableDictionary dictionary];
+    }
+    return _registeredHeaderFooterNibOrClassByIdentifier;
+}
+
+- (NSMutableDictionary *)sectionByName
+{
+    if (nil == _sectionByName) {
+        _sectionByName = [NSMutableDictionary dictionary];
+    }
+    return _sectionByName;
+}
+
+- (NSArray *)sections
+{
+    return self.mutableSections.copy;
+}
+
+- (void)invalidateSectionIndexes
+{
+    _sectionsGeneration = ++DXTableViewModelSectionsGeneration;
+    _heightTreeNeedsRebuild = YES;
+}
+
+- (void)reindexSections
+{
+    if (_indexedSectionsGeneration == _sectionsGeneration)
+        return;
+    NSUInteger generation = _sectionsGeneration;
+    [self.mutableSections enumerateObjectsUsingBlock:^(DXTableViewSection *section, NSUInteger index, BOOL *stop) {
+        section.cachedSectionIndex = index;
+        section.cachedSectionIndexGeneration = generation;
+    }];
+    _indexedSectionsGeneration = generation;
+}
+
+- (BOOL)containsSection:(DXTableViewSection *)section
+{
+    return nil != section.sectionName && self.sectionByName[section.sectionName] == section;
+}
+
+- (DXTableViewRow *)rowAtIndexPath:(NSIndexPath *)indexPath
+{
+    return [self rowAtIndex:indexPath.row inSectionAtIndex:indexPath.section];
+}
+
+- (DXTableViewRow *)existingRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    if (indexPath.section < 0 || indexPath.section >= self.mutableSections.count)
+        return nil;
+    DXTableViewSection *section = self.mutableSections[indexPath.section];
+    if (indexPath.row < 0 || indexPath.row >= section.numberOfRows)
+        return nil;
+    return [section existingRowAtIndex:indexPath.row];
+}
+
+- (DXTableViewRow *)rowAtIndex:(NSInteger)rowIndex inSectionAtIndex:(NSInteger)sectionIndex
+{
+    return [self.mutableSections[sectionIndex] rowAtIndex:rowIndex];
+}
+
+#pragma mark - Registration
+
+// Returns YES if given class or nib still has to be registered for given reuse identifier
+- (BOOL)shouldRegisterNibOrClass:(id)nibOrClass
+                 reuseIdentifier:(NSString *)reuseIdentifier
+                      inRegistry:(NSMutableDictionary *)registry
+{
+    if (nil == _tableView || nil == nibOrClass || nil == reuseIdentifier)
+        return NO;
+
+    id registered = registry[reuseIdentifier];
+    if (registered == nibOrClass)
+        return NO;
+    // conflicting registrations are programming errors, release builds let the latest one win as table view does
+    NSAssert(nil == registered, @"reuse identifier \"%@\" is registered for %@ and is being re-registered for %@",
+             reuseIdentifier, registered, nibOrClass);
+
+    registry[reuseIdentifier] = nibOrClass;
+    ++_numberOfRegistrations;
+    return YES;
+}
+
+- (void)registerCellNib:(UINib *)nib class:(Class)cls reuseIdentifier:(NSString *)reuseIdentifier
+{
+    if (nil != cls) {
+        if ([self shouldRegisterNibOrClass:cls reuseIdentifier:reuseIdentifier inRegistry:self.registeredCellNibOrClassByIdentifier])
+            [_tableView registerClass:cls forCellReuseIdentifier:reuseIdentifier];
+    } else if (nil != nib) {
+        if ([self shouldRegisterNibOrClass:nib reuseIdentifier:reuseIdentifier inRegistry:self.registeredCellNibOrClassByIdentifier])
+            [_tableView registerNib:nib forCellReuseIdentifier:reuseIdentifier];
+    }
+}
+
+- (void)registerHeaderFooterNib:(UINib *)nib class:(Class)cls reuseIdentifier:(NSString *)reuseIdentifier
+{
+    NSMutableDictionary *registry = self.registeredHeaderFooterNibOrClassByIdentifier;
+    if (nil != nib) {
+        if ([self shouldRegisterNibOrClass:nib reuseIdentifier:reuseIdentifier inRegistry:registry])
+            [_tableView registerNib:nib forHeaderFooterViewReuseIdentifier:reuseIdentifier];
+    } else if (nil != cls) {
+        if ([self shouldRegisterNibOrClass:cls reuseIdentifier:reuseIdentifier inRegistry:registry])
+            [_tableView registerClass:cls forHeaderFooterViewReuseIdentifier:reuseIdentifier];
+    }
+}
+
+#pragma mark - Model building
+
+- (void)addSection:(DXTableViewSection *)section
+{
+    [self insertSection:section atIndex:self.mutableSections.count];
+}
+
+- (void)insertSection:(DXTableViewSection *)section atIndex:(NSInteger)index
+{
+    [self insertSections:@[section] atIndexes:[[NSIndexSet alloc] initWithIndex:index]];
+}
+
+- (void)insertSections:(NSArray *)sections atIndexes:(NSIndexSet *)indexes
+{
+    NSMutableSet *names = [NSMutableSet setWithCapacity:sections.count];
+    for (DXTableViewSection *section in sections) {
+        if (nil != self.sectionByName[section.sectionName] || [names containsObject:section.sectionName]) {
+            NSString *fmt = @"\"%@\" section name is already exists in the model, but section name must be unique";
+            [NSException raise:NSInvalidArgumentException format:fmt, section.sectionName];
+        }
+        [names addObject:section.sectionName];
+    }
+    [sections makeObjectsPerformSelector:@selector(setTableViewModel:) withObject:self];
+    [sections makeObjectsPerformSelector:@selector(registerNibOrClassForRows)];
+    [self.mutableSections insertObjects:sections atIndexes:indexes];
+    for (DXTableViewSection *section in sections) {
+        self.sectionByName[section.sectionName] = section;
+        section.rowCallbacksSummarized = NO;
+    }
+    [self invalidateSectionIndexes];
+    [self updateNeededCallbacks];
+}
+
+- (void)removeSection:(DXTableViewSection *)section
+{
+    if (![self containsSection:section])
+        return;
+    [self.mutableSections removeObjectAtIndex:section.sectionIndex];
+    [self.sectionByName removeObjectForKey:section.sectionName];
+    section.tableViewModel = nil;
+    [self invalidateSectionIndexes];
+    [self setNeedsUpdateNeededCallbacks];
+}
+
+- (DXTableViewSection *)sectionWithName:(NSString *)name
+{
+    DXTableViewSection *section = nil != name ? self.sectionByName[name] : nil;
+    if (nil == section)
+        [NSException raise:NSInvalidArgumentException format:@"section with name \"%@\" not found", name];
+    return section;
+}
+
+- (NSInteger)indexOfSectionWithName:(NSString *)name
+{
+    return [[self sectionWithName:name] sectionIndex];
+}
+
+- (NSInteger)insertSection:(DXTableViewSection *)newSection afterSectionWithName:(NSString *)name
+{
+    NSInteger index = [self indexOfSectionWithName:name];
+    [self insertSection:newSection atIndex:++index];
+    return index;
+}
+
+- (NSInteger)insertSection:(DXTableViewSection *)newSection beforeSectionWithName:(NSString *)name
+{
+    NSInteger index = [self indexOfSectionWithName:name];
+    [self insertSection:newSection atIndex:index];
+    return index;
+}
+
+- (NSInteger)deleteSectionWithName:(NSString *)name
+{
+    NSInteger index = [self indexOfSectionWithName:name];
+    [self removeSection:[self sectionWithName:name]];
+    return index;
+}
+
+- (NSIndexSet *)moveSectionWithName:(NSString *)name toSectionWithName:(NSString *)destinationName
+{
+    NSInteger index = [self indexOfSectionWithName:name];
+    NSInteger destinationIndex = [self indexOfSectionWithName:destinationName];
+
+    DXTableViewSection *section = [self sectionWithName:name];
+    [self.mutableSections removeObjectAtIndex:index];
+    [self.mutableSections insertObject:section atIndex:destinationIndex];
+    [self invalidateSectionIndexes];
+
+    NSMutableIndexSet *indexes = [[NSMutableIndexSet alloc] initWithIndex:index];
+    [indexes addIndex:destinationIndex];
+    return indexes.copy;
+}
+
+- (void)section:(DXTableViewSection *)section willChangeNameTo:(NSString *)newName
+{
+    if (![self containsSection:section])
+        return;
+    if (nil != newName && nil != self.sectionByName[newName] && self.sectionByName[newName] != section) {
+        NSString *fmt = @"\"%@\" section name is already exists in the model, but section name must be unique";
+        [NSException raise:NSInvalidArgumentException format:fmt, newName];
+    }
+    if (nil != section.sectionName && self.sectionByName[section.sectionName] == section)
+        [self.sectionByName removeObjectForKey:section.sectionName];
+    if (nil != newName)
+        self.sectionByName[newName] = section;
+}
+
+#pragma mark - Model building convenience methods
+
+- (void)addSections:(NSArray *)sections
+{
+    NSIndexSet *indexes = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(self.mutableSections.count, sections.count)];
+    [self insertSections:sections atIndexes:indexes];
+}
+
+#pragma mark - respondsToSelector hacks
+
+static DXTableViewModelCallback DXTableViewModelCallbackForSelector(SEL aSelector)
+{
+    if (aSelector == @selector(tableView:heightForRowAtIndexPath:) ||
+        aSelector == @selector(tableView:estimatedHeightForRowAtIndexPath:))
+        return DXTableViewModelCallbackHeightForRow;
+    if (aSelector == @selector(tableView:willDisplayCell:forRowAtIndexPath:))
+        return DXTableViewModelCallbackWillDisplayCell;
+    if (aSelector == @selector(tableView:heightForHeaderInSection:))
+        return DXTableViewModelCallbackHeightForHeader;
+    if (aSelector == @selector(tableView:heightForFooterInSection:))
+        return DXTableViewModelCallbackHeightForFooter;
+    if (aSelector == @selector(tableView:viewForHeaderInSection:))
+        return DXTableViewModelCallbackViewForHeader;
+    if (aSelector == @selector(tableView:viewForFooterInSection:))
+        return DXTableViewModelCallbackViewForFooter;
+    if (aSelector == @selector(tableView:willDisplayHeaderView:forSection:))
+        return DXTableViewModelCallbackWillDisplayHeaderView;
+    if (aSelector == @selector(tableView:willDisplayFooterView:forSection:))
+        return DXTableViewModelCallbackWillDisplayFooterView;
+    if (aSelector == @selector(tableView:didEndDisplayingCell:forRowAtIndexPath:))
+        return DXTableViewModelCallbackDidEndDisplayingCell;
+    if (aSelector == @selector(tableView:didEndDisplayingHeaderView:forSection:))
+        return DXTableViewModelCallbackDidEndDisplayingHeaderView;
+    if (aSelector == @selector(tableView:didEndDisplayingFooterView:forSection:))
+        return DXTableViewModelCallbackDidEndDisplayingFooterView;
+    return 0;
+}
+
+- (BOOL)respondsToSelector:(SEL)aSelector
+{
+    DXTableViewModelCallback callback = DXTableViewModelCallbackForSelector(aSelector);
+    if (0 != callback) {
+        if (0 != (_neededCallbacks & callback))
+            return YES;
+        // subclass may implement the method on its own
+        return [self class] != [DXTableViewModel class] &&
+            [self methodForSelector:aSelector] != [DXTableViewModel instanceMethodForSelector:aSelector];
+    }
+
+    if (aSelector == @selector(tableView:titleForDeleteConfirmationButtonForRowAtIndexPath:) &&
+        _showsDefaultTitleForDeleteConfirmationButton)
+        return NO;
+
+    if (aSelector == @selector(tableView:sectionForSectionIndexTitle:atIndex:) &&
+        nil == self.sectionForSectionIndexTitleAtIndexBlock && nil == self.groupingCollation)
+        return NO;
+
+    return [super respondsToSelector:aSelector];
+}
+
+#pragma mark - Needed callbacks
+
+static NSUInteger DXRowCallbacks(DXTableViewRow *row)
+{
+    NSUInteger callbacks = 0;
+    if (nil != row.rowHeightBlock || nil != row.rowHeightForWidthBlock || row.sizesRowHeightToCellText ||
+        nil != row.estimatedRowHeightBlock || UITableViewAutomaticDimension != row.estimatedRowHeight)
+        callbacks |= DXTableViewModelCallbackHeightForRow;
+    if (nil != row.willDisplayCellBlock)
+        callbacks |= DXTableViewModelCallbackWillDisplayCell;
+    return callbacks;
+}
+
+static NSUInteger DXSectionCallbacks(DXTableViewSection *section)
+{
+    NSUInteger callbacks = 0;
+    // subclasses may configure header and footer in hooks
+    BOOL isSubclass = [section class] != [DXTableViewSection class];
+    if (isSubclass || nil != section.viewForHeaderInSectionBlock || nil != section.headerReuseIdentifier ||
+        nil != section.configureHeaderBlock)
+        callbacks |= DXTableViewModelCallbackViewForHeader;
+    if (isSubclass || nil != section.viewForFooterInSectionBlock || nil != section.footerReuseIdentifier ||
+        nil != section.configureFooterBlock)
+        callbacks |= DXTableViewModelCallbackViewForFooter;
+    if (nil != section.willDisplayHeaderViewBlock)
+        callbacks |= DXTableViewModelCallbackWillDisplayHeaderView;
+    if (nil != section.willDisplayFooterViewBlock)
+        callbacks |= DXTableViewModelCallbackWillDisplayFooterView;
+    // rows of virtualized section are unknown until they are materialized
+    if (section.isVirtualized)
+        callbacks |= DXTableViewModelCallbackHeightForRow | DXTableViewModelCallbackWillDisplayCell;
+    if (section.isPaged)
+        callbacks |= DXTableViewModelCallbackWillDisplayCell;
+    return callbacks;
+}
+
+// Heights which are all equal can be given to table view once, otherwise `callback` is needed
+static void DXMergeUniformHeight(CGFloat *uniformHeight, CGFloat height, NSUInteger *callbacks, DXTableViewModelCallback callback)
+{
+    if (isnan(height))
+        return;
+    if (isnan(*uniformHeight))
+        *uniformHeight = height;
+    else if (*uniformHeight != height)
+        *callbacks |= callback;
+}
+
+// Automatic dimension isn't given to table view, which keeps its own height then. Once the receiver has given it
+// another height, callback is needed to answer automatic dimension.
+static void DXMergeAutomaticHeight(CGFloat uniformHeight, NSUInteger pushedHeights, NSUInteger *callbacks, DXTableViewModelCallback callback)
+{
+    if (UITableViewAutomaticDimension == uniformHeight && 0 != (pushedHeights & callback))
+        *callbacks |= callback;
+}
+
+// Row remembers what it has merged into the summary, so its changes tell whether any need may be gone
+static void DXMergeRowCallbacks(DXTableViewSection *section, DXTableViewRow *row)
+{
+    row.mergedRowCallbacks = DXRowCallbacks(row);
+    row.mergedRowHeight = row.rowHeight;
+    NSUInteger callbacks = section.summarizedRowCallbacks | row.mergedRowCallbacks;
+    CGFloat height = section.summarizedRowHeight;
+    DXMergeUniformHeight(&height, row.mergedRowHeight, &callbacks, DXTableViewModelCallbackHeightForRow);
+    section.summarizedRowCallbacks = callbacks;
+    section.summarizedRowHeight = height;
+}
+
+- (void)summarizeRowCallbacksOfSection:(DXTableViewSection *)section
+{
+    section.summarizedRowCallbacks = 0;
+    section.summarizedRowHeight = NAN;
+    if (!section.isVirtualized) {
+        for (DXTableViewRow *row in section.rows)
+            DXMergeRowCallbacks(section, row);
+    }
+    section.rowCallbacksSummarized = YES;
+    section.rowCallbacksSummaryExact = YES;
+}
+
+- (void)updateNeededCallbacks
+{
+    NSUInteger callbacks = 0;
+    CGFloat rowHeight = NAN;
+    CGFloat headerHeight = NAN;
+    CGFloat footerHeight = NAN;
+    for (DXTableViewSection *section in self.mutableSections) {
+        if (!section.rowCallbacksSummarized)
+            [self summarizeRowCallbacksOfSection:section];
+        callbacks |= DXSectionCallbacks(section) | section.summarizedRowCallbacks;
+        DXMergeUniformHeight(&rowHeight, section.summarizedRowHeight, &callbacks, DXTableViewModelCallbackHeightForRow);
+        DXMergeUniformHeight(&headerHeight, section.headerHeight, &callbacks, DXTableViewModelCallbackHeightForHeader);
+        DXMergeUniformHeight(&footerHeight, section.footerHeight, &callbacks, DXTableViewModelCallbackHeightForFooter);
+    }
+    if (nil != _didEndDisplayingCellBlock)
+        callbacks |= DXTableViewModelCallbackDidEndDisplayingCell;
+    if (nil != _didEndDisplayingHeaderViewBlock)
+        callbacks |= DXTableViewModelCallbackDidEndDisplayingHeaderView;
+    if (nil != _didEndDisplayingFooterViewBlock)
+        callbacks |= DXTableViewModelCallbackDidEndDisplayingFooterView;
+    DXMergeAutomaticHeight(rowHeight, _pushedUniformHeights, &callbacks, DXTableViewModelCallbackHeightForRow);
+    DXMergeAutomaticHeight(headerHeight, _pushedUniformHeights, &callbacks, DXTableViewModelCallbackHeightForHeader);
+    DXMergeAutomaticHeight(footerHeight, _pushedUniformHeights, &callbacks, DXTableViewModelCallbackHeightForFooter);
+
+    _uniformRowHeight = rowHeight;
+    _uniformHeaderHeight = headerHeight;
+    _uniformFooterHeight = footerHeight;
+    [self pushUniformHeights];
+    if (callbacks == _neededCallbacks)
+        return;
+    _neededCallbacks = callbacks;
+    [self rearmTableViewDelegate];
+}
+
+// Table view asks delegate which methods it implements only when delegate is set. Setting it amid batch updates
+// would disturb them, so within a transaction it's set once after the transaction.
+- (void)rearmTableViewDelegate
+{
+    if (nil == _tableView)
+        return;
+    if (0 < _updatesDepth) {
+        _delegateRearmNeeded = YES;
+        return;
+    }
+    id delegate = _tableView.delegate;
+    _tableView.delegate = nil;
+    _tableView.delegate = delegate;
+}
+
+static BOOL DXShouldPushUniformHeight(CGFloat uniformHeight, CGFloat height, NSUInteger neededCallbacks, DXTableViewModelCallback callback)
+{
+    return 0 == (neededCallbacks & callback) && !isnan(uniformHeight) && UITableViewAutomaticDimension != uniformHeight &&
+        height != uniformHeight;
+}
+
+// Table view uses its own heights for callbacks the receiver doesn't respond to. Its estimated row height
+// is left to the caller.
+- (void)pushUniformHeights
+{
+    if (nil == _tableView)
+        return;
+    if (DXShouldPushUniformHeight(_uniformRowHeight, _tableView.rowHeight, _neededCallbacks, DXTableViewModelCallbackHeightForRow)) {
+        _tableView.rowHeight = _uniformRowHeight;
+        _pushedUniformHeights |= DXTableViewModelCallbackHeightForRow;
+    }
+    if (DXShouldPushUniformHeight(_uniformHeaderHeight, _tableView.sectionHeaderHeight, _neededCallbacks, DXTableViewModelCallbackHeightForHeader)) {
+        _tableView.sectionHeaderHeight = _uniformHeaderHeight;
+        _pushedUniformHeights |= DXTableViewModelCallbackHeightForHeader;
+    }
+    if (DXShouldPushUniformHeight(_uniformFooterHeight, _tableView.sectionFooterHeight, _neededCallbacks, DXTableViewModelCallbackHeightForFooter)) {
+        _tableView.sectionFooterHeight = _uniformFooterHeight;
+        _pushedUniformHeights |= DXTableViewModelCallbackHeightForFooter;
+    }
+}
+
+// Callbacks that are no longer needed are dropped later, once per run loop, as finding them requires a pass over rows
+- (void)setNeedsUpdateNeededCallbacks
+{
+    if (_neededCallbacksUpdateScheduled)
+        return;
+    _neededCallbacksUpdateScheduled = YES;
+    __weak DXTableViewModel *weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [weakSelf updateInexactNeededCallbacks];
+    });
+}
+
+- (void)updateInexactNeededCallbacks
+{
+    _neededCallbacksUpdateScheduled = NO;
+    for (DXTableViewSection *section in self.mutableSections) {
+        if (!section.rowCallbacksSummaryExact)
+            section.rowCallbacksSummarized = NO;
+    }
+    [self updateNeededCallbacks];
+}
+
+// Summary of section's rows can only grow by merging rows in, so newly needed callbacks are responded at once
+- (void)mergeRows:(NSArray *)rows intoRowCallbacksOfSection:(DXTableViewSection *)section
+{
+    if (![self containsSection:section])
+        return;
+    if (!section.rowCallbacksSummarized) {
+        [self updateNeededCallbacks];
+        return;
+    }
+    for (DXTableViewRow *row in rows)
+        DXMergeRowCallbacks(section, row);
+    BOOL needsRowHeights = 0 != (_neededCallbacks & DXTableViewModelCallbackHeightForRow);
+    if (0 != (section.summarizedRowCallbacks & ~_neededCallbacks) ||
+        (!needsRowHeights && !isnan(section.summarizedRowHeight) && section.summarizedRowHeight != _uniformRowHeight))
+        [self updateNeededCallbacks];
+}
+
+- (void)section:(DXTableViewSection *)section didInsertRows:(NSArray *)rows
+{
+    [self mergeRows:rows intoRowCallbacksOfSection:section];
+}
+
+- (void)sectionDidRemoveRows:(DXTableViewSection *)section
+{
+    section.rowCallbacksSummaryExact = NO;
+    [self setNeedsUpdateNeededCallbacks];
+}
+
+- (void)sectionDidChangeRows:(DXTableViewSection *)section
+{
+    section.rowCallbacksSummarized = NO;
+    if ([self containsSection:section])
+        [self updateNeededCallbacks];
+}
+
+- (void)sectionDidChangeCallbacks:(DXTableViewSection *)section
+{
+    if ([self containsSection:section])
+        [self updateNeededCallbacks];
+}
+
+- (void)rowDidChangeCallbacks:(DXTableViewRow *)row
+{
+    DXTableViewSection *section = row.section;
+    if (nil == section || section.isVirtualized)
+        return;
+    NSUInteger previousCallbacks = row.mergedRowCallbacks;
+    CGFloat previousHeight = row.mergedRowHeight;
+    [self mergeRows:@[row] intoRowCallbacksOfSection:section];
+    // only a need the row no longer has, or its previous height, may be gone, which is found out later
+    if (0 != (previousCallbacks & ~row.mergedRowCallbacks) || previousHeight != row.mergedRowHeight) {
+        section.rowCallbacksSummaryExact = NO;
+        [self setNeedsUpdateNeededCallbacks];
+    }
+}
+
+- (void)setDidEndDisplayingCellBlock:(void (^)(DXTableViewModel *, id, NSIndexPath *))didEndDisplayingCellBlock
+{
+    _didEndDisplayingCellBlock = [didEndDisplayingCellBlock copy];
+    [self updateNeededCallbacks];
+}
+
+- (void)setDidEndDisplayingHeaderViewBlock:(void (^)(DXTableViewModel *, UIView *, NSInteger))didEndDisplayingHeaderViewBlock
+{
+    _didEndDisplayingHeaderViewBlock = [didEndDisplayingHeaderViewBlock copy];
+    [self updateNeededCallbacks];
+}
+
+- (void)setDidEndDisplayingFooterViewBlock:(void (^)(DXTableViewModel *, UIView *, NSInteger))didEndDisplayingFooterViewBlock
+{
+    _didEndDisplayingFooterViewBlock = [didEndDisplayingFooterViewBlock copy];
+    [self updateNeededCallbacks];
+}
+
+#pragma mark - Animated sections manipulations
+
+- (BOOL)isUpdating
+{
+    return _updatesDepth > 0;
+}
+
+- (void)beginUpdates
+{
+    if (0 < _updatesDepth++)
+        return;
+
+    _updatesAnimation = UITableViewRowAnimationAutomatic;
+    if (nil != _tableView) {
+        // rows of a section are captured when they are about to change for the first time,
+        // so a transaction costs as much as the sections it touches
+        self.sectionsBeforeUpdates = self.mutableSections.copy;
+        self.sectionNamesBeforeUpdates = [self.mutableSections valueForKey:@"sectionName"];
+        self.sectionSetBeforeUpdates = [NSSet setWithArray:self.sectionsBeforeUpdates];
+        self.rowsBeforeUpdates = [NSMapTable strongToStrongObjectsMapTable];
+        [_tableView beginUpdates];
+    }
+}
+
+- (void)endUpdates
+{
+    if (0 == _updatesDepth)
+        [NSException raise:NSInternalInconsistencyException format:@"endUpdates is called without matching beginUpdates"];
+    if (0 < --_updatesDepth)
+        return;
+
+    NSArray *sectionsBeforeUpdates = self.sectionsBeforeUpdates;
+    NSArray *sectionNamesBeforeUpdates = self.sectionNamesBeforeUpdates;
+    NSSet *sectionSetBeforeUpdates = self.sectionSetBeforeUpdates;
+    NSMapTable *rowsBeforeUpdates = self.rowsBeforeUpdates;
+    NSSet *reloadedRows = self.rowsReloadedOnEndUpdates;
+    NSSet *reloadedSectionNames = self.sectionNamesReloadedOnEndUpdates;
+    NSMapTable *rowAnimations = self.rowAnimationsOnEndUpdates;
+    NSDictionary *sectionAnimations = self.sectionAnimationsOnEndUpdates;
+    self.sectionsBeforeUpdates = nil;
+    self.sectionNamesBeforeUpdates = nil;
+    self.sectionSetBeforeUpdates = nil;
+    self.rowsBeforeUpdates = nil;
+    self.rowsReloadedOnEndUpdates = nil;
+    self.sectionNamesReloadedOnEndUpdates = nil;
+    self.rowAnimationsOnEndUpdates = nil;
+    self.sectionAnimationsOnEndUpdates = nil;
+    BOOL delegateRearmNeeded = _delegateRearmNeeded;
+    BOOL relayoutNeeded = _relayoutNeeded;
+    _delegateRearmNeeded = NO;
+    _relayoutNeeded = NO;
+    if (nil == sectionsBeforeUpdates || nil == _tableView) {
+        // table view wasn't in batch updates, which would have asked for heights
+        if (relayoutNeeded) {
+            [_tableView beginUpdates];
+            [_tableView endUpdates];
+        }
+        if (delegateRearmNeeded)
+            [self rearmTableViewDelegate];
+        return;
+    }
+
+    // Sections which rows didn't change are represented by themselves on both sides, so their rows are not diffed
+    NSMutableArray *oldContents = [NSMutableArray arrayWithCapacity:sectionsBeforeUpdates.count];
+    [sectionsBeforeUpdates enumerateObjectsUsingBlock:^(DXTableViewSection *section, NSUInteger idx, BOOL *stop) {
+        id rows = [rowsBeforeUpdates objectForKey:section];
+        [oldContents addObject:@[sectionNamesBeforeUpdates[idx], nil != rows ? rows : section]];
+    }];
+    NSMutableArray *newContents = [NSMutableArray arrayWithCapacity:self.mutableSections.count];
+    for (DXTableViewSection *section in self.mutableSections) {
+        BOOL unchanged = [sectionSetBeforeUpdates containsObject:section] && nil == [rowsBeforeUpdates objectForKey:section];
+        [newContents addObject:@[section.sectionName, unchanged ? section : DXSectionContentsRows(section)]];
+    }
+
+    [self updateTableViewFromContents:oldContents
+                           toContents:newContents
+                         reloadedRows:reloadedRows
+                 reloadedSectionNames:reloadedSectionNames
+                        rowAnimations:rowAnimations
+                    sectionAnimations:sectionAnimations
+                            animation:_updatesAnimation];
+    [_tableView endUpdates];
+    if (delegateRearmNeeded)
+        [self rearmTableViewDelegate];
+}
+
+- (void)sectionWillChangeRows:(DXTableViewSection *)section
+{
+    if (nil == self.rowsBeforeUpdates || nil != [self.rowsBeforeUpdates objectForKey:section])
+        return;
+    [self.rowsBeforeUpdates setObject:DXSectionContentsRows(section) forKey:section];
+}
+
+- (BOOL)deferUpdateWithRowAnimation:(UITableViewRowAnimation)animation
+{
+    if (0 == _updatesDepth)
+        return NO;
+    _updatesAnimation = animation;
+    return YES;
+}
+
+- (BOOL)deferUpdateOfRows:(NSArray *)rows withRowAnimation:(UITableViewRowAnimation)animation
+{
+    if (![self deferUpdateWithRowAnimation:animation])
+        return NO;
+    if (nil == self.rowAnimationsOnEndUpdates)
+        self.rowAnimationsOnEndUpdates = [NSMapTable strongToStrongObjectsMapTable];
+    NSNumber *value = @(animation);
+    for (DXTableViewRow *row in rows)
+        [self.rowAnimationsOnEndUpdates setObject:value forKey:row];
+    return YES;
+}
+
+- (BOOL)deferUpdateOfSectionsWithNames:(NSArray *)names withRowAnimation:(UITableViewRowAnimation)animation
+{
+    if (![self deferUpdateWithRowAnimation:animation])
+        return NO;
+    if (nil == self.sectionAnimationsOnEndUpdates)
+        self.sectionAnimationsOnEndUpdates = [NSMutableDictionary dictionary];
+    NSNumber *value = @(animation);
+    for (NSString *name in names)
+        self.sectionAnimationsOnEndUpdates[name] = value;
+    return YES;
+}
+
+- (void)reloadRowsOnEndUpdates:(NSArray *)rows
+{
+    if (nil == self.rowsReloadedOnEndUpdates)
+        self.rowsReloadedOnEndUpdates = [NSMutableSet set];
+    [self.rowsReloadedOnEndUpdates addObjectsFromArray:rows];
+    // reloads are found by diffing rows of their sections
+    for (DXTableViewRow *row in rows) {
+        if (nil != row.section)
+            [self sectionWillChangeRows:row.section];
+    }
+}
+
+- (void)insertSections:(NSArray *)newSections
+  afterSectionWithName:(NSString *)name
+      withRowAnimation:(UITableViewRowAnimation)animation
+{
+    NSInteger index = [self indexOfSectionWithName:name] + 1;
+    NSIndexSet *indexes = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(index, newSections.count)];
+    [self insertSections:newSections atIndexes:indexes];
+    if (![self deferUpdateOfSectionsWithNames:[newSections valueForKey:@"sectionName"] withRowAnimation:animation])
+        [self.tableView insertSections:indexes withRowAnimation:animation];
+}
+
+- (void)insertSections:(NSArray *)newSections
+ beforeSectionWithName:(NSString *)name
+      withRowAnimation:(UITableViewRowAnimation)animation
+{
+    NSInteger index = [self indexOfSectionWithName:name];
+    NSIndexSet *indexes = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(index, newSections.count)];
+    [self insertSections:newSections atIndexes:indexes];
+    if (![self deferUpdateOfSectionsWithNames:[newSections valueForKey:@"sectionName"] withRowAnimation:animation])
+        [self.tableView insertSections:indexes withRowAnimation:animation];
+}
+
+- (void)deleteSectionsWithNames:(NSArray *)names withRowAnimation:(UITableViewRowAnimation)animation
+{
+    // indexes are taken before any section is removed, as table view expects
+    NSMutableIndexSet *indexes = [[NSMutableIndexSet alloc] init];
+    for (NSString *name in names)
+        [indexes addIndex:[self indexOfSectionWithName:name]];
+    for (NSString *name in names)
+        [self removeSection:[self sectionWithName:name]];
+    if (![self deferUpdateOfSectionsWithNames:names withRowAnimation:animation])
+        [self.tableView deleteSections:indexes withRowAnimation:animation];
+}
+
+- (void)moveSectionWithName:(NSString *)name animatedToSectionWithName:(NSString *)otherName
+{
+    NSIndexSet *indexes = [self moveSectionWithName:name toSectionWithName:otherName];
+    if (!self.isUpdating)
+        [self.tableView moveSection:indexes.firstIndex toSection:indexes.lastIndex];
+}
+
+- (void)reloadSectionsWithNames:(NSArray *)names withRowAnimation:(UITableViewRowAnimation)animation
+{
+    NSMutableIndexSet *indices = [[NSMutableIndexSet alloc] init];
+    for (NSString *name in names) {
+        DXTableViewSection *section = [self sectionWithName:name];
+        for (NSInteger i = 0; i < section.numberOfRows; ++i)
+            [self invalidateHeightForRow:[section existingRowAtIndex:i]];
+        [indices addIndex:section.sectionIndex];
+    }
+    if ([self deferUpdateOfSectionsWithNames:names withRowAnimation:animation]) {
+        if (nil == self.sectionNamesReloadedOnEndUpdates)
+            self.sectionNamesReloadedOnEndUpdates = [NSMutableSet set];
+        [self.sectionNamesReloadedOnEndUpdates addObjectsFromArray:names];
+        return;
+    }
+    [self.tableView reloadSections:indices withRowAnimation:animation];
+}
+
+#pragma mark - Row heights
+
+// Heights are measured again when width of table view or height or callback attributes of any template row change
+- (void)checkRowHeightsWidth
+{
+    CGFloat width = CGRectGetWidth(_tableView.bounds);
+    NSUInteger templateGeneration = [DXTableViewRow templateGeneration];
+    if (_rowTemplateGeneration != templateGeneration) {
+        _rowHeightsWidth = width;
+        _rowTemplateGeneration = templateGeneration;
+        [self invalidateRowHeights];
+    }
+    else if (_rowHeightsWidth != width) {
+        _rowHeightsWidth = width;
+        [self invalidateWidthDependentRowHeights];
+    }
+}
+
+- (CGFloat)separatorHeight
+{
+    if (nil == _tableView || UITableViewCellSeparatorStyleNone == _tableView.separatorStyle)
+        return 0;
+    return 1.0 / [UIScreen mainScreen].scale;
+}
+
+- (BOOL)hasCachedHeightForRow:(DXTableViewRow *)row
+{
+    return row.cachedRowHeightGeneration == _rowHeightsGeneration;
+}
+
+- (CGFloat)heightForRow:(DXTableViewRow *)row
+{
+    if (nil == row.rowHeightBlock && nil == row.rowHeightForWidthBlock && !row.sizesRowHeightToCellText)
+        return row.rowHeight;
+
+    [self checkRowHeightsWidth];
+    if ([self hasCachedHeightForRow:row])
+        return row.cachedRowHeight;
+
+    // not measured yet on background queue, use estimate meanwhile
+    if (nil != row.rowHeightForWidthBlock) {
+        [self setNeedsPrecomputeRowHeights];
+        return [self knownHeightForRow:row];
+    }
+
+    if (nil == row.rowHeightBlock) {
+        BOOL cacheHit;
+        row.cachedRowHeight = DXCellTextHeightBlock(row, [self separatorHeight])(_rowHeightsWidth, &cacheHit);
+        [_instrumentation countEvent:cacheHit ? @"textMeasurementHit" : @"textMeasurementMiss"];
+    }
+    else {
+        uint64_t startTime = DXInstrumentationStartTime(_instrumentation);
+        row.cachedRowHeight = row.rowHeightBlock(row);
+        [_instrumentation recordBlockEvent:@"rowHeightBlock" reuseIdentifier:row.cellReuseIdentifier startTime:startTime];
+    }
+    row.cachedRowHeightGeneration = _rowHeightsGeneration;
+    [self updateHeightTreeForRow:row];
+    return row.cachedRowHeight;
+}
+
+- (CGFloat)estimatedHeightForRow:(DXTableViewRow *)row
+{
+    [self checkRowHeightsWidth];
+    if ([self hasCachedHeightForRow:row])
+        return row.cachedRowHeight;
+    if (nil != row.estimatedRowHeightBlock) {
+        uint64_t startTime = DXInstrumentationStartTime(_instrumentation);
+        CGFloat height = row.estimatedRowHeightBlock(row);
+        [_instrumentation recordBlockEvent:@"estimatedRowHeightBlock" reuseIdentifier:row.cellReuseIdentifier startTime:startTime];
+        return height;
+    }
+    if (UITableViewAutomaticDimension != row.estimatedRowHeight)
+        return row.estimatedRowHeight;
+    if (nil == row.rowHeightBlock && UITableViewAutomaticDimension != row.rowHeight)
+        return row.rowHeight;
+    return UITableViewAutomaticDimension;
+}
+
+// Height of row to be accounted in content height, never invokes rowHeightBlock
+- (CGFloat)knownHeightForRow:(DXTableViewRow *)row
+{
+    CGFloat height = nil != row ? [self estimatedHeightForRow:row] : UITableViewAutomaticDimension;
+    if (height < 0)
+        height = [self defaultRowHeight];
+    return height;
+}
+
+- (CGFloat)defaultRowHeight
+{
+    return _tableView.rowHeight > 0 ? _tableView.rowHeight : 44.0f;
+}
+
+- (void)invalidateHeightForRow:(DXTableViewRow *)row
+{
+    row.cachedRowHeightGeneration = 0;
+    ++row.rowHeightToken;
+    [_rowsBeingMeasured removeObject:row];
+    // walk passed the row already, let next precomputation revisit it
+    self.rowHeightCursorCenter = nil;
+    [self updateHeightTreeForRow:row];
+}
+
+- (void)setNeedsCheckRowTemplates
+{
+    if (_rowTemplateCheckScheduled)
+        return;
+    _rowTemplateCheckScheduled = YES;
+    __weak DXTableViewModel *weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        DXTableViewModel *strongSelf = weakSelf;
+        if (nil == strongSelf)
+            return;
+        strongSelf->_rowTemplateCheckScheduled = NO;
+        [strongSelf checkRowHeightsWidth];
+    });
+}
+
+- (void)discardMeasuredRowHeights
+{
+    [_rowHeightQueue cancelAllOperations];
+    [_rowsBeingMeasured removeAllObjects];
+    ++_rowHeightsGeneration;
+    _rowHeightChunkInFlight = NO;
+    self.rowHeightCursorCenter = nil;
+}
+
+- (void)invalidateRowHeights
+{
+    [self discardMeasuredRowHeights];
+    _heightTreeNeedsRebuild = YES;
+    // template rows may have changed what rows need
+    for (DXTableViewSection *section in self.mutableSections)
+        section.rowCallbacksSummarized = NO;
+    [self updateNeededCallbacks];
+}
+
+// Width changes neither what rows need nor heights of sections whose rows share one fixed height,
+// so only slots of sections which may have measured heights are refreshed
+- (void)invalidateWidthDependentRowHeights
+{
+    [self discardMeasuredRowHeights];
+    if (_heightTreeNeedsRebuild)
+        return;
+    NSUInteger sectionCount = self.mutableSections.count;
+    for (NSUInteger s = 0; s < sectionCount; ++s) {
+        DXTableViewSection *section = self.mutableSections[s];
+        if (section.isVirtualized || (section.rowCallbacksSummarized &&
+                                      0 == (section.summarizedRowCallbacks & DXTableViewModelCallbackHeightForRow)))
+            continue;
+        NSUInteger slot = _sectionSlotStarts[s] + 1;
+        for (NSInteger r = 0; r < section.numberOfRows; ++r)
+            _slotHeights[slot++] = [self knownHeightForRow:[section existingRowAtIndex:r]];
+        _heightTreeNeedsConstruction = YES;
+    }
+}
+
+- (NSOperationQueue *)rowHeightQueue
+{
+    if (nil == _rowHeightQueue) {
+        _rowHeightQueue = [[NSOperationQueue alloc] init];
+        _rowHeightQueue.name = @"DXTableViewModel.rowHeightQueue";
+    }
+    return _rowHeightQueue;
+}
+
+- (NSHashTable *)rowsBeingMeasured
+{
+    if (nil == _rowsBeingMeasured) {
+        _rowsBeingMeasured = [NSHashTable weakObjectsHashTable];
+    }
+    return _rowsBeingMeasured;
+}
+
+- (void)setNeedsPrecomputeRowHeights
+{
+    if (_rowHeightPrecomputationScheduled)
+        return;
+    _rowHeightPrecomputationScheduled = YES;
+    __weak DXTableViewModel *weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [weakSelf precomputeRowHeights];
+    });
+}
+
+- (void)precomputeRowHeights
+{
+    _rowHeightPrecomputationScheduled = NO;
+    [self checkRowHeightsWidth];
+    // chunk in flight continues from the cursor when it is done
+    if (_rowHeightChunkInFlight || 0 == self.mutableSections.count)
+        return;
+
+    NSArray *visibleIndexPaths = _tableView.indexPathsForVisibleRows;
+    NSIndexPath *center = visibleIndexPaths.count > 0 ? visibleIndexPaths[visibleIndexPaths.count / 2] : [NSIndexPath indexPathForRow:0 inSection:0];
+    // restart outward walk when the visible window moved or the previous walk is over,
+    // rows measured meanwhile are skipped without work
+    if (![center isEqual:self.rowHeightCursorCenter] ||
+        (nil == self.rowHeightForwardCursor && nil == self.rowHeightBackwardCursor)) {
+        self.rowHeightCursorCenter = center;
+        self.rowHeightForwardCursor = center;
+        self.rowHeightBackwardCursor = [self indexPathBeforeIndexPath:center];
+    }
+
+    NSMutableArray *chunk = [NSMutableArray arrayWithCapacity:DXTableViewModelRowHeightChunkSize];
+    while (chunk.count < DXTableViewModelRowHeightChunkSize &&
+           (nil != self.rowHeightForwardCursor || nil != self.rowHeightBackwardCursor)) {
+        NSIndexPath *indexPath = self.rowHeightForwardCursor;
+        if (nil != indexPath) {
+            self.rowHeightForwardCursor = [self indexPathAfterIndexPath:indexPath];
+            [self addRowAtIndexPath:indexPath toRowHeightChunk:chunk];
+        }
+        indexPath = self.rowHeightBackwardCursor;
+        if (nil != indexPath && chunk.count < DXTableViewModelRowHeightChunkSize) {
+            self.rowHeightBackwardCursor = [self indexPathBeforeIndexPath:indexPath];
+            [self addRowAtIndexPath:indexPath toRowHeightChunk:chunk];
+        }
+    }
+    if (0 == chunk.count)
+        return;
+
+    _rowHeightChunkInFlight = YES;
+    NSUInteger generation = _rowHeightsGeneration;
+    __weak DXTableViewModel *weakSelf = self;
+    [self measureHeightsOfRowsInBackground:chunk completion:^{
+        DXTableViewModel *strongSelf = weakSelf;
+        // invalidateRowHeights has already dropped the chunk and restarted the walk
+        if (nil == strongSelf || generation != strongSelf.rowHeightsGeneration)
+            return;
+        strongSelf->_rowHeightChunkInFlight = NO;
+        [strongSelf precomputeRowHeights];
+    }];
+}
+
+- (void)precomputeRowHeightsOfSection:(DXTableViewSection *)section
+{
+    [self checkRowHeightsWidth];
+    NSMutableArray *chunk = [NSMutableArray arrayWithCapacity:DXTableViewModelRowHeightChunkSize];
+    for (NSInteger i = 0; i < section.numberOfRows; ++i) {
+        DXTableViewRow *row = [section existingRowAtIndex:i];
+        if (nil == row || ![self needsToMeasureHeightOfRowInBackground:row])
+            continue;
+        [chunk addObject:row];
+        if (DXTableViewModelRowHeightChunkSize == chunk.count) {
+            [self measureHeightsOfRowsInBackground:chunk completion:nil];
+            chunk = [NSMutableArray arrayWithCapacity:DXTableViewModelRowHeightChunkSize];
+        }
+    }
+    if (chunk.count > 0)
+        [self measureHeightsOfRowsInBackground:chunk completion:nil];
+}
+
+- (NSIndexPath *)indexPathAfterIndexPath:(NSIndexPath *)indexPath
+{
+    NSInteger sectionIndex = indexPath.section;
+    NSInteger rowIndex = indexPath.row + 1;
+    NSInteger sectionCount = self.mutableSections.count;
+    while (sectionIndex < sectionCount && rowIndex >= [self.mutableSections[sectionIndex] numberOfRows]) {
+        ++sectionIndex;
+        rowIndex = 0;
+    }
+    return sectionIndex < sectionCount ? [NSIndexPath indexPathForRow:rowIndex inSection:sectionIndex] : nil;
+}
+
+- (NSIndexPath *)indexPathBeforeIndexPath:(NSIndexPath *)indexPath
+{
+    NSInteger sectionIndex = MIN(indexPath.section, (NSInteger)self.mutableSections.count);
+    NSInteger rowIndex = sectionIndex == indexPath.section ? indexPath.row - 1 : -1;
+    while (sectionIndex >= 0 && rowIndex < 0) {
+        if (--sectionIndex >= 0)
+            rowIndex = [self.mutableSections[sectionIndex] numberOfRows] - 1;
+    }
+    return sectionIndex >= 0 ? [NSIndexPath indexPathForRow:rowIndex inSection:sectionIndex] : nil;
+}
+
+- (void)addRowAtIndexPath:(NSIndexPath *)indexPath toRowHeightChunk:(NSMutableArray *)chunk
+{
+    if (indexPath.section >= (NSInteger)self.mutableSections.count)
+        return;
+    DXTableViewSection *section = self.mutableSections[indexPath.section];
+    DXTableViewRow *row = indexPath.row < section.numberOfRows ? [section existingRowAtIndex:indexPath.row] : nil;
+    if (nil != row && [self needsToMeasureHeightOfRowInBackground:row])
+        [chunk addObject:row];
+}
+
+- (BOOL)needsToMeasureHeightOfRowInBackground:(DXTableViewRow *)row
+{
+    BOOL measuresText = nil == row.rowHeightBlock && row.sizesRowHeightToCellText;
+    return (nil != row.rowHeightForWidthBlock || measuresText) &&
+        ![self hasCachedHeightForRow:row] && ![self.rowsBeingMeasured containsObject:row];
+}
+
+// Measures given rows one after another in single operation and applies their heights in single main queue turn
+- (void)measureHeightsOfRowsInBackground:(NSArray *)rows completion:(void (^)(void))completion
+{
+    NSUInteger count = rows.count;
+    NSMutableArray *blocks = [NSMutableArray arrayWithCapacity:count];
+    NSMutableArray *boundData = [NSMutableArray arrayWithCapacity:count];
+    NSUInteger *tokens = malloc(count * sizeof(NSUInteger));
+    CGFloat *heights = malloc(count * sizeof(CGFloat));
+    if (NULL == tokens || NULL == heights) {
+        free(tokens);
+        free(heights);
+        if (nil != completion)
+            completion();
+        return;
+    }
+    NSPointerArray *weakRows = [NSPointerArray weakObjectsPointerArray];
+    CGFloat separatorHeight = [self separatorHeight];
+    // blocks of one chunk run one after another in single operation, which is done before its results are applied
+    __block NSUInteger textMeasurementHits = 0;
+    __block NSUInteger textMeasurementMisses = 0;
+    for (NSUInteger i = 0; i < count; ++i) {
+        DXTableViewRow *row = rows[i];
+        CGFloat (^block)(NSDictionary *, CGFloat) = row.rowHeightForWidthBlock;
+        if (nil == block) {
+            CGFloat (^textHeightBlock)(CGFloat, BOOL *) = DXCellTextHeightBlock(row, separatorHeight);
+            block = ^CGFloat (NSDictionary *boundData, CGFloat width) {
+                BOOL cacheHit;
+                CGFloat height = textHeightBlock(width, &cacheHit);
+                if (cacheHit)
+                    ++textMeasurementHits;
+                else
+                    ++textMeasurementMisses;
+                return height;
+            };
+        }
+        [blocks addObject:block];
+        [boundData addObject:[row.boundObjectData copy] ?: @{}];
+        tokens[i] = row.rowHeightToken;
+        [weakRows addPointer:(__bridge void *)row];
+        [self.rowsBeingMeasured addObject:row];
+    }
+
+    CGFloat width = _rowHeightsWidth;
+    NSUInteger generation = _rowHeightsGeneration;
+    __weak DXTableViewModel *weakSelf = self;
+    [self.rowHeightQueue addOperationWithBlock:^{
+        for (NSUInteger i = 0; i < count; ++i) {
+            CGFloat (^block)(NSDictionary *, CGFloat) = blocks[i];
+            heights[i] = block(boundData[i], width);
+        }
+        dispatch_async(dispatch_get_main_queue(), ^{
+            DXTableViewModelInstrumentation *instrumentation = weakSelf.instrumentation;
+            [instrumentation countEvent:@"textMeasurementHit" times:textMeasurementHits];
+            [instrumentation countEvent:@"textMeasurementMiss" times:textMeasurementMisses];
+            [weakSelf didMeasureHeights:heights ofRows:weakRows tokens:tokens generation:generation];
+            free(tokens);
+            free(heights);
+            if (nil != completion)
+                completion();
+        });
+    }];
+}
+
+- (void)didMeasureHeights:(const CGFloat *)heights
+                   ofRows:(NSPointerArray *)rows
+                   tokens:(const NSUInteger *)tokens
+               generation:(NSUInteger)generation
+{
+    if (generation != _rowHeightsGeneration)
+        return;
+
+    NSSet *visibleIndexPaths = nil;
+    BOOL needsLayout = NO;
+    for (NSUInteger i = 0; i < rows.count; ++i) {
+        DXTableViewRow *row = [rows pointerAtIndex:i];
+        if (nil == row || tokens[i] != row.rowHeightToken)
+            continue;
+        [self.rowsBeingMeasured removeObject:row];
+        if (row.tableViewModel != self)
+            continue;
+        row.cachedRowHeight = heights[i];
+        row.cachedRowHeightGeneration = _rowHeightsGeneration;
+        [self updateHeightTreeForRow:row];
+        if (!needsLayout) {
+            if (nil == visibleIndexPaths)
+                visibleIndexPaths = [NSSet setWithArray:_tableView.indexPathsForVisibleRows];
+            needsLayout = [visibleIndexPaths containsObject:row.rowIndexPath];
+        }
+    }
+
+    // makes table view to ask for new heights of visible rows without reloading cells,
+    // amid a transaction the outermost endUpdates does it
+    if (needsLayout) {
+        if (0 < _updatesDepth) {
+            _relayoutNeeded = YES;
+            return;
+        }
+        [_tableView beginUpdates];
+        [_tableView endUpdates];
+    }
+}
+
+- (void)setNeedsRebuildHeightTree
+{
+    _heightTreeNeedsRebuild = YES;
+}
+
+// Slot and tree buffers grow geometrically, so slots spliced in one by one don't reallocate each time
+- (void)reserveHeightSlots:(NSUInteger)slotCount
+{
+    if (slotCount <= _slotCapacity)
+        return;
+    _slotCapacity = MAX(slotCount, _slotCapacity * 2);
+    _slotHeights = realloc(_slotHeights, sizeof(CGFloat) * (_slotCapacity + 1));
+    _heightTree = realloc(_heightTree, sizeof(CGFloat) * (_slotCapacity + 1));
+}
+
+- (void)rebuildHeightTreeIfNeeded
+{
+    [self checkRowHeightsWidth];
+    if (_heightTreeNeedsRebuild) {
+        NSUInteger sectionCount = self.mutableSections.count;
+        NSUInteger slotCount = 0;
+        for (DXTableViewSection *section in self.mutableSections)
+            slotCount += (section.isVirtualized ? 1 : section.numberOfRows) + 2;
+
+        [self reserveHeightSlots:slotCount];
+        _sectionSlotStarts = realloc(_sectionSlotStarts, sizeof(NSUInteger) * (sectionCount + 1));
+        _slotCount = slotCount;
+
+        NSUInteger slot = 0;
+        for (NSUInteger s = 0; s < sectionCount; ++s) {
+            DXTableViewSection *section = self.mutableSections[s];
+            _sectionSlotStarts[s] = slot;
+            _slotHeights[slot++] = MAX(section.headerHeight, 0);
+            // virtualized section takes single slot of estimated heights however many rows it has
+            if (section.isVirtualized)
+                _slotHeights[slot++] = section.numberOfRows * [self defaultRowHeight];
+            else for (NSInteger r = 0; r < section.numberOfRows; ++r)
+                _slotHeights[slot++] = [self knownHeightForRow:[section existingRowAtIndex:r]];
+            _slotHeights[slot++] = MAX(section.footerHeight, 0);
+        }
+        _sectionSlotStarts[sectionCount] = slot;
+        _heightTreeNeedsRebuild = NO;
+        _heightTreeNeedsConstruction = YES;
+    }
+    if (!_heightTreeNeedsConstruction)
+        return;
+
+    // linear time construction from known slot heights, rows aren't asked for them
+    memcpy(_heightTree, _slotHeights, sizeof(CGFloat) * _slotCount);
+    for (NSUInteger i = 1; i <= _slotCount; ++i) {
+        NSUInteger parent = i + (i & (~i + 1));
+        if (parent <= _slotCount)
+            _heightTree[parent - 1] += _heightTree[i - 1];
+    }
+    _heightTreeNeedsConstruction = NO;
+}
+
+// Slot of single inserted or removed row is spliced into slot heights, so heights of other rows aren't asked for
+// again. Fenwick tree has no sublinear insertion, it is constructed from slot heights when it is read next time.
+- (void)spliceHeightSlotOfSection:(DXTableViewSection *)section atRowIndex:(NSInteger)rowIndex inserted:(BOOL)inserted
+{
+    [self checkRowHeightsWidth];
+    if (_heightTreeNeedsRebuild)
+        return;
+    NSUInteger sectionCount = self.mutableSections.count;
+    NSInteger sectionIndex = section.sectionIndex;
+    // slots still describe the section as it was before the change
+    NSUInteger numberOfSlots = section.numberOfRows + (inserted ? -1 : 1) + 2;
+    if (section.isVirtualized || NSNotFound == sectionIndex || (NSUInteger)sectionIndex >= sectionCount ||
+        _sectionSlotStarts[sectionIndex + 1] - _sectionSlotStarts[sectionIndex] != numberOfSlots) {
+        _heightTreeNeedsRebuild = YES;
+        return;
+    }
+
+    NSUInteger slot = _sectionSlotStarts[sectionIndex] + 1 + rowIndex;
+    if (inserted) {
+        [self reserveHeightSlots:_slotCount + 1];
+        memmove(_slotHeights + slot + 1, _slotHeights + slot, sizeof(CGFloat) * (_slotCount - slot));
+        _slotHeights[slot] = [self knownHeightForRow:[section existingRowAtIndex:rowIndex]];
+        ++_slotCount;
+    }
+    else {
+        memmove(_slotHeights + slot, _slotHeights + slot + 1, sizeof(CGFloat) * (_slotCount - slot - 1));
+        --_slotCount;
+    }
+    for (NSUInteger s = sectionIndex + 1; s <= sectionCount; ++s)
+        _sectionSlotStarts[s] = inserted ? _sectionSlotStarts[s] + 1 : _sectionSlotStarts[s] - 1;
+    _heightTreeNeedsConstruction = YES;
+}
+
+- (void)section:(DXTableViewSection *)section didInsertRowAtIndex:(NSInteger)index
+{
+    [self spliceHeightSlotOfSection:section atRowIndex:index inserted:YES];
+}
+
+- (void)section:(DXTableViewSection *)section didRemoveRowAtIndex:(NSInteger)index
+{
+    [self spliceHeightSlotOfSection:section atRowIndex:index inserted:NO];
+}
+
+- (void)updateHeightTreeForRow:(DXTableViewRow *)row
+{
+    if (_heightTreeNeedsRebuild || row.tableViewModel != self || row.section.isVirtualized)
+        return;
+    NSIndexPath *indexPath = row.rowIndexPath;
+    NSUInteger slot = _sectionSlotStarts[indexPath.section] + 1 + indexPath.row;
+    CGFloat height = [self knownHeightForRow:row];
+    // tree waiting for construction picks slot height up then
+    if (!_heightTreeNeedsConstruction)
+        DXHeightTreeAdd(_heightTree, _slotCount, slot, height - _slotHeights[slot]);
+    _slotHeights[slot] = height;
+}
+
+- (CGFloat)contentHeight
+{
+    [self rebuildHeightTreeIfNeeded];
+    return DXHeightTreePrefixSum(_heightTree, _slotCount);
+}
+
+- (NSIndexPath *)indexPathForRowAtOffset:(CGFloat)offset
+{
+    [self rebuildHeightTreeIfNeeded];
+    if (offset < 0)
+        return nil;
+    NSUInteger slot = DXHeightTreeSlotAtOffset(_heightTree, _slotCount, offset);
+    if (slot >= _slotCount)
+        return nil;
+
+    // binary search of the section containing the slot
+    NSUInteger low = 0;
+    NSUInteger high = self.mutableSections.count;
+    while (high - low > 1) {
+        NSUInteger middle = (low + high) / 2;
+        if (_sectionSlotStarts[middle] <= slot)
+            low = middle;
+        else
+            high = middle;
+    }
+    DXTableViewSection *section = self.mutableSections[low];
+    NSInteger row = slot - _sectionSlotStarts[low] - 1;
+    if (section.isVirtualized && 0 == row) {
+        CGFloat spanOffset = offset - DXHeightTreePrefixSum(_heightTree, slot);
+        row = MIN((NSInteger)(spanOffset / [self defaultRowHeight]), section.numberOfRows - 1);
+    }
+    else if (section.isVirtualized || row < 0 || row >= section.numberOfRows) {
+        return nil;
+    }
+    return [NSIndexPath indexPathForRow:row inSection:low];
+}
+
+#pragma mark - Snapshots
+
+static id DXTableViewRowIdentity(DXTableViewRow *row)
+{
+    return nil != row.rowIdentifier ? row.rowIdentifier : [NSValue valueWithNonretainedObject:row];
+}
+
+- (void)replaceSectionsWithSections:(NSArray *)sections
+{
+    // new section objects are diffed against rows of the old ones with the same names
+    for (DXTableViewSection *section in self.mutableSections)
+        [self sectionWillChangeRows:section];
+    NSSet *keptSections = [NSSet setWithArray:sections];
+    for (DXTableViewSection *section in self.mutableSections) {
+        if (![keptSections containsObject:section])
+            section.tableViewModel = nil;
+    }
+    [self.mutableSections setArray:sections];
+    [self.sectionByName removeAllObjects];
+    for (DXTableViewSection *section in sections) {
+        self.sectionByName[section.sectionName] = section;
+        section.tableViewModel = self;
+        section.rowCallbacksSummarized = NO;
+        [section registerNibOrClassForRows];
+    }
+    [self invalidateSectionIndexes];
+    [self updateNeededCallbacks];
+}
+
+// Captures contents as [sectionName, rows] pairs. Virtualized sections are captured with their number of rows
+// instead of rows, so capturing doesn't materialize them.
+- (NSArray *)contentsSnapshot
+{
+    NSMutableArray *contents = [NSMutableArray arrayWithCapacity:self.mutableSections.count];
+    for (DXTableViewSection *section in self.mutableSections)
+        [contents addObject:@[section.sectionName, DXSectionContentsRows(section)]];
+    return contents;
+}
+
+// Rows of section contents, nil for virtualized sections and for sections captured as themselves
+static NSArray *DXContentsRows(NSArray *sectionContents)
+{
+    id rows = sectionContents[1];
+    return [rows isKindOfClass:[NSArray class]] ? rows : nil;
+}
 
-- (void)registerNibOrClassForRows;
+- (void)applySnapshot:(NSArray *)sections animated:(BOOL)animated
+{
+    if (animated) {
+        [self applySnapshot:sections withRowAnimation:UITableViewRowAnimationAutomatic];
+        return;
+    }
+    [self raiseIfSectionNamesAreNotUnique:sections];
+    [self replaceSectionsWithSections:sections];
+    if (nil != _tableView && !self.isUpdating)
+        [_tableView reloadData];
+}
 
-@end
+- (void)applySnapshot:(NSArray *)sections withRowAnimation:(UITableViewRowAnimation)animation
+{
+    [self raiseIfSectionNamesAreNotUnique:sections];
 
-@interface DXTableViewModel ()
+    // inside beginUpdates/endUpdates the difference is computed by endUpdates
+    if ([self deferUpdateWithRowAnimation:animation]) {
+        [self replaceSectionsWithSections:sections];
+        return;
+    }
+    NSArray *oldContents = nil != _tableView ? [self contentsSnapshot] : nil;
+    [self replaceSectionsWithSections:sections];
+    if (nil == _tableView)
+        return;
+
+    [_tableView beginUpdates];
+    [self updateTableViewFromContents:oldContents
+                           toContents:[self contentsSnapshot]
+                         reloadedRows:nil
+                 reloadedSectionNames:nil
+                        rowAnimations:nil
+                    sectionAnimations:nil
+                            animation:animation];
+    [_tableView endUpdates];
+}
+
+- (void)raiseIfSectionNamesAreNotUnique:(NSArray *)sections
+{
+    NSMutableSet *names = [NSMutableSet setWithCapacity:sections.count];
+    for (DXTableViewSection *section in sections) {
+        if ([names containsObject:section.sectionName]) {
+            NSString *fmt = @"\"%@\" section name is already exists in the snapshot, but section name must be unique";
+            [NSException raise:NSInvalidArgumentException format:fmt, section.sectionName];
+        }
+        [names addObject:section.sectionName];
+    }
+}
 
-@property (strong, nonatomic) NSMutableArray *mutableSections;
+// Marks elements of the longest increasing subsequence of `values`. Elements that are left unmarked are the fewest ones
+// that have to move to put all values in increasing order. Returns NO if there is no memory for the computation.
+static BOOL DXMarkLongestIncreasingSubsequence(const NSInteger *values, NSInteger count, BOOL *marks)
+{
+    if (0 == count)
+        return YES;
+    // tails[l] is index of the smallest last value of increasing subsequences of length l + 1
+    NSInteger *tails = malloc(sizeof(NSInteger) * count);
+    NSInteger *predecessors = malloc(sizeof(NSInteger) * count);
+    if (NULL == tails || NULL == predecessors) {
+        free(tails);
+        free(predecessors);
+        return NO;
+    }
+    NSInteger length = 0;
+    for (NSInteger i = 0; i < count; ++i) {
+        NSInteger low = 0, high = length;
+        while (low < high) {
+            NSInteger middle = (low + high) / 2;
+            if (values[tails[middle]] < values[i])
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        predecessors[i] = low > 0 ? tails[low - 1] : NSNotFound;
+        tails[low] = i;
+        if (low == length)
+            ++length;
+    }
+    memset(marks, NO, sizeof(BOOL) * count);
+    for (NSInteger i = tails[length - 1]; NSNotFound != i; i = predecessors[i])
+        marks[i] = YES;
+    free(tails);
+    free(predecessors);
+    return YES;
+}
+
+static void DXAddIndexPathForAnimation(NSMutableDictionary *indexPathsByAnimation, NSIndexPath *indexPath, NSNumber *animation)
+{
+    NSMutableArray *indexPaths = indexPathsByAnimation[animation];
+    if (nil == indexPaths)
+        indexPathsByAnimation[animation] = indexPaths = [NSMutableArray array];
+    [indexPaths addObject:indexPath];
+}
+
+static void DXAddIndexForAnimation(NSMutableDictionary *indexesByAnimation, NSInteger index, NSNumber *animation)
+{
+    NSMutableIndexSet *indexes = indexesByAnimation[animation];
+    if (nil == indexes)
+        indexesByAnimation[animation] = indexes = [NSMutableIndexSet indexSet];
+    [indexes addIndex:index];
+}
+
+// Sections and rows are animated with animations recorded for them by name and by row object, others with `animation`
+- (void)updateTableViewFromContents:(NSArray *)oldSections
+                         toContents:(NSArray *)sections
+                       reloadedRows:(NSSet *)reloadedRows
+               reloadedSectionNames:(NSSet *)reloadedSectionNames
+                      rowAnimations:(NSMapTable *)rowAnimations
+                  sectionAnimations:(NSDictionary *)sectionAnimations
+                          animation:(UITableViewRowAnimation)animation
+{
+    NSNumber *defaultAnimation = @(animation);
+    NSNumber *(^animationOfRow)(DXTableViewRow *) = ^NSNumber *(DXTableViewRow *row) {
+        NSNumber *rowAnimation = [rowAnimations objectForKey:row];
+        return nil != rowAnimation ? rowAnimation : defaultAnimation;
+    };
+    NSNumber *(^animationOfSection)(NSString *) = ^NSNumber *(NSString *name) {
+        NSNumber *sectionAnimation = sectionAnimations[name];
+        return nil != sectionAnimation ? sectionAnimation : defaultAnimation;
+    };
+
+    NSInteger oldSectionCount = oldSections.count;
+    NSInteger newSectionCount = sections.count;
+
+    NSMutableDictionary *oldSectionIndexByName = [NSMutableDictionary dictionaryWithCapacity:oldSectionCount];
+    NSInteger oldRowCount = 0;
+    for (NSInteger i = 0; i < oldSectionCount; ++i) {
+        oldSectionIndexByName[oldSections[i][0]] = @(i);
+        oldRowCount += DXContentsRows(oldSections[i]).count;
+    }
+    NSInteger newRowCount = 0;
+    for (NSArray *section in sections)
+        newRowCount += DXContentsRows(section).count;
+
+    NSInteger *oldToNewSection = malloc(sizeof(NSInteger) * (oldSectionCount + 1));
+    NSInteger *newToOldSection = malloc(sizeof(NSInteger) * (newSectionCount + 1));
+    BOOL *sectionMoved = calloc(newSectionCount + 1, sizeof(BOOL));
+    NSInteger *oldRowSection = malloc(sizeof(NSInteger) * (oldRowCount + 1));
+    NSInteger *oldRowRow = malloc(sizeof(NSInteger) * (oldRowCount + 1));
+    NSInteger *oldToNewRow = malloc(sizeof(NSInteger) * (oldRowCount + 1));
+    NSInteger *newRowSection = malloc(sizeof(NSInteger) * (newRowCount + 1));
+    NSInteger *newRowRow = malloc(sizeof(NSInteger) * (newRowCount + 1));
+    NSInteger *newToOldRow = malloc(sizeof(NSInteger) * (newRowCount + 1));
+    BOOL *rowStays = calloc(newRowCount + 1, sizeof(BOOL));
+    // scratch buffers for subsequences of sections and of rows of one section
+    NSInteger scratchCount = MAX(newSectionCount, newRowCount) + 1;
+    NSInteger *sequence = malloc(sizeof(NSInteger) * scratchCount);
+    NSInteger *sequencePositions = malloc(sizeof(NSInteger) * scratchCount);
+    BOOL *sequenceMarks = malloc(sizeof(BOOL) * scratchCount);
+
+    BOOL diffed = NULL != oldToNewSection && NULL != newToOldSection && NULL != sectionMoved &&
+        NULL != oldRowSection && NULL != oldRowRow && NULL != oldToNewRow && NULL != newRowSection &&
+        NULL != newRowRow && NULL != newToOldRow && NULL != rowStays && NULL != sequence &&
+        NULL != sequencePositions && NULL != sequenceMarks;
+
+    NSMutableDictionary *deletedSections = [NSMutableDictionary dictionary];
+    NSMutableDictionary *insertedSections = [NSMutableDictionary dictionary];
+    NSMutableArray *movedSections = [NSMutableArray array];
+    NSMutableDictionary *deletedRows = [NSMutableDictionary dictionary];
+    NSMutableDictionary *insertedRows = [NSMutableDictionary dictionary];
+    NSMutableDictionary *reloadedRowIndexPaths = [NSMutableDictionary dictionary];
+    NSMutableArray *movedRows = [NSMutableArray array];
+
+    if (diffed) {
+        // Match sections by name. Reloaded sections, as well as virtualized sections which number of rows did change,
+        // are left unmatched and thus deleted and inserted as a whole.
+        for (NSInteger i = 0; i < oldSectionCount; ++i)
+            oldToNewSection[i] = NSNotFound;
+        for (NSInteger j = 0; j < newSectionCount; ++j) {
+            NSString *name = sections[j][0];
+            NSNumber *oldIndex = oldSectionIndexByName[name];
+            newToOldSection[j] = NSNotFound;
+            if (nil == oldIndex || [reloadedSectionNames containsObject:name])
+                continue;
+            id oldRows = oldSections[oldIndex.integerValue][1];
+            id newRows = sections[j][1];
+            BOOL oldVirtualized = nil == DXContentsRows(oldSections[oldIndex.integerValue]);
+            BOOL newVirtualized = nil == DXContentsRows(sections[j]);
+            if (oldVirtualized != newVirtualized || (newVirtualized && ![oldRows isEqual:newRows]))
+                continue;
+            newToOldSection[j] = oldIndex.integerValue;
+            oldToNewSection[oldIndex.integerValue] = j;
+        }
+
+        // Flatten rows and match them by identity
+        NSMutableDictionary *oldRowByIdentity = [NSMutableDictionary dictionaryWithCapacity:oldRowCount];
+        NSInteger f = 0;
+        for (NSInteger i = 0; i < oldSectionCount; ++i) {
+            NSArray *rows = DXContentsRows(oldSections[i]);
+            for (NSInteger r = 0; r < rows.count; ++r, ++f) {
+                oldRowSection[f] = i;
+                oldRowRow[f] = r;
+                oldToNewRow[f] = NSNotFound;
+                oldRowByIdentity[DXTableViewRowIdentity(rows[r])] = @(f);
+            }
+        }
+        NSInteger g = 0;
+        for (NSInteger j = 0; j < newSectionCount; ++j) {
+            NSArray *rows = DXContentsRows(sections[j]);
+            for (NSInteger k = 0; k < rows.count; ++k, ++g) {
+                newRowSection[g] = j;
+                newRowRow[g] = k;
+                newToOldRow[g] = NSNotFound;
+                NSNumber *oldFlatIndex = oldRowByIdentity[DXTableViewRowIdentity(rows[k])];
+                if (nil != oldFlatIndex && NSNotFound == oldToNewRow[oldFlatIndex.integerValue]) {
+                    newToOldRow[g] = oldFlatIndex.integerValue;
+                    oldToNewRow[oldFlatIndex.integerValue] = g;
+                }
+            }
+        }
+
+        // Sections: matched sections which keep their relative order stay, the rest of them are moved
+        NSInteger count = 0;
+        for (NSInteger j = 0; j < newSectionCount; ++j) {
+            if (NSNotFound == newToOldSection[j]) {
+                DXAddIndexForAnimation(insertedSections, j, animationOfSection(sections[j][0]));
+                continue;
+            }
+            sequence[count] = newToOldSection[j];
+            sequencePositions[count++] = j;
+        }
+        diffed = DXMarkLongestIncreasingSubsequence(sequence, count, sequenceMarks);
+        for (NSInteger l = 0; diffed && l < count; ++l) {
+            if (sequenceMarks[l])
+                continue;
+            NSInteger j = sequencePositions[l];
+            [movedSections addObject:@[@(newToOldSection[j]), @(j)]];
+            sectionMoved[j] = YES;
+        }
+        for (NSInteger i = 0; i < oldSectionCount; ++i) {
+            if (NSNotFound == oldToNewSection[i])
+                DXAddIndexForAnimation(deletedSections, i, animationOfSection(oldSections[i][0]));
+        }
+
+        // Rows: rows which stay in their matched section and keep their relative order stay, the rest of them move
+        for (g = 0; diffed && g < newRowCount; ) {
+            NSInteger j = newRowSection[g];
+            NSInteger i = newToOldSection[j];
+            count = 0;
+            for (; g < newRowCount && newRowSection[g] == j; ++g) {
+                f = newToOldRow[g];
+                if (NSNotFound == i || NSNotFound == f || oldRowSection[f] != i)
+                    continue;
+                sequence[count] = oldRowRow[f];
+                sequencePositions[count++] = g;
+            }
+            diffed = DXMarkLongestIncreasingSubsequence(sequence, count, sequenceMarks);
+            for (NSInteger l = 0; diffed && l < count; ++l)
+                rowStays[sequencePositions[l]] = sequenceMarks[l];
+        }
+
+        // Rows leaving surviving sections. Rows of deleted sections go away with their sections.
+        for (f = 0; diffed && f < oldRowCount; ++f) {
+            NSInteger i = oldRowSection[f];
+            if (NSNotFound == oldToNewSection[i])
+                continue;
+            g = oldToNewRow[f];
+            if (NSNotFound == g || NSNotFound == newToOldSection[newRowSection[g]])
+                DXAddIndexPathForAnimation(deletedRows, [NSIndexPath indexPathForRow:oldRowRow[f] inSection:i],
+                                           animationOfRow(DXContentsRows(oldSections[i])[oldRowRow[f]]));
+        }
+
+        // Rows of surviving sections. Rows of inserted sections come with their sections.
+        for (g = 0; diffed && g < newRowCount; ++g) {
+            NSInteger j = newRowSection[g];
+            NSInteger k = newRowRow[g];
+            if (NSNotFound == newToOldSection[j])
+                continue;
+
+            NSIndexPath *indexPath = [NSIndexPath indexPathForRow:k inSection:j];
+            DXTableViewRow *newRow = DXContentsRows(sections[j])[k];
+            f = newToOldRow[g];
+            if (NSNotFound == f || NSNotFound == oldToNewSection[oldRowSection[f]]) {
+                DXAddIndexPathForAnimation(insertedRows, indexPath, animationOfRow(newRow));
+                continue;
+            }
+
+            NSInteger i = oldRowSection[f];
+            NSInteger r = oldRowRow[f];
+            NSIndexPath *oldIndexPath = [NSIndexPath indexPathForRow:r inSection:i];
+            DXTableViewRow *oldRow = DXContentsRows(oldSections[i])[r];
+            BOOL changed = oldRow != newRow || [reloadedRows containsObject:newRow];
+            BOOL moved = !rowStays[g];
+
+            if (!changed && moved) {
+                [movedRows addObject:@[oldIndexPath, indexPath]];
+            } else if (changed && !moved && !sectionMoved[j]) {
+                DXAddIndexPathForAnimation(reloadedRowIndexPaths, oldIndexPath, animationOfRow(newRow));
+            } else if (changed) {
+                DXAddIndexPathForAnimation(deletedRows, oldIndexPath, animationOfRow(oldRow));
+                DXAddIndexPathForAnimation(insertedRows, indexPath, animationOfRow(newRow));
+            }
+        }
+    }
 
-@end
+    free(oldToNewSection);
+    free(newToOldSection);
+    free(sectionMoved);
+    free(oldRowSection);
+    free(oldRowRow);
+    free(oldToNewRow);
+    free(newRowSection);
+    free(newRowRow);
+    free(newToOldRow);
+    free(rowStays);
+    free(sequence);
+    free(sequencePositions);
+    free(sequenceMarks);
+
+    // without memory for the difference all sections are replaced
+    if (!diffed) {
+        if (oldSectionCount > 0)
+            [_tableView deleteSections:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, oldSectionCount)]
+                      withRowAnimation:animation];
+        if (newSectionCount > 0)
+            [_tableView insertSections:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, newSectionCount)]
+                      withRowAnimation:animation];
+        return;
+    }
 
-@implementation DXTableViewModel
+    UITableView *tableView = _tableView;
+    [deletedSections enumerateKeysAndObjectsUsingBlock:^(NSNumber *sectionAnimation, NSIndexSet *indexes, BOOL *stop) {
+        [tableView deleteSections:indexes withRowAnimation:sectionAnimation.integerValue];
+    }];
+    [insertedSections enumerateKeysAndObjectsUsingBlock:^(NSNumber *sectionAnimation, NSIndexSet *indexes, BOOL *stop) {
+        [tableView insertSections:indexes withRowAnimation:sectionAnimation.integerValue];
+    }];
+    for (NSArray *move in movedSections)
+        [_tableView moveSection:[move[0] integerValue] toSection:[move[1] integerValue]];
+    [deletedRows enumerateKeysAndObjectsUsingBlock:^(NSNumber *rowAnimation, NSArray *indexPaths, BOOL *stop) {
+        [tableView deleteRowsAtIndexPaths:indexPaths withRowAnimation:rowAnimation.integerValue];
+    }];
+    [insertedRows enumerateKeysAndObjectsUsingBlock:^(NSNumber *rowAnimation, NSArray *indexPaths, BOOL *stop) {
+        [tableView insertRowsAtIndexPaths:indexPaths withRowAnimation:rowAnimation.integerValue];
+    }];
+    [reloadedRowIndexPaths enumerateKeysAndObjectsUsingBlock:^(NSNumber *rowAnimation, NSArray *indexPaths, BOOL *stop) {
+        [tableView reloadRowsAtIndexPaths:indexPaths withRowAnimation:rowAnimation.integerValue];
+    }];
+    for (NSArray *move in movedRows)
+        [_tableView moveRowAtIndexPath:move[0] toIndexPath:move[1]];
+}
 
-#pragma DXTableViewModel
+#pragma mark - Grouping
 
-- (id)init
+static NSComparisonResult DXGroupingKeyCompare(NSString *key, NSString *otherKey)
 {
-    self = [super init];
-    if (nil == self)
-        return nil;
-
-    _showsDefaultTitleForDeleteConfirmationButton = YES;
+    return [key localizedCompare:otherKey];
+}
 
-    return self;
+// Index of the first key greater than `key`, so items with equal keys keep their insertion order
+static NSUInteger DXGroupingKeyInsertionIndex(NSArray *keys, NSString *key)
+{
+    return [keys indexOfObject:key
+                 inSortedRange:NSMakeRange(0, keys.count)
+                       options:NSBinarySearchingInsertionIndex | NSBinarySearchingLastEqual
+               usingComparator:^NSComparisonResult(NSString *key1, NSString *key2) {
+                   return DXGroupingKeyCompare(key1, key2);
+               }];
 }
 
-- (instancetype)initWithTableView:(UITableView *)tableView
+- (NSString *)groupingKeyForItem:(id)item
 {
-    self = [self init];
-    if (nil == self)
-        return nil;
+    NSString *key = self.groupingKeyBlock(item);
+    return nil != key ? key : @"";
+}
 
-    self.tableView = tableView;
+- (NSInteger)collationIndexForGroupingKey:(NSString *)key
+{
+    // key string is its own collation string
+    return [self.groupingCollation sectionForObject:key collationStringSelector:@selector(self)];
+}
 
-    return self;
+// Position of the group with given collation index among existing groups, or position it would be inserted at
+- (NSUInteger)groupIndexForCollationIndex:(NSInteger)collationIndex
+{
+    return [self.groupCollationIndexes indexOfObject:@(collationIndex)
+                                       inSortedRange:NSMakeRange(0, self.groupCollationIndexes.count)
+                                             options:NSBinarySearchingInsertionIndex | NSBinarySearchingFirstEqual
+                                     usingComparator:^NSComparisonResult(NSNumber *index1, NSNumber *index2) {
+                                         return [index1 compare:index2];
+                                     }];
 }
 
-- (NSString *)description
+- (DXTableViewSection *)groupSectionWithCollationIndex:(NSInteger)collationIndex
 {
-    NSString *description = [NSString stringWithFormat:@"<%@: %p; sections=%@>", [self class], self, self.mutableSections];
-    return description;
+    NSString *title = self.groupingCollation.sectionTitles[collationIndex];
+    DXTableViewSection *section = [[DXTableViewSection alloc] initWithName:title];
+    section.headerTitle = title;
+    return section;
 }
 
-- (void)setTableView:(UITableView *)tableView
+- (void)groupItems:(NSArray *)items
+     withCollation:(UILocalizedIndexedCollation *)collation
+          keyBlock:(NSString *(^)(id item))keyBlock
+          rowBlock:(DXTableViewRow *(^)(id item))rowBlock
+          animated:(BOOL)animated
 {
-    if (_tableView != tableView) {
-        _tableView = tableView;
-        _tableView.delegate = self;
-        _tableView.dataSource = self;
-        [self.sections makeObjectsPerformSelector:@selector(registerNibOrClassForRows)];
+    BOOL wasGrouping = nil != self.groupingCollation;
+    NSSet *previousGroupSections = nil != self.groupSections ? [NSSet setWithArray:self.groupSections] : nil;
+    self.groupingCollation = collation;
+    self.groupingKeyBlock = keyBlock;
+    self.groupingRowBlock = rowBlock;
+    self.groupedSectionIndexTitles = collation.sectionIndexTitles;
+    self.groupSections = [NSMutableArray array];
+    self.groupCollationIndexes = [NSMutableArray array];
+    self.groupKeysBySectionName = [NSMutableDictionary dictionary];
+    self.groupedRowByItem = [NSMapTable strongToStrongObjectsMapTable];
+    self.groupedKeyByRow = [NSMapTable weakToStrongObjectsMapTable];
+
+    NSUInteger numberOfGroups = collation.sectionTitles.count;
+    NSMutableArray *buckets = [NSMutableArray arrayWithCapacity:numberOfGroups];
+    for (NSUInteger i = 0; i < numberOfGroups; ++i)
+        [buckets addObject:[NSMutableArray array]];
+    for (id item in items) {
+        NSString *key = [self groupingKeyForItem:item];
+        [buckets[[self collationIndexForGroupingKey:key]] addObject:@[key, item]];
+    }
+
+    [buckets enumerateObjectsUsingBlock:^(NSMutableArray *bucket, NSUInteger collationIndex, BOOL *stop) {
+        if (0 == bucket.count)
+            return;
+        [bucket sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(NSArray *entry1, NSArray *entry2) {
+            return DXGroupingKeyCompare(entry1[0], entry2[0]);
+        }];
+        DXTableViewSection *section = [self groupSectionWithCollationIndex:collationIndex];
+        NSMutableArray *keys = [NSMutableArray arrayWithCapacity:bucket.count];
+        NSMutableArray *rows = [NSMutableArray arrayWithCapacity:bucket.count];
+        for (NSArray *entry in bucket) {
+            DXTableViewRow *row = rowBlock(entry[1]);
+            [self.groupedRowByItem setObject:row forKey:entry[1]];
+            [self.groupedKeyByRow setObject:entry[0] forKey:row];
+            [keys addObject:entry[0]];
+            [rows addObject:row];
+        }
+        [section addRows:rows];
+        self.groupKeysBySectionName[section.sectionName] = keys;
+        [self.groupSections addObject:section];
+        [self.groupCollationIndexes addObject:@(collationIndex)];
+    }];
+
+    // other sections stay where they are, groups take the place of previous groups or follow other sections
+    NSMutableArray *sections = [NSMutableArray arrayWithCapacity:self.mutableSections.count + self.groupSections.count];
+    NSUInteger groupsIndex = NSNotFound;
+    for (DXTableViewSection *section in self.mutableSections) {
+        if (![previousGroupSections containsObject:section])
+            [sections addObject:section];
+        else if (NSNotFound == groupsIndex)
+            groupsIndex = sections.count;
+    }
+    if (NSNotFound == groupsIndex)
+        groupsIndex = sections.count;
+    [sections insertObjects:self.groupSections
+                  atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(groupsIndex, self.groupSections.count)]];
+    [self applySnapshot:sections animated:animated];
+    // table view asks whether section index methods are implemented only when data source is set
+    if (!wasGrouping)
+        [self connectTableView];
+}
+
+- (void)insertGroupedItem:(id)item withRowAnimation:(UITableViewRowAnimation)animation
+{
+    if (nil != [self.groupedRowByItem objectForKey:item])
+        [NSException raise:NSInvalidArgumentException format:@"\"%@\" item is already grouped", item];
+
+    NSString *key = [self groupingKeyForItem:item];
+    NSInteger collationIndex = [self collationIndexForGroupingKey:key];
+    DXTableViewRow *row = self.groupingRowBlock(item);
+    [self.groupedRowByItem setObject:row forKey:item];
+    [self.groupedKeyByRow setObject:key forKey:row];
+
+    NSUInteger groupIndex = [self groupIndexForCollationIndex:collationIndex];
+    if (groupIndex < self.groupCollationIndexes.count &&
+        [self.groupCollationIndexes[groupIndex] integerValue] == collationIndex) {
+        DXTableViewSection *section = self.groupSections[groupIndex];
+        NSMutableArray *keys = self.groupKeysBySectionName[section.sectionName];
+        NSUInteger index = DXGroupingKeyInsertionIndex(keys, key);
+        [keys insertObject:key atIndex:index];
+        [section insertRows:@[row] atIndex:index withRowAnimation:animation];
+        return;
+    }
+
+    // group was empty, its section goes right before the section of the next group
+    DXTableViewSection *section = [self groupSectionWithCollationIndex:collationIndex];
+    [section addRow:row];
+    self.groupKeysBySectionName[section.sectionName] = [NSMutableArray arrayWithObject:key];
+    NSInteger sectionIndex = self.mutableSections.count;
+    if (groupIndex < self.groupSections.count)
+        sectionIndex = [self.groupSections[groupIndex] sectionIndex];
+    else if (0 < groupIndex)
+        sectionIndex = [self.groupSections[groupIndex - 1] sectionIndex] + 1;
+    [self.groupSections insertObject:section atIndex:groupIndex];
+    [self.groupCollationIndexes insertObject:@(collationIndex) atIndex:groupIndex];
+
+    NSIndexSet *indexes = [NSIndexSet indexSetWithIndex:sectionIndex];
+    [self insertSections:@[section] atIndexes:indexes];
+    if (![self deferUpdateWithRowAnimation:animation])
+        [self.tableView insertSections:indexes withRowAnimation:animation];
+}
+
+- (void)deleteGroupedItem:(id)item withRowAnimation:(UITableViewRowAnimation)animation
+{
+    DXTableViewRow *row = [self.groupedRowByItem objectForKey:item];
+    if (nil == row)
+        [NSException raise:NSInvalidArgumentException format:@"\"%@\" item isn't grouped", item];
+
+    DXTableViewSection *section = row.section;
+    [self.groupedRowByItem removeObjectForKey:item];
+    [self.groupedKeyByRow removeObjectForKey:row];
+    if (1 == section.numberOfRows) {
+        NSUInteger groupIndex = [self.groupSections indexOfObjectIdenticalTo:section];
+        [self.groupSections removeObjectAtIndex:groupIndex];
+        [self.groupCollationIndexes removeObjectAtIndex:groupIndex];
+        [self.groupKeysBySectionName removeObjectForKey:section.sectionName];
+        [self deleteSectionsWithNames:@[section.sectionName] withRowAnimation:animation];
+        return;
     }
+
+    [self.groupKeysBySectionName[section.sectionName] removeObjectAtIndex:row.rowIndexPath.row];
+    [section deleteRows:@[row] withRowAnimation:animation];
 }
 
-- (NSMutableArray *)mutableSections
+- (void)insertGroupedItems:(NSArray *)items withRowAnimation:(UITableViewRowAnimation)animation
 {
-    if (nil == _mutableSections) {
-        _mutableSections = [NSMutableArray array];
+    BOOL batches = 1 < items.count;
+    if (batches)
+        [self beginUpdates];
+    for (id item in items)
+        [self insertGroupedItem:item withRowAnimation:animation];
+    if (batches)
+        [self endUpdates];
+}
+
+- (void)deleteGroupedItems:(NSArray *)items withRowAnimation:(UITableViewRowAnimation)animation
+{
+    BOOL batches = 1 < items.count;
+    if (batches)
+        [self beginUpdates];
+    for (id item in items)
+        [self deleteGroupedItem:item withRowAnimation:animation];
+    if (batches)
+        [self endUpdates];
+}
+
+- (void)regroupItems:(NSArray *)items withRowAnimation:(UITableViewRowAnimation)animation
+{
+    [self beginUpdates];
+    for (id item in items) {
+        DXTableViewRow *row = [self.groupedRowByItem objectForKey:item];
+        // items which keys haven't changed stay where they are
+        if (nil != row && [[self.groupedKeyByRow objectForKey:row] isEqualToString:[self groupingKeyForItem:item]])
+            continue;
+        [self deleteGroupedItem:item withRowAnimation:animation];
+        [self insertGroupedItem:item withRowAnimation:animation];
     }
-    return _mutableSections;
+    [self endUpdates];
 }
 
-- (NSArray *)sections
+- (DXTableViewRow *)rowForGroupedItem:(id)item
 {
-    return self.mutableSections.copy;
+    return [self.groupedRowByItem objectForKey:item];
 }
 
-- (DXTableViewRow *)rowAtIndexPath:(NSIndexPath *)indexPath
+// Section of the first non-empty group at or after the group of the title, or last section if there is none
+- (NSInteger)sectionIndexForGroupedSectionIndexTitleAtIndex:(NSInteger)index
 {
-    return [self.mutableSections[indexPath.section] rows][indexPath.row];
+    if (0 == self.groupSections.count)
+        return 0;
+    NSInteger collationIndex = [self.groupingCollation sectionForSectionIndexTitleAtIndex:index];
+    NSUInteger groupIndex = MIN([self groupIndexForCollationIndex:collationIndex], self.groupSections.count - 1);
+    return [self.groupSections[groupIndex] sectionIndex];
 }
 
-#pragma mark - Model building
+#pragma mark - Filtering
 
-- (void)addSection:(DXTableViewSection *)section
+// Larger changes of filtered rows reload table view, animating them would block main queue
+static const NSUInteger DXTableViewModelMaximumNumberOfAnimatedFilterChanges = 1000;
+
+// Number of rows filter operation evaluates between checks of cancellation
+static const NSUInteger DXTableViewModelFilterChunkSize = 256;
+
+- (NSOperationQueue *)filterQueue
 {
-    [self insertSection:section atIndex:self.mutableSections.count];
+    if (nil == _filterQueue) {
+        _filterQueue = [[NSOperationQueue alloc] init];
+        _filterQueue.maxConcurrentOperationCount = 1;
+        _filterQueue.name = @"DXTableViewModel.filter";
+    }
+    return _filterQueue;
 }
 
-- (void)insertSection:(DXTableViewSection *)section atIndex:(NSInteger)index
+- (BOOL (^)(NSDictionary *))filterMatchingBlockForQuery:(NSString *)query
 {
-    [self insertSections:@[section] atIndexes:[[NSIndexSet alloc] initWithIndex:index]];
+    BOOL (^filterBlock)(NSDictionary *, NSString *) = self.filterBlock;
+    if (nil != filterBlock) {
+        return ^BOOL (NSDictionary *boundData) {
+            return filterBlock(boundData, query);
+        };
+    }
+    NSPredicate *predicate = [self.filterPredicate predicateWithSubstitutionVariables:@{@"query": query}];
+    return ^BOOL (NSDictionary *boundData) {
+        return [predicate evaluateWithObject:boundData];
+    };
+}
+
+// Only rows are captured, their data is snapshotted every time they are evaluated
+- (void)captureRowsForFiltering
+{
+    NSMutableArray *sections = [NSMutableArray array];
+    NSMutableArray *rows = [NSMutableArray array];
+    for (DXTableViewSection *section in self.mutableSections) {
+        // paged sections keep inserting and replacing pages, which filtered rows would not allow
+        if (section.isVirtualized || section.isPaged)
+            continue;
+        [sections addObject:section];
+        [rows addObject:section.rows];
+    }
+    self.filteredSections = sections;
+    self.filteredRows = rows;
 }
 
-- (void)insertSections:(NSArray *)sections atIndexes:(NSIndexSet *)indexes
+// Data of rows is main queue state, so filter operation gets immutable copies taken before it's enqueued.
+// Rows keep their copies until their data changes, so snapshot of unchanged rows costs a lookup per row
+static NSArray *DXFilterDataOfRows(NSArray *rows, NSIndexSet *indexes)
 {
-    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"sectionName IN %@",
-                              [self.mutableSections valueForKey:@"sectionName"]];
-    NSArray *duplicates = [sections filteredArrayUsingPredicate:predicate];
-    if (duplicates.count > 0) {
-        NSString *fmt = @"\"%@\" section name is already exists in the model, but section name must be unique";
-        [NSException raise:NSInvalidArgumentException format:fmt, [duplicates[0] sectionName]];
+    NSMutableArray *data = [NSMutableArray arrayWithCapacity:indexes.count];
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        [data addObject:[rows[index] filterData]];
+    }];
+    return data;
+}
+
+- (void)filterRowsWithQuery:(NSString *)query
+{
+    if (nil == self.filterBlock && nil == self.filterPredicate)
+        [NSException raise:NSInternalInconsistencyException format:@"filterBlock or filterPredicate must be set to filter rows"];
+
+    [self.filterQueue cancelAllOperations];
+    NSUInteger token = ++_filterToken;
+    if (0 == query.length) {
+        self.filterQuery = nil;
+        [self showUnfilteredRows];
+        return;
     }
-    [sections makeObjectsPerformSelector:@selector(setTableViewModel:) withObject:self];
-    [sections makeObjectsPerformSelector:@selector(registerNibOrClassForRows)];
-    [self.mutableSections insertObjects:sections atIndexes:indexes];
+
+    self.filterQuery = query;
+    if (nil == self.filteredSections)
+        [self captureRowsForFiltering];
+    NSArray *rows = self.filteredRows;
+    // narrowed query can only hide rows, if filter says so, so only rows shown for the previous query are evaluated
+    NSArray *candidates = nil;
+    if (self.filterNarrowsWithQueryPrefix && nil != self.shownFilterQuery && [query hasPrefix:self.shownFilterQuery])
+        candidates = self.shownFilterIndexes;
+    NSMutableArray *candidateIndexes = [NSMutableArray arrayWithCapacity:rows.count];
+    NSMutableArray *candidateData = [NSMutableArray arrayWithCapacity:rows.count];
+    for (NSUInteger i = 0; i < rows.count; ++i) {
+        NSArray *sectionRows = rows[i];
+        NSIndexSet *indexes = nil != candidates ? candidates[i] :
+            [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, sectionRows.count)];
+        [candidateIndexes addObject:indexes];
+        [candidateData addObject:DXFilterDataOfRows(sectionRows, indexes)];
+    }
+    BOOL (^matches)(NSDictionary *) = [self filterMatchingBlockForQuery:query];
+
+    NSBlockOperation *operation = [[NSBlockOperation alloc] init];
+    __weak NSBlockOperation *weakOperation = operation;
+    __weak DXTableViewModel *weakSelf = self;
+    [operation addExecutionBlock:^{
+        NSMutableArray *result = [NSMutableArray arrayWithCapacity:candidateIndexes.count];
+        for (NSUInteger i = 0; i < candidateIndexes.count; ++i) {
+            NSIndexSet *sectionIndexes = candidateIndexes[i];
+            NSArray *sectionData = candidateData[i];
+            NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+            NSUInteger chunk[DXTableViewModelFilterChunkSize];
+            NSRange range = NSMakeRange(0, NSNotFound == sectionIndexes.lastIndex ? 0 : sectionIndexes.lastIndex + 1);
+            NSUInteger offset = 0;
+            NSUInteger count;
+            while (0 != (count = [sectionIndexes getIndexes:chunk maxCount:DXTableViewModelFilterChunkSize inIndexRange:&range])) {
+                // cancellation is checked once in a while as stale query may be replaced on every keystroke
+                if (weakOperation.isCancelled)
+                    return;
+                for (NSUInteger k = 0; k < count; ++k) {
+                    if (matches(sectionData[offset + k]))
+                        [indexes addIndex:chunk[k]];
+                }
+                offset += count;
+            }
+            [result addObject:indexes];
+        }
+        if (weakOperation.isCancelled)
+            return;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [weakSelf didFilterRowsWithQuery:query indexes:result token:token];
+        });
+    }];
+    [self.filterQueue addOperation:operation];
+}
+
+- (void)didFilterRowsWithQuery:(NSString *)query indexes:(NSArray *)indexes token:(NSUInteger)token
+{
+    // newer query was requested meanwhile
+    if (token != _filterToken)
+        return;
+    self.shownFilterQuery = query;
+    self.shownFilterIndexes = indexes;
+    [self showFilteredRowsAtIndexes:indexes];
+    if (nil != self.didFilterRowsBlock)
+        self.didFilterRowsBlock(self);
+}
+
+- (void)showUnfilteredRows
+{
+    if (nil == self.filteredSections)
+        return;
+    [self showFilteredRowsAtIndexes:nil];
+    self.filteredSections = nil;
+    self.filteredRows = nil;
+    self.shownFilterQuery = nil;
+    self.shownFilterIndexes = nil;
+    if (nil != self.didFilterRowsBlock)
+        self.didFilterRowsBlock(self);
+}
+
+// Index paths of positions of `indexes` which aren't in `otherIndexes`
+static NSArray *DXFilteredIndexPaths(NSIndexSet *indexes, NSIndexSet *otherIndexes, NSInteger sectionIndex)
+{
+    NSMutableArray *indexPaths = [NSMutableArray array];
+    __block NSInteger position = 0;
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        if (![otherIndexes containsIndex:index])
+            [indexPaths addObject:[NSIndexPath indexPathForRow:position inSection:sectionIndex]];
+        ++position;
+    }];
+    return indexPaths;
+}
+
+// Number of indexes of `indexes` which aren't in `otherIndexes`, counted by ranges
+static NSUInteger DXNumberOfFilteredIndexes(NSIndexSet *indexes, NSIndexSet *otherIndexes)
+{
+    __block NSUInteger res = 0;
+    [indexes enumerateRangesUsingBlock:^(NSRange range, BOOL *stop) {
+        res += range.length - [otherIndexes countOfIndexesInRange:range];
+    }];
+    return res;
 }
 
-- (void)removeSection:(DXTableViewSection *)section
+// Shows rows at `indexes`, an array of index sets per filtered section, or all rows if `indexes` is nil
+- (void)showFilteredRowsAtIndexes:(NSArray *)indexes
+{
+    NSMutableArray *changedSections = [NSMutableArray array];
+    NSMutableArray *oldIndexesBySection = [NSMutableArray array];
+    NSMutableArray *newIndexesBySection = [NSMutableArray array];
+    NSMutableIndexSet *sortedSectionIndexes = [NSMutableIndexSet indexSet];
+    __block NSUInteger numberOfChanges = 0;
+    [self.filteredSections enumerateObjectsUsingBlock:^(DXTableViewSection *section, NSUInteger i, BOOL *stop) {
+        if (![self containsSection:section])
+            return;
+        NSUInteger numberOfRows = nil != section.unfilteredRows ? section.unfilteredRows.count : section.numberOfRows;
+        NSIndexSet *allIndexes = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, numberOfRows)];
+        NSIndexSet *oldIndexes = nil != section.filteredRowIndexes ? section.filteredRowIndexes : allIndexes;
+        NSIndexSet *newIndexes = nil != indexes ? indexes[i] : allIndexes;
+        numberOfChanges += DXNumberOfFilteredIndexes(oldIndexes, newIndexes) + DXNumberOfFilteredIndexes(newIndexes, oldIndexes);
+        if (nil != indexes) {
+            [section filterRowsAtIndexes:newIndexes];
+        }
+        else if ([section removeRowFilter]) {
+            // rows were reordered as well, so section is reloaded rather than animated row by row
+            [sortedSectionIndexes addIndex:section.sectionIndex];
+            return;
+        }
+        [changedSections addObject:section];
+        [oldIndexesBySection addObject:oldIndexes];
+        [newIndexesBySection addObject:newIndexes];
+    }];
+
+    if (nil == _tableView || [self deferUpdateWithRowAnimation:UITableViewRowAnimationAutomatic])
+        return;
+    // index paths aren't built for changes that are too large to animate anyway
+    if (numberOfChanges > DXTableViewModelMaximumNumberOfAnimatedFilterChanges) {
+        [_tableView reloadData];
+        return;
+    }
+    NSMutableArray *deletedIndexPaths = [NSMutableArray arrayWithCapacity:numberOfChanges];
+    NSMutableArray *insertedIndexPaths = [NSMutableArray arrayWithCapacity:numberOfChanges];
+    [changedSections enumerateObjectsUsingBlock:^(DXTableViewSection *section, NSUInteger i, BOOL *stop) {
+        NSIndexSet *oldIndexes = oldIndexesBySection[i];
+        NSIndexSet *newIndexes = newIndexesBySection[i];
+        [deletedIndexPaths addObjectsFromArray:DXFilteredIndexPaths(oldIndexes, newIndexes, section.sectionIndex)];
+        [insertedIndexPaths addObjectsFromArray:DXFilteredIndexPaths(newIndexes, oldIndexes, section.sectionIndex)];
+    }];
+    [_tableView beginUpdates];
+    [_tableView deleteRowsAtIndexPaths:deletedIndexPaths withRowAnimation:UITableViewRowAnimationAutomatic];
+    [_tableView insertRowsAtIndexPaths:insertedIndexPaths withRowAnimation:UITableViewRowAnimationAutomatic];
+    if (0 < sortedSectionIndexes.count)
+        [_tableView reloadSections:sortedSectionIndexes withRowAnimation:UITableViewRowAnimationAutomatic];
+    [_tableView endUpdates];
+}
+
+static NSUInteger DXIndexAtPosition(NSIndexSet *indexes, NSUInteger position)
+{
+    __block NSUInteger remaining = position;
+    __block NSUInteger res = NSNotFound;
+    [indexes enumerateRangesUsingBlock:^(NSRange range, BOOL *stop) {
+        if (remaining < range.length) {
+            res = range.location + remaining;
+            *stop = YES;
+        }
+        else {
+            remaining -= range.length;
+        }
+    }];
+    return res;
+}
+
+- (NSIndexPath *)unfilteredIndexPathForIndexPath:(NSIndexPath *)indexPath
 {
-    [self.mutableSections removeObject:section];
+    NSIndexSet *indexes = [self.mutableSections[indexPath.section] filteredRowIndexes];
+    if (nil == indexes)
+        return indexPath;
+    return [NSIndexPath indexPathForRow:DXIndexAtPosition(indexes, indexPath.row) inSection:indexPath.section];
 }
 
-- (DXTableViewSection *)sectionWithName:(NSString *)name
+- (NSIndexPath *)indexPathForUnfilteredIndexPath:(NSIndexPath *)indexPath
 {
-    NSArray *sections = [self.sections filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"sectionName = %@", name]];
-    if (sections.count < 1)
-        [NSException raise:NSInvalidArgumentException format:@"section with name \"%@\" not found", name];
-    return sections[0];
+    NSIndexSet *indexes = [self.mutableSections[indexPath.section] filteredRowIndexes];
+    if (nil == indexes)
+        return indexPath;
+    if (![indexes containsIndex:indexPath.row])
+        return nil;
+    NSUInteger row = [indexes countOfIndexesInRange:NSMakeRange(0, indexPath.row)];
+    return [NSIndexPath indexPathForRow:row inSection:indexPath.section];
 }
 
-- (NSInteger)indexOfSectionWithName:(NSString *)name
+#pragma mark - Prefetching
+
+- (NSMutableOrderedSet *)rowsWaitingForPrefetch
 {
-    return [self.sections indexOfObject:[self sectionWithName:name]];
+    if (nil == _rowsWaitingForPrefetch) {
+        _rowsWaitingForPrefetch = [NSMutableOrderedSet orderedSet];
+    }
+    return _rowsWaitingForPrefetch;
 }
 
-- (NSInteger)insertSection:(DXTableViewSection *)newSection afterSectionWithName:(NSString *)name
+- (NSMutableSet *)prefetchingRows
 {
-    NSInteger index = [self indexOfSectionWithName:name];
-    [self insertSection:newSection atIndex:++index];
-    return index;
+    if (nil == _prefetchingRows) {
+        _prefetchingRows = [NSMutableSet set];
+    }
+    return _prefetchingRows;
 }
 
-- (NSInteger)insertSection:(DXTableViewSection *)newSection beforeSectionWithName:(NSString *)name
+- (void (^)(DXTableViewRow *, void (^)(NSDictionary *)))prefetchBlockForRow:(DXTableViewRow *)row
 {
-    NSInteger index = [self indexOfSectionWithName:name];
-    [self insertSection:newSection atIndex:index];
-    return index;
+    return nil != row.prefetchBlock ? row.prefetchBlock : row.section.prefetchRowBlock;
 }
 
-- (NSInteger)deleteSectionWithName:(NSString *)name
+- (void)prefetchRow:(DXTableViewRow *)row urgently:(BOOL)urgently
 {
-    NSInteger index = [self indexOfSectionWithName:name];
-    [self removeSection:[self sectionWithName:name]];
-    return index;
+    if (DXTableViewRowPrefetchStatePending == row.prefetchState && urgently) {
+        [self.rowsWaitingForPrefetch removeObject:row];
+        [self.rowsWaitingForPrefetch insertObject:row atIndex:0];
+        return;
+    }
+    if (DXTableViewRowPrefetchStateNone != row.prefetchState || nil == [self prefetchBlockForRow:row])
+        return;
+
+    row.prefetchState = DXTableViewRowPrefetchStatePending;
+    if (urgently)
+        [self.rowsWaitingForPrefetch insertObject:row atIndex:0];
+    else
+        [self.rowsWaitingForPrefetch addObject:row];
+}
+
+- (void)startWaitingPrefetches
+{
+    NSUInteger maximumNumberOfPrefetches = MAX(_maximumNumberOfConcurrentPrefetches, 1);
+    while (self.prefetchingRows.count < maximumNumberOfPrefetches && self.rowsWaitingForPrefetch.count > 0) {
+        DXTableViewRow *row = self.rowsWaitingForPrefetch.firstObject;
+        [self.rowsWaitingForPrefetch removeObjectAtIndex:0];
+        row.prefetchState = DXTableViewRowPrefetchStateLoading;
+        [self.prefetchingRows addObject:row];
+
+        NSUInteger token = ++row.prefetchToken;
+        __weak DXTableViewModel *weakSelf = self;
+        __weak DXTableViewRow *weakRow = row;
+        [self prefetchBlockForRow:row](row, ^(NSDictionary *prefetchedData) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [weakSelf didPrefetchData:prefetchedData forRow:weakRow token:token];
+            });
+        });
+    }
 }
 
-- (NSIndexSet *)moveSectionWithName:(NSString *)name toSectionWithName:(NSString *)destinationName
+- (void)didPrefetchData:(NSDictionary *)prefetchedData forRow:(DXTableViewRow *)row token:(NSUInteger)token
 {
-    NSInteger index = [self indexOfSectionWithName:name];
-    NSInteger destinationIndex = [self indexOfSectionWithName:destinationName];
+    if (nil == row || token != row.prefetchToken || DXTableViewRowPrefetchStateLoading != row.prefetchState)
+        return;
 
-    DXTableViewSection *section = [self sectionWithName:name];
-    [self.mutableSections removeObject:section];
-    [self.mutableSections insertObject:section atIndex:destinationIndex];
+    [self.prefetchingRows removeObject:row];
+    row.prefetchState = DXTableViewRowPrefetchStateDone;
+    row.prefetchedKeyPaths = prefetchedData.allKeys;
+    [prefetchedData enumerateKeysAndObjectsUsingBlock:^(NSString *key, id value, BOOL *stop) {
+        [row setBoundValue:value forKeyPath:key];
+    }];
 
-    NSMutableIndexSet *indexes = [[NSMutableIndexSet alloc] initWithIndex:index];
-    [indexes addIndex:destinationIndex];
-    return indexes.copy;
+    // data came too late for cellForRowAtIndexPath:, cell of visible row is configured once again
+    if (row.tableViewModel == self && [_tableView.indexPathsForVisibleRows containsObject:row.rowIndexPath])
+        [row configureCell];
+    [self startWaitingPrefetches];
 }
 
-#pragma mark - Model building convenience methods
+- (void)cancelPrefetchForRow:(DXTableViewRow *)row
+{
+    if (DXTableViewRowPrefetchStatePending == row.prefetchState) {
+        [self.rowsWaitingForPrefetch removeObject:row];
+        row.prefetchState = DXTableViewRowPrefetchStateNone;
+    }
+    else if (DXTableViewRowPrefetchStateLoading == row.prefetchState) {
+        [self.prefetchingRows removeObject:row];
+        ++row.prefetchToken;
+        row.prefetchState = DXTableViewRowPrefetchStateNone;
+        void (^cancelPrefetchBlock)(DXTableViewRow *) = nil != row.cancelPrefetchBlock ?
+            row.cancelPrefetchBlock : row.section.cancelPrefetchRowBlock;
+        if (nil != cancelPrefetchBlock)
+            cancelPrefetchBlock(row);
+    }
+}
 
-- (void)addSections:(NSArray *)sections
+// Detached rows are bound to other objects afterwards, so nothing prefetched for the previous object may survive
+- (void)discardPrefetchForRow:(DXTableViewRow *)row
 {
-    for (DXTableViewSection *section in sections)
-        [self addSection:section];
+    [self cancelPrefetchForRow:row];
+    ++row.prefetchToken;
+    row.prefetchState = DXTableViewRowPrefetchStateNone;
+    if (nil != row.prefetchedKeyPaths)
+        [row.boundObjectData removeObjectsForKeys:row.prefetchedKeyPaths];
+    row.prefetchedKeyPaths = nil;
+    [row didChangeBoundData];
 }
 
-#pragma mark - respondsToSelector hacks
+// Rows that were not prefetched in time start loading before any prefetch that is still waiting
+- (void)prefetchDisplayedRowIfNeeded:(DXTableViewRow *)row
+{
+    if (DXTableViewRowPrefetchStateDone == row.prefetchState || DXTableViewRowPrefetchStateLoading == row.prefetchState)
+        return;
+    if (nil == [self prefetchBlockForRow:row])
+        return;
+    [self prefetchRow:row urgently:YES];
+    [self startWaitingPrefetches];
+}
 
-- (BOOL)respondsToSelector:(SEL)aSelector
+#pragma mark - Content preparation
+
+- (NSOperationQueue *)contentPreparationQueue
 {
-    BOOL res = [super respondsToSelector:aSelector];
-    NSString *selectorName = NSStringFromSelector(aSelector);
-    if ([selectorName isEqualToString:@"tableView:titleForDeleteConfirmationButtonForRowAtIndexPath:"] &&
-        _showsDefaultTitleForDeleteConfirmationButton)
-        res = NO;
+    if (nil == _contentPreparationQueue) {
+        _contentPreparationQueue = [[NSOperationQueue alloc] init];
+        _contentPreparationQueue.name = @"DXTableViewModel.contentPreparationQueue";
+    }
+    return _contentPreparationQueue;
+}
+
+- (NSHashTable *)rowsBeingPrepared
+{
+    if (nil == _rowsBeingPrepared) {
+        _rowsBeingPrepared = [NSHashTable weakObjectsHashTable];
+    }
+    return _rowsBeingPrepared;
+}
 
-    if ([selectorName isEqualToString:@"tableView:sectionForSectionIndexTitle:atIndex:"] &&
-        nil == self.sectionForSectionIndexTitleAtIndexBlock)
-        res = NO;
+- (void)prepareContentForRowInBackground:(DXTableViewRow *)row
+{
+    if (nil == row.prepareContentBlock || [row hasPreparedContent] || [self.rowsBeingPrepared containsObject:row])
+        return;
+    [self.rowsBeingPrepared addObject:row];
 
-    return res;
+    id (^block)(NSDictionary *) = row.prepareContentBlock;
+    NSDictionary *boundData = [row.boundObjectData copy];
+    NSUInteger token = row.preparedContentToken;
+    __weak DXTableViewRow *weakRow = row;
+    __weak DXTableViewModel *weakSelf = self;
+    [self.contentPreparationQueue addOperationWithBlock:^{
+        id content = block(boundData);
+        dispatch_async(dispatch_get_main_queue(), ^{
+            DXTableViewRow *preparedRow = weakRow;
+            if (nil == preparedRow)
+                return;
+            [weakSelf.rowsBeingPrepared removeObject:preparedRow];
+            // bound data or the block did change meanwhile, or content was prepared synchronously
+            if (token == preparedRow.preparedContentToken && block == preparedRow.prepareContentBlock &&
+                ![preparedRow hasPreparedContent])
+                [preparedRow setPreparedContent:content preparedWithBlock:block];
+        });
+    }];
 }
 
-#pragma mark - Animated sections manipulations
+#pragma mark - Image cache
 
-- (void)beginUpdates
+- (DXTableViewModelImageCache *)imageCache
 {
-    [self.tableView beginUpdates];
+    if (nil == _imageCache) {
+        _imageCache = [[DXTableViewModelImageCache alloc] init];
+    }
+    return _imageCache;
 }
 
-- (void)endUpdates
+- (NSUInteger)imageCacheByteBudget
 {
-    [self.tableView endUpdates];
+    return self.imageCache.byteBudget;
 }
 
-- (void)insertSections:(NSArray *)newSections
-  afterSectionWithName:(NSString *)name
-      withRowAnimation:(UITableViewRowAnimation)animation
+- (void)setImageCacheByteBudget:(NSUInteger)imageCacheByteBudget
 {
-    NSMutableIndexSet *indexes = [[NSMutableIndexSet alloc] init];
-    for (DXTableViewSection *newSection in newSections) {
-        NSInteger index = [self insertSection:newSection afterSectionWithName:name];
-        [indexes addIndex:index];
-    }
-    [self.tableView insertSections:indexes withRowAnimation:animation];
+    self.imageCache.byteBudget = imageCacheByteBudget;
 }
 
-- (void)insertSections:(NSArray *)newSections
- beforeSectionWithName:(NSString *)name
-      withRowAnimation:(UITableViewRowAnimation)animation
+- (void)removeAllCachedImages
 {
-    NSMutableIndexSet *indexes = [[NSMutableIndexSet alloc] init];
-    for (DXTableViewSection *newSection in newSections) {
-        NSInteger index = [self insertSection:newSection beforeSectionWithName:name];
-        [indexes addIndex:index];
-    }
-    [self.tableView insertSections:indexes withRowAnimation:animation];
+    [_imageCache removeAllImages];
 }
 
-- (void)deleteSectionsWithNames:(NSArray *)names withRowAnimation:(UITableViewRowAnimation)animation
+- (void)loadCellImageForRow:(DXTableViewRow *)row
 {
-    NSMutableIndexSet *indexes = [[NSMutableIndexSet alloc] init];
-    for (NSString *name in names) {
-        NSInteger index = [self deleteSectionWithName:name];
-        [indexes addIndex:index];
+    NSString *key = row.cellImageKey;
+    CGSize size = row.cellImageSize;
+    DXTableViewModelImageCacheKey *cacheKey = row.cellImageCacheKey;
+    if (![cacheKey isKey:key ofSize:size]) {
+        cacheKey = [[DXTableViewModelImageCacheKey alloc] initWithKey:key size:size];
+        row.cellImageCacheKey = cacheKey;
+    }
+
+    UIImage *image = [self.imageCache imageForKey:cacheKey];
+    // reused cell must not show image of the row it displayed before until the image is loaded
+    [row.cell imageView].image = nil != image ? image : row.cellImage;
+    if (nil != image)
+        return;
+
+    UIImage *(^loader)(NSString *) = row.cellImageLoader;
+    CGFloat scale = [UIScreen mainScreen].scale;
+    __weak DXTableViewRow *weakRow = row;
+    __weak DXTableViewModel *weakSelf = self;
+    [self.imageCache loadImageForKey:cacheKey usingBlock:^UIImage *{
+        UIImage *loadedImage = loader(key);
+        return nil != loadedImage ? DXDecodedImage(loadedImage, size, scale) : nil;
+    } completion:^(UIImage *loadedImage) {
+        DXTableViewRow *loadedRow = weakRow;
+        DXTableViewModel *strongSelf = weakSelf;
+        if (nil == loadedImage || nil == loadedRow || loadedRow.tableViewModel != strongSelf ||
+            ![loadedRow.cellImageKey isEqualToString:key])
+            return;
+        // cell could be reused for another row meanwhile
+        if ([strongSelf.tableView.indexPathsForVisibleRows containsObject:loadedRow.rowIndexPath]) {
+            UITableViewCell *cell = loadedRow.cell;
+            cell.imageView.image = loadedImage;
+            [cell setNeedsLayout];
+        }
+    }];
+}
+
+#pragma mark - Instrumentation
+
+- (BOOL)isInstrumentationEnabled
+{
+    return nil != _instrumentation;
+}
+
+- (void)setInstrumentationEnabled:(BOOL)instrumentationEnabled
+{
+    if (instrumentationEnabled == self.isInstrumentationEnabled)
+        return;
+
+    if (instrumentationEnabled) {
+        self.instrumentation = [[DXTableViewModelInstrumentation alloc] init];
+        self.instrumentation.tableViewModel = self;
+        self.instrumentingProxy = [DXTableViewModelInstrumentingProxy alloc];
+        self.instrumentingProxy.tableViewModel = self;
+        self.instrumentingProxy.instrumentation = self.instrumentation;
     }
-    [self.tableView deleteSections:indexes withRowAnimation:animation];
+    else {
+        self.instrumentation = nil;
+        self.instrumentingProxy = nil;
+    }
+    [self connectTableView];
 }
 
-- (void)moveSectionWithName:(NSString *)name animatedToSectionWithName:(NSString *)otherName
+- (NSDictionary *)instrumentationStatistics
 {
-    NSIndexSet *indexes = [self moveSectionWithName:name toSectionWithName:otherName];
-    [self.tableView moveSection:indexes.firstIndex toSection:indexes.lastIndex];
+    return [self.instrumentation statistics];
 }
 
-- (void)reloadSectionsWithNames:(NSArray *)names withRowAnimation:(UITableViewRowAnimation)animation
+- (void)resetInstrumentationStatistics
 {
-    NSMutableIndexSet *indices = [[NSMutableIndexSet alloc] init];
-    for (NSString *name in names) {
-        DXTableViewSection *section = [self sectionWithName:name];
-        [indices addIndex:section.sectionIndex];
-    }
-    [self.tableView reloadSections:indices withRowAnimation:animation];
+    [self.instrumentation reset];
 }
 
 #pragma mark - Data binding
 
 - (void)reloadRowBoundData
 {
-    for (DXTableViewSection *section in self.sections)
-        [section.rows makeObjectsPerformSelector:@selector(reloadBoundData)];
+    for (DXTableViewSection *section in self.mutableSections)
+        [section.existingRows makeObjectsPerformSelector:@selector(reloadBoundData)];
 }
 
 - (void)updateRowObjects
 {
-    for (DXTableViewSection *section in self.sections)
-        [section.rows makeObjectsPerformSelector:@selector(updateObject)];
+    [self updateRowObjectsReturningWrittenKeyPaths];
+}
+
+- (NSMapTable *)updateRowObjectsReturningWrittenKeyPaths
+{
+    NSArray *rows = _rowsWithModifiedBoundData.array.copy;
+    [_rowsWithModifiedBoundData removeAllObjects];
+
+    NSMapTable *writtenKeyPathsByRow = [NSMapTable strongToStrongObjectsMapTable];
+    for (DXTableViewRow *row in rows) {
+        // removed rows are not written, as before
+        if (row.tableViewModel != self)
+            continue;
+        NSSet *writtenKeyPaths = [row updateObjectReturningWrittenKeyPaths];
+        if (writtenKeyPaths.count > 0)
+            [writtenKeyPathsByRow setObject:writtenKeyPaths forKey:row];
+    }
+    return writtenKeyPathsByRow;
+}
+
+- (NSMutableOrderedSet *)rowsWithModifiedBoundData
+{
+    if (nil == _rowsWithModifiedBoundData) {
+        _rowsWithModifiedBoundData = [NSMutableOrderedSet orderedSet];
+    }
+    return _rowsWithModifiedBoundData;
+}
+
+- (void)rowDidModifyBoundData:(DXTableViewRow *)row
+{
+    [self.rowsWithModifiedBoundData addObject:row];
+}
+
+- (NSMutableOrderedSet *)rowsWithChangedBoundData
+{
+    if (nil == _rowsWithChangedBoundData) {
+        _rowsWithChangedBoundData = [NSMutableOrderedSet orderedSet];
+    }
+    return _rowsWithChangedBoundData;
+}
+
+- (void)setNeedsReloadChangedBoundDataForRow:(DXTableViewRow *)row
+{
+    [self.rowsWithChangedBoundData addObject:row];
+    if (_changedBoundDataReloadScheduled)
+        return;
+    _changedBoundDataReloadScheduled = YES;
+    __weak DXTableViewModel *weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [weakSelf reloadChangedBoundData];
+    });
+}
+
+- (void)reloadChangedBoundData
+{
+    _changedBoundDataReloadScheduled = NO;
+    NSArray *rows = self.rowsWithChangedBoundData.array;
+    [self.rowsWithChangedBoundData removeAllObjects];
+
+    NSSet *visibleIndexPaths = [NSSet setWithArray:_tableView.indexPathsForVisibleRows];
+    NSMutableArray *indexPaths = [NSMutableArray array];
+    NSMutableArray *visibleRows = [NSMutableArray array];
+    for (DXTableViewRow *row in rows) {
+        if (row.tableViewModel != self || ![row reloadChangedBoundData])
+            continue;
+        NSIndexPath *indexPath = row.rowIndexPath;
+        if ([visibleIndexPaths containsObject:indexPath]) {
+            [indexPaths addObject:indexPath];
+            [visibleRows addObject:row];
+        }
+    }
+    if (self.isUpdating)
+        [self reloadRowsOnEndUpdates:visibleRows];
+    else if (indexPaths.count > 0)
+        [_tableView reloadRowsAtIndexPaths:indexPaths withRowAnimation:UITableViewRowAnimationNone];
 }
 
 #pragma mark - UITableViewDataSource
@@ -298,14 +3379,51 @@
 
 - (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath
 {
-    UITableViewCell *res;
+    // table view doesn't ask for uniform heights, so changes of template rows are noticed by displayed rows too
+    if (_rowTemplateGeneration != [DXTableViewRow templateGeneration])
+        [self setNeedsCheckRowTemplates];
     __weak DXTableViewRow *row = [self rowAtIndexPath:indexPath];
+    if (nil != _instrumentation)
+        return [self instrumentedCellForRow:row atIndexPath:indexPath];
+
+    UITableViewCell *res;
     if (nil != row.cellForRowBlock)
         res = row.cellForRowBlock(row);
     if (nil == res)
         res = [self.tableView dequeueReusableCellWithIdentifier:row.cellReuseIdentifier forIndexPath:indexPath];
     row.cell = res;
+    [self prefetchDisplayedRowIfNeeded:row];
+    [row configureCell];
+    return res;
+}
+
+// Steps of tableView:cellForRowAtIndexPath: timed and counted, kept apart so that disabled instrumentation costs one check
+- (UITableViewCell *)instrumentedCellForRow:(DXTableViewRow *)row atIndexPath:(NSIndexPath *)indexPath
+{
+    UITableViewCell *res;
+    NSString *reuseIdentifier = row.cellReuseIdentifier;
+    uint64_t startTime;
+    if (nil != row.cellForRowBlock) {
+        startTime = mach_absolute_time();
+        res = row.cellForRowBlock(row);
+        [_instrumentation recordBlockEvent:@"cellForRowBlock" reuseIdentifier:reuseIdentifier startTime:startTime];
+    }
+    if (nil == res) {
+        startTime = mach_absolute_time();
+        res = [self.tableView dequeueReusableCellWithIdentifier:reuseIdentifier forIndexPath:indexPath];
+        [_instrumentation countEvent:@"dequeue"];
+        [_instrumentation recordEvent:@"dequeueReusableCell" reuseIdentifier:reuseIdentifier startTime:startTime];
+    }
+    row.cell = res;
+    if (nil != [self prefetchBlockForRow:row])
+        [_instrumentation countEvent:DXTableViewRowPrefetchStateDone == row.prefetchState ? @"prefetchHit" : @"prefetchMiss"];
+    [self prefetchDisplayedRowIfNeeded:row];
+    startTime = mach_absolute_time();
     [row configureCell];
+    [_instrumentation countEvent:@"configure"];
+    if (nil != row.configureCellBlock)
+        [_instrumentation countEvent:@"blockInvocation"];
+    [_instrumentation recordEvent:@"configureCell" reuseIdentifier:reuseIdentifier startTime:startTime];
     return res;
 }
 
@@ -329,7 +3447,9 @@
 // Allows the reorder accessory view to optionally be shown for a particular row. By default, the reorder control will be shown only if the datasource implements -tableView:moveRowAtIndexPath:toIndexPath:
 - (BOOL)tableView:(UITableView *)tableView canMoveRowAtIndexPath:(NSIndexPath *)indexPath
 {
-    return [[self rowAtIndexPath:indexPath] canMoveRow];
+    // rows of sorted section keep their sorted positions
+    DXTableViewRow *row = [self rowAtIndexPath:indexPath];
+    return row.canMoveRow && ![row.section sortsRows];
 }
 
 // Index
@@ -339,14 +3459,18 @@
     NSArray *res;
     if (nil != self.sectionIndexTitlesBlock)
         res = self.sectionIndexTitlesBlock();
+    else
+        res = self.groupedSectionIndexTitles;
     return res;
 }
 
 - (NSInteger)tableView:(UITableView *)tableView sectionForSectionIndexTitle:(NSString *)title atIndex:(NSInteger)index
 {
-    // This method shouldn't be called unless sectionForSectionIndexTitleAtIndexBlock is not nil.
+    // This method shouldn't be called unless sectionForSectionIndexTitleAtIndexBlock is not nil or items are grouped.
     // See respondsToSelector: for details
-    return self.sectionForSectionIndexTitleAtIndexBlock(title, index);
+    if (nil != self.sectionForSectionIndexTitleAtIndexBlock)
+        return self.sectionForSectionIndexTitleAtIndexBlock(title, index);
+    return [self sectionIndexForGroupedSectionIndexTitleAtIndex:index];
 }
 
 // Data manipulation - insert and delete support
@@ -366,12 +3490,37 @@
     DXTableViewRow *row = [self rowAtIndexPath:sourceIndexPath];
     DXTableViewSection *sourceSection = row.section;
     DXTableViewSection *destinationSection = self.mutableSections[destinationIndexPath.section];
+    if ([sourceSection sortsRows] || [destinationSection sortsRows])
+        [NSException raise:NSInternalInconsistencyException format:@"rows of sorted sections cannot be reordered"];
     [sourceSection removeRow:row];
     [destinationSection insertRow:row atIndex:destinationIndexPath.row];
     if (nil != self.moveRowToIndexPathBlock)
         self.moveRowToIndexPathBlock(row, destinationIndexPath);
 }
 
+#pragma mark - UITableViewDataSourcePrefetching
+
+- (void)tableView:(UITableView *)tableView prefetchRowsAtIndexPaths:(NSArray *)indexPaths
+{
+    for (NSIndexPath *indexPath in indexPaths) {
+        DXTableViewRow *row = [self rowAtIndexPath:indexPath];
+        [self prefetchRow:row urgently:NO];
+        [self prepareContentForRowInBackground:row];
+        [self.mutableSections[indexPath.section] loadPagesNearRowAtIndex:indexPath.row];
+    }
+    [self startWaitingPrefetches];
+}
+
+- (void)tableView:(UITableView *)tableView cancelPrefetchingForRowsAtIndexPaths:(NSArray *)indexPaths
+{
+    for (NSIndexPath *indexPath in indexPaths) {
+        DXTableViewRow *row = [self existingRowAtIndexPath:indexPath];
+        if (nil != row)
+            [self cancelPrefetchForRow:row];
+    }
+    [self startWaitingPrefetches];
+}
+
 #pragma mark - UITableViewDelegate
 
 // Display customization
@@ -379,22 +3528,34 @@
 - (void)tableView:(UITableView *)tableView willDisplayCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath
 {
     __weak DXTableViewRow *row = [self rowAtIndexPath:indexPath];
-    if (nil != row.willDisplayCellBlock)
+    if (nil != row.willDisplayCellBlock) {
+        uint64_t startTime = DXInstrumentationStartTime(_instrumentation);
         row.willDisplayCellBlock(row, cell);
+        [_instrumentation recordBlockEvent:@"willDisplayCellBlock" reuseIdentifier:row.cellReuseIdentifier startTime:startTime];
+    }
+    [self.mutableSections[indexPath.section] loadPagesNearRowAtIndex:indexPath.row];
 }
 
 - (void)tableView:(UITableView *)tableView willDisplayHeaderView:(UIView *)view forSection:(NSInteger)section
 {
     __weak DXTableViewSection *sectionObject = self.mutableSections[section];
-    if (nil != sectionObject.willDisplayHeaderViewBlock)
+    if (nil != sectionObject.willDisplayHeaderViewBlock) {
+        uint64_t startTime = DXInstrumentationStartTime(_instrumentation);
         sectionObject.willDisplayHeaderViewBlock(sectionObject, view);
+        [_instrumentation recordBlockEvent:@"willDisplayHeaderViewBlock" reuseIdentifier:sectionObject.headerReuseIdentifier
+                                 startTime:startTime];
+    }
 }
 
 - (void)tableView:(UITableView *)tableView willDisplayFooterView:(UIView *)view forSection:(NSInteger)section
 {
     __weak DXTableViewSection *sectionObject = self.mutableSections[section];
-    if (nil != sectionObject.willDisplayFooterViewBlock)
+    if (nil != sectionObject.willDisplayFooterViewBlock) {
+        uint64_t startTime = DXInstrumentationStartTime(_instrumentation);
         sectionObject.willDisplayFooterViewBlock(sectionObject, view);
+        [_instrumentation recordBlockEvent:@"willDisplayFooterViewBlock" reuseIdentifier:sectionObject.footerReuseIdentifier
+                                 startTime:startTime];
+    }
 }
 
 - (void)tableView:(UITableView *)tableView didEndDisplayingCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath*)indexPath
@@ -419,12 +3580,18 @@
 
 - (CGFloat)tableView:(UITableView *)tableView heightForRowAtIndexPath:(NSIndexPath *)indexPath
 {
-    CGFloat res = UITableViewAutomaticDimension;
-    __weak DXTableViewRow *row = [self rowAtIndexPath:indexPath];
-    if (row.rowHeightBlock)
-        res = row.rowHeightBlock(row);
-    else
-        res = row.rowHeight;
+    return [self heightForRow:[self rowAtIndexPath:indexPath]];
+}
+
+- (CGFloat)tableView:(UITableView *)tableView estimatedHeightForRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    // rows of virtualized sections are not materialized only to estimate their heights
+    DXTableViewRow *row = [self.mutableSections[indexPath.section] existingRowAtIndex:indexPath.row];
+    if (nil == row)
+        return [self defaultRowHeight];
+    CGFloat res = [self estimatedHeightForRow:row];
+    if (UITableViewAutomaticDimension == res)
+        res = [self heightForRow:row];
     return res;
 }
 
@@ -442,8 +3609,11 @@
 
 - (UIView *)tableView:(UITableView *)tableView viewForHeaderInSection:(NSInteger)section
 {
-    UIView *header;
     DXTableViewSection *sectionObject = self.mutableSections[section];
+    if (nil != _instrumentation)
+        return [self instrumentedHeaderViewOfSection:sectionObject];
+
+    UIView *header;
     if (nil != sectionObject.viewForHeaderInSectionBlock)
         header = sectionObject.viewForHeaderInSectionBlock(sectionObject);
     else if (sectionObject.headerReuseIdentifier)
@@ -455,10 +3625,35 @@
     return header;
 }
 
+- (UIView *)instrumentedHeaderViewOfSection:(DXTableViewSection *)sectionObject
+{
+    UIView *header;
+    NSString *reuseIdentifier = sectionObject.headerReuseIdentifier;
+    uint64_t startTime;
+    if (nil != sectionObject.viewForHeaderInSectionBlock) {
+        startTime = mach_absolute_time();
+        header = sectionObject.viewForHeaderInSectionBlock(sectionObject);
+        [_instrumentation recordBlockEvent:@"viewForHeaderInSectionBlock" reuseIdentifier:reuseIdentifier startTime:startTime];
+    }
+    else if (reuseIdentifier)
+        header = [self.tableView dequeueReusableHeaderFooterViewWithIdentifier:reuseIdentifier];
+    sectionObject.headerView = header;
+    [sectionObject configureHeader];
+    if (nil != sectionObject.configureHeaderBlock) {
+        startTime = mach_absolute_time();
+        sectionObject.configureHeaderBlock(sectionObject, header);
+        [_instrumentation recordBlockEvent:@"configureHeaderBlock" reuseIdentifier:reuseIdentifier startTime:startTime];
+    }
+    return header;
+}
+
 - (UIView *)tableView:(UITableView *)tableView viewForFooterInSection:(NSInteger)section
 {
-    UIView *footer;
     DXTableViewSection *sectionObject = self.mutableSections[section];
+    if (nil != _instrumentation)
+        return [self instrumentedFooterViewOfSection:sectionObject];
+
+    UIView *footer;
     if (nil != sectionObject.viewForFooterInSectionBlock)
         footer = sectionObject.viewForFooterInSectionBlock(sectionObject);
     else if (sectionObject.footerReuseIdentifier)
@@ -470,6 +3665,28 @@
     return footer;
 }
 
+- (UIView *)instrumentedFooterViewOfSection:(DXTableViewSection *)sectionObject
+{
+    UIView *footer;
+    NSString *reuseIdentifier = sectionObject.footerReuseIdentifier;
+    uint64_t startTime;
+    if (nil != sectionObject.viewForFooterInSectionBlock) {
+        startTime = mach_absolute_time();
+        footer = sectionObject.viewForFooterInSectionBlock(sectionObject);
+        [_instrumentation recordBlockEvent:@"viewForFooterInSectionBlock" reuseIdentifier:reuseIdentifier startTime:startTime];
+    }
+    else if (reuseIdentifier)
+        footer = [self.tableView dequeueReusableHeaderFooterViewWithIdentifier:reuseIdentifier];
+    sectionObject.footerView = footer;
+    [sectionObject configureFooter];
+    if (nil != sectionObject.configureFooterBlock) {
+        startTime = mach_absolute_time();
+        sectionObject.configureFooterBlock(sectionObject, footer);
+        [_instrumentation recordBlockEvent:@"configureFooterBlock" reuseIdentifier:reuseIdentifier startTime:startTime];
+    }
+    return footer;
+}
+
 // Accessories (disclosures).
 
 - (void)tableView:(UITableView *)tableView accessoryButtonTappedForRowWithIndexPath:(NSIndexPath *)indexPath
@@ -519,8 +3736,11 @@
 - (void)tableView:(UITableView *)tableView didSelectRowAtIndexPath:(NSIndexPath *)indexPath
 {
     __weak DXTableViewRow *row = [self rowAtIndexPath:indexPath];
-    if (nil != row.didSelectRowBlock)
+    if (nil != row.didSelectRowBlock) {
+        uint64_t startTime = DXInstrumentationStartTime(_instrumentation);
         row.didSelectRowBlock(row);
+        [_instrumentation recordBlockEvent:@"didSelectRowBlock" reuseIdentifier:row.cellReuseIdentifier startTime:startTime];
+    }
 
     if (row.shouldDeselectRow)
         [tableView deselectRowAtIndexPath:indexPath animated:YES];
@@ -571,6 +3791,9 @@
     if (nil != self.targetIndexPathForMoveFromRowToProposedIndexPath)
         proposedDestinationIndexPath = self.targetIndexPathForMoveFromRowToProposedIndexPath([self rowAtIndexPath:sourceIndexPath],
                                                                                              proposedDestinationIndexPath);
+    // row dropped into sorted section would not stay where it's dropped
+    if ([self.mutableSections[proposedDestinationIndexPath.section] sortsRows])
+        return sourceIndexPath;
     return proposedDestinationIndexPath;
 }
 
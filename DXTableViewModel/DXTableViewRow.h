@@ -85,6 +85,41 @@
  */
 @property (copy, nonatomic) CGFloat (^rowHeightBlock)(DXTableViewRow *row);
 
+/**
+ Estimated height to be used for row represented by the receiver on table view delegate method
+ `tableView:estimatedHeightForRowAtIndexPath:`. Default is UITableViewAutomaticDimension, which means that estimate
+ is not provided: `rowHeight` is used if `rowHeightBlock` is `nil`, otherwise actual height is measured.
+
+ Providing estimates lets table view ask for actual heights only for rows that are about to be displayed.
+
+ @see estimatedRowHeightBlock
+ */
+@property (nonatomic) CGFloat estimatedRowHeight;
+
+/**
+ Block object to be invoked on table view delegate method `tableView:estimatedHeightForRowAtIndexPath:`
+ for retrieving estimated height for row represented by the receiver. Takes one parameter: row object
+ (the receiver is passed as `row` parameter) and returns float value of estimated row height. Should be cheaper
+ than `rowHeightBlock`. If not `nil` `estimatedRowHeight` property will be ignored. Default is `nil`.
+
+ @see estimatedRowHeight
+ */
+@property (copy, nonatomic) CGFloat (^estimatedRowHeightBlock)(DXTableViewRow *row);
+
+/**
+ Block object that measures height of row represented by the receiver on a background queue. Takes two parameters:
+ `boundData` - copy of the receiver's bound data (values accessible via subscript) and `width` - available width
+ of table view, returns float value of row height. Default is `nil`.
+
+ The block must depend only on given parameters and must not touch views, the receiver or any other object that is
+ not thread safe. If not `nil` `rowHeightBlock` property will be ignored: table view model measures rows on background
+ queue starting from visible rows, rows that were not measured yet use estimated height.
+
+ @see estimatedRowHeight
+ @see [DXTableViewModel precomputeRowHeights]
+ */
+@property (copy, nonatomic) CGFloat (^rowHeightForWidthBlock)(NSDictionary *boundData, CGFloat width);
+
 /**
  Boolean value that indicates if the row represented by the receiver should be highlighted. Default is NO.
  */
@@ -152,6 +187,15 @@
  */
 @property (strong, nonatomic, readonly) NSIndexPath *rowIndexPath;
 
+/**
+ Object that identifies row represented by the receiver across snapshots applied with
+ `[DXTableViewModel applySnapshot:animated:]`. Default is `nil`, in this case the receiver itself identifies the row.
+
+ Rows from different snapshots with equal identifiers are treated as the same row in table view: the row is kept
+ or moved, and reloaded if row objects differ.
+ */
+@property (copy, nonatomic) id <NSCopying> rowIdentifier;
+
 /**
  Block object to be invoked on table view delegate method `tableView:didHighlightRowAtIndexPath:`
  which tells that the table view did highlight represented by the receiver row. Takes one parameter: row object
@@ -239,6 +283,31 @@
  */
 @property (copy, nonatomic) void (^configureCellBlock)(DXTableViewRow *row, id cell);
 
+/**
+ Block object that prepares content to be displayed in cell from the receiver's bound data. Takes one parameter:
+ `boundData` - copy of the receiver's bound data (values accessible via subscript), and returns immutable object
+ with everything that cell needs (formatted strings, attributed strings, decoded images etc.). Default is `nil`.
+
+ The block must depend only on given parameter and must not touch views, the receiver or any other object that is not
+ thread safe: table view model invokes it on background queue for rows that are about to be displayed. Prepared content,
+ `nil` included, is kept by the receiver until its bound data or the block changes, on the receiver or on its template
+ row, or until the receiver is detached from virtualized or paged section. If content is not prepared in time it is
+ prepared synchronously when cell is configured.
+
+ @see applyContentBlock
+ */
+@property (copy, nonatomic) id (^prepareContentBlock)(NSDictionary *boundData);
+
+/**
+ Block object to be invoked when cell is configured if `prepareContentBlock` is not `nil`. Takes three parameters:
+ row object (the receiver is passed as `row` parameter), cell object and content object returned by
+ `prepareContentBlock`. Should only assign prepared values to cell's subviews. This block is invoked before
+ `configureCellBlock`. Default is `nil`.
+
+ @see prepareContentBlock
+ */
+@property (copy, nonatomic) void (^applyContentBlock)(DXTableViewRow *row, id cell, id content);
+
 /**
  Boolean values that determines if the editing menu should be shown on long tap for row represented by the receiver. Default is NO.
  
@@ -271,6 +340,25 @@
  */
 - (instancetype)initWithCellReuseIdentifier:(NSString *)identifier;
 
+/**
+ Returns row object that shares properties of the given `templateRow`.
+
+ Returned row stores only properties that were set on it directly, other properties (cell reuse identifier,
+ cell class or nib, heights, flags and block properties) are read from `templateRow`, so rows of the same kind
+ don't keep their own copies. Bound data, `rowIdentifier`, `cellText`, `cellDetailText` and `cellImage` are never shared.
+ Template row may itself be created from another template. Changes of template's properties affect all rows
+ created from it. Changes of heights, height blocks, `willDisplayCellBlock` and text measurement attributes of
+ a template make table view models measure rows again and find out which callbacks they need.
+
+ @param templateRow Row object which properties are shared. Must not be `nil`.
+ */
+- (instancetype)initWithTemplateRow:(DXTableViewRow *)templateRow;
+
+/**
+ Row object that was given to `initWithTemplateRow:`, or `nil`.
+ */
+@property (strong, nonatomic, readonly) DXTableViewRow *templateRow;
+
 #pragma mark - Convenience methods
 
 /**
@@ -292,6 +380,55 @@
  */
 @property (copy, nonatomic) NSString *cellDetailText;
 
+/**
+ Boolean value that indicates whether height of row represented by the receiver is computed from `cellText` and
+ `cellDetailText` measured with `cellTextFont` and `cellDetailTextFont` for the width of table view. If `rowHeight`
+ is not UITableViewAutomaticDimension it is used as minimum height. Ignored if `rowHeightBlock` or
+ `rowHeightForWidthBlock` is given. Default is NO.
+
+ Texts are measured for the width that is left by `cellAccessoryType` and by image view of `cellImageSize`, or of
+ `cellImage` if the size is not given, and height of table view's separator is added. Measurements are cached by text,
+ font, number of lines and width, and are shared by all rows and table view models, so rows with the same texts, as
+ well as subsequent width changes to the same widths, don't measure texts again. Changes of measurement attributes of
+ a template row make table view models measure rows again.
+
+ @see [DXTableViewModel precomputeRowHeightsOfSection:]
+ */
+@property (nonatomic) BOOL sizesRowHeightToCellText;
+
+/**
+ Font of cell's textLabel to be used to measure `cellText`. Default is `nil`, which means system font of size 17.
+ */
+@property (strong, nonatomic) UIFont *cellTextFont;
+
+/**
+ Font of cell's detailTextLabel to be used to measure `cellDetailText`. Default is `nil`, which means system font of size 12.
+ */
+@property (strong, nonatomic) UIFont *cellDetailTextFont;
+
+/**
+ Maximum number of lines of `cellText` when measured. Default is 0, which means no limit.
+ */
+@property (nonatomic) NSInteger cellTextNumberOfLines;
+
+/**
+ Maximum number of lines of `cellDetailText` when measured. Default is 0, which means no limit.
+ */
+@property (nonatomic) NSInteger cellDetailTextNumberOfLines;
+
+/**
+ Insets of texts from cell's edges. Default is {11, 15, 11, 15}.
+ */
+@property (nonatomic) UIEdgeInsets cellTextInsets;
+
+/**
+ Type of cell's accessory view. Default is UITableViewCellAccessoryNone.
+
+ If any other value is given it is assigned to cell before `configureCellBlock` call. Width taken by accessory is not
+ available to texts measured by `sizesRowHeightToCellText`.
+ */
+@property (nonatomic) UITableViewCellAccessoryType cellAccessoryType;
+
 /**
  String to be used as cell's imageView image value.
  
@@ -302,11 +439,65 @@
  */
 @property (strong, nonatomic) UIImage *cellImage;
 
+/**
+ Key of image to be displayed in cell's imageView, e.g. URL string or file name. Default is `nil`.
+
+ If both `cellImageKey` and `cellImageLoader` are given, the image is taken from image cache of the receiver's
+ `tableViewModel`, or loaded with `cellImageLoader`, decoded and downscaled to `cellImageSize` on background queue.
+ Meanwhile `cellImage` is displayed as placeholder, or no image if it is `nil`, so a reused cell never shows image
+ of another row. Unlike `cellImage` the receiver doesn't keep loaded image.
+
+ @see [DXTableViewModel imageCacheByteBudget]
+ */
+@property (copy, nonatomic) NSString *cellImageKey;
+
+/**
+ Block object that loads image for given `key`. Takes one parameter: `key` - the receiver's `cellImageKey`,
+ and returns image object or `nil`. The block is invoked on background queue and must be thread safe.
+ Simultaneous requests of the same image are made once. Default is `nil`.
+
+ @see cellImageKey
+ */
+@property (copy, nonatomic) UIImage *(^cellImageLoader)(NSString *key);
+
+/**
+ Size of cell's imageView in points. Images loaded with `cellImageLoader` are downscaled to fit this size
+ before they are cached. Default is CGSizeZero, which means that images are decoded at their own size.
+ */
+@property (nonatomic) CGSize cellImageSize;
+
 /**
  Boolean value that determines will be row deselected with animation just after selection. Default is YES.
  */
 @property (assign, nonatomic) BOOL shouldDeselectRow;
 
+#pragma mark - Prefetching
+
+/**
+ Block object to be invoked when table view is about to need the row represented by the receiver (on table view
+ prefetching data source method `tableView:prefetchRowsAtIndexPaths:`), so expensive data (e.g. remote images)
+ can be loaded before cell is displayed. Takes two parameters: row object (the receiver is passed as `row` parameter)
+ and `completion` block that must be invoked once with loaded data on any thread. Values of given dictionary are stored
+ into the receiver's bound data, so they are accessible via subscript when cell is configured. Default is `nil`,
+ which means that `[DXTableViewSection prefetchRowBlock]` of the receiver's section is used.
+
+ Table view model starts limited number of prefetches at once and doesn't prefetch row twice.
+
+ @see cancelPrefetchBlock
+ @see [DXTableViewModel maximumNumberOfConcurrentPrefetches]
+ */
+@property (copy, nonatomic) void (^prefetchBlock)(DXTableViewRow *row, void (^completion)(NSDictionary *prefetchedData));
+
+/**
+ Block object to be invoked when prefetching of row represented by the receiver is not needed anymore, e.g. row did
+ scroll out of prefetching window. Takes one parameter: row object (the receiver is passed as `row` parameter).
+ Result of cancelled prefetching is ignored. Default is `nil`, which means that
+ `[DXTableViewSection cancelPrefetchRowBlock]` of the receiver's section is used.
+
+ @see prefetchBlock
+ */
+@property (copy, nonatomic) void (^cancelPrefetchBlock)(DXTableViewRow *row);
+
 #pragma mark - Data Bind Capabilities
 
 /**
@@ -335,6 +526,18 @@
  */
 @property (strong, nonatomic, readonly) NSArray *boundKeyPaths;
 
+/**
+ Boolean value that indicates whether the receiver observes `boundKeyPaths` of `boundObject` with key-value observing.
+ Default is NO.
+
+ When observed value changes the receiver is marked as changed, and `tableViewModel` reloads changed values of all
+ changed rows at once on the next run loop turn. Only rows which cells are visible are reloaded in table view,
+ other rows just get new values and heights. Changes made on background threads are handled on the main thread.
+ 
+ @see [DXTableViewModel reloadRowBoundData]
+ */
+@property (nonatomic) BOOL observesBoundObject;
+
 /**
  Binds value of the given `object` with provided `keyPath` to the receiver.
 
@@ -410,6 +613,9 @@
 
 /**
  Reload data from bound object into the receiver using bound keys to be accessible via subscript.
+ Receiver is moved to its new position if its section is sorted and the order has changed.
+
+ @see [DXTableViewSection sortDescriptors]
  */
 - (void)reloadBoundData;
 
@@ -417,10 +623,28 @@
  Update bound object with receiver's bound data.
  
  If you did track changes from cell's controls and store them, or any other data, using subscript into row to previously
- bound key paths, this method will push these values into `boundObject` for each key path from `boundKeyPaths`.
+ bound key paths, this method will push these values into `boundObject` for each key path from `modifiedBoundKeyPaths`.
+ Values of other key paths are not written.
+
+ @see updateObjectReturningWrittenKeyPaths
  */
 - (void)updateObject;
 
+/**
+ Updates bound object with receiver's modified bound data like `updateObject` does.
+
+ @return Set of key paths which values were written into `boundObject`, empty if nothing was modified.
+ */
+- (NSSet *)updateObjectReturningWrittenKeyPaths;
+
+/**
+ Key paths from `boundKeyPaths` which values were changed via subscript since the last binding or reloading of bound data.
+ Values are compared with `isEqual:`, changes of mutable values made in place are not tracked.
+
+ @see updateObject
+ */
+@property (strong, nonatomic, readonly) NSSet *modifiedBoundKeyPaths;
+
 #pragma mark - Subclass Hooks
 
 /**
@@ -9,6 +9,8 @@
 #import "DXTableViewRow.h"
 #import "DXTableViewSection.h"
 #import "DXTableViewModel.h"
+#import <objc/runtime.h>
+#import <pthread.h>
 
 /* TODO
  - add convenience properties: simple value properties for counterpart with block properties and vice versa
@@ -20,15 +22,341 @@
  - provide default subclasses of cell with different stock styles
  */
 
+typedef NS_OPTIONS(unsigned long long, DXTableViewRowAttribute) {
+    DXTableViewRowAttributeCellReuseIdentifier = 1ULL << 0,
+    DXTableViewRowAttributeCellClass = 1ULL << 1,
+    DXTableViewRowAttributeCellNib = 1ULL << 2,
+    DXTableViewRowAttributeRowHeight = 1ULL << 3,
+    DXTableViewRowAttributeRowHeightBlock = 1ULL << 4,
+    DXTableViewRowAttributeEstimatedRowHeight = 1ULL << 5,
+    DXTableViewRowAttributeEstimatedRowHeightBlock = 1ULL << 6,
+    DXTableViewRowAttributeRowHeightForWidthBlock = 1ULL << 7,
+    DXTableViewRowAttributeShouldHighlightRow = 1ULL << 8,
+    DXTableViewRowAttributeEditingStyle = 1ULL << 9,
+    DXTableViewRowAttributeTitleForDeleteConfirmationButton = 1ULL << 10,
+    DXTableViewRowAttributeWillBeginEditingRowBlock = 1ULL << 11,
+    DXTableViewRowAttributeDidEndEditingRowBlock = 1ULL << 12,
+    DXTableViewRowAttributeCanMoveRow = 1ULL << 13,
+    DXTableViewRowAttributeCanEditRow = 1ULL << 14,
+    DXTableViewRowAttributeShouldIndentWhileEditingRow = 1ULL << 15,
+    DXTableViewRowAttributeIndentationLevelForRow = 1ULL << 16,
+    DXTableViewRowAttributeDidHighlightRowBlock = 1ULL << 17,
+    DXTableViewRowAttributeDidUnhighlightRowBlock = 1ULL << 18,
+    DXTableViewRowAttributeWillSelectRowBlock = 1ULL << 19,
+    DXTableViewRowAttributeWillDeselectRowBlock = 1ULL << 20,
+    DXTableViewRowAttributeDidSelectRowBlock = 1ULL << 21,
+    DXTableViewRowAttributeDidDeselectRowBlock = 1ULL << 22,
+    DXTableViewRowAttributeCommitEditingStyleForRowBlock = 1ULL << 23,
+    DXTableViewRowAttributeWillDisplayCellBlock = 1ULL << 24,
+    DXTableViewRowAttributeAccessoryButtonTappedForRowBlock = 1ULL << 25,
+    DXTableViewRowAttributeCellForRowBlock = 1ULL << 26,
+    DXTableViewRowAttributeConfigureCellBlock = 1ULL << 27,
+    DXTableViewRowAttributeShouldShowMenuForRow = 1ULL << 28,
+    DXTableViewRowAttributeCanPerformActionBlock = 1ULL << 29,
+    DXTableViewRowAttributePerformActionBlock = 1ULL << 30,
+    DXTableViewRowAttributeShouldDeselectRow = 1ULL << 31,
+    DXTableViewRowAttributePrefetchBlock = 1ULL << 32,
+    DXTableViewRowAttributeCancelPrefetchBlock = 1ULL << 33,
+    DXTableViewRowAttributePrepareContentBlock = 1ULL << 34,
+    DXTableViewRowAttributeApplyContentBlock = 1ULL << 35,
+    DXTableViewRowAttributeCellImageLoader = 1ULL << 36,
+    DXTableViewRowAttributeCellImageSize = 1ULL << 37,
+    DXTableViewRowAttributeSizesRowHeightToCellText = 1ULL << 38,
+    DXTableViewRowAttributeCellTextFont = 1ULL << 39,
+    DXTableViewRowAttributeCellDetailTextFont = 1ULL << 40,
+    DXTableViewRowAttributeCellTextNumberOfLines = 1ULL << 41,
+    DXTableViewRowAttributeCellDetailTextNumberOfLines = 1ULL << 42,
+    DXTableViewRowAttributeCellTextInsets = 1ULL << 43,
+    DXTableViewRowAttributeCellAccessoryType = 1ULL << 44,
+};
+
+/**
+ Storage of row's properties that can be shared between rows through a template row.
+ */
+@interface DXTableViewRowAttributes : NSObject
+
+@property (nonatomic) DXTableViewRowAttribute overriddenAttributes;
+
+@property (copy, nonatomic) NSString *cellReuseIdentifier;
+@property (unsafe_unretained, nonatomic) Class cellClass;
+@property (strong, nonatomic) UINib *cellNib;
+@property (nonatomic) CGFloat rowHeight;
+@property (copy, nonatomic) CGFloat (^rowHeightBlock)(DXTableViewRow *);
+@property (nonatomic) CGFloat estimatedRowHeight;
+@property (copy, nonatomic) CGFloat (^estimatedRowHeightBlock)(DXTableViewRow *);
+@property (copy, nonatomic) CGFloat (^rowHeightForWidthBlock)(NSDictionary *, CGFloat);
+@property (nonatomic) BOOL shouldHighlightRow;
+@property (nonatomic) UITableViewCellEditingStyle editingStyle;
+@property (copy, nonatomic) NSString *titleForDeleteConfirmationButton;
+@property (copy, nonatomic) void (^willBeginEditingRowBlock)(DXTableViewRow *);
+@property (copy, nonatomic) void (^didEndEditingRowBlock)(DXTableViewRow *);
+@property (nonatomic) BOOL canMoveRow;
+@property (nonatomic) BOOL canEditRow;
+@property (nonatomic) BOOL shouldIndentWhileEditingRow;
+@property (nonatomic) NSInteger indentationLevelForRow;
+@property (copy, nonatomic) void (^didHighlightRowBlock)(DXTableViewRow *);
+@property (copy, nonatomic) void (^didUnhighlightRowBlock)(DXTableViewRow *);
+@property (copy, nonatomic) NSIndexPath *(^willSelectRowBlock)(DXTableViewRow *);
+@property (copy, nonatomic) NSIndexPath *(^willDeselectRowBlock)(DXTableViewRow *);
+@property (copy, nonatomic) void (^didSelectRowBlock)(DXTableViewRow *);
+@property (copy, nonatomic) void (^didDeselectRowBlock)(DXTableViewRow *);
+@property (copy, nonatomic) void (^commitEditingStyleForRowBlock)(DXTableViewRow *);
+@property (copy, nonatomic) void (^willDisplayCellBlock)(DXTableViewRow *, id);
+@property (copy, nonatomic) void (^accessoryButtonTappedForRowBlock)(DXTableViewRow *);
+@property (copy, nonatomic) UITableViewCell *(^cellForRowBlock)(DXTableViewRow *);
+@property (copy, nonatomic) void (^configureCellBlock)(DXTableViewRow *, id);
+@property (nonatomic) BOOL shouldShowMenuForRow;
+@property (copy, nonatomic) BOOL (^canPerformActionBlock)(DXTableViewRow *, SEL, id);
+@property (copy, nonatomic) void (^performActionBlock)(DXTableViewRow *, SEL, id);
+@property (nonatomic) BOOL shouldDeselectRow;
+@property (copy, nonatomic) void (^prefetchBlock)(DXTableViewRow *, void (^)(NSDictionary *));
+@property (copy, nonatomic) void (^cancelPrefetchBlock)(DXTableViewRow *);
+@property (copy, nonatomic) id (^prepareContentBlock)(NSDictionary *);
+@property (copy, nonatomic) void (^applyContentBlock)(DXTableViewRow *, id, id);
+@property (copy, nonatomic) UIImage *(^cellImageLoader)(NSString *);
+@property (nonatomic) CGSize cellImageSize;
+@property (nonatomic) BOOL sizesRowHeightToCellText;
+@property (strong, nonatomic) UIFont *cellTextFont;
+@property (strong, nonatomic) UIFont *cellDetailTextFont;
+@property (nonatomic) NSInteger cellTextNumberOfLines;
+@property (nonatomic) NSInteger cellDetailTextNumberOfLines;
+@property (nonatomic) UIEdgeInsets cellTextInsets;
+@property (nonatomic) UITableViewCellAccessoryType cellAccessoryType;
+
+@end
+
+@implementation DXTableViewRowAttributes
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _rowHeight = UITableViewAutomaticDimension;
+        _estimatedRowHeight = UITableViewAutomaticDimension;
+        _editingStyle = UITableViewCellEditingStyleDelete;
+        _canMoveRow = NO;
+        _canEditRow = YES;
+        _shouldHighlightRow = YES;
+        _shouldIndentWhileEditingRow = YES;
+        _indentationLevelForRow = 0;
+        _shouldShowMenuForRow = NO;
+        _shouldDeselectRow = YES;
+        _cellTextInsets = UIEdgeInsetsMake(11, 15, 11, 15);
+    }
+    return self;
+}
+
+@end
+
+/**
+ Resolves key path once per class of bound object into direct getter and setter implementations, so data binding
+ skips key path parsing and method lookup of key-value coding. Keys that have no object getter or setter
+ (scalar properties, collections' keys etc.) fall back to key-value coding, as do whole key paths of dictionaries
+ and proxies, whose keys are not methods, and key paths with collection operators.
+ */
+@interface DXTableViewRowKeyPathAccessor : NSObject
+
++ (instancetype)accessorForClass:(Class)cls keyPath:(NSString *)keyPath;
+
+- (id)valueOfObject:(id)object;
+- (void)setValue:(id)value ofObject:(id)object;
+
+@end
+
+// Guards only the shared table, rows keep accessors for classes of their bound objects and don't look it up again
+static pthread_mutex_t DXTableViewRowKeyPathAccessorsMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Dictionaries map keys to values and collections map them over elements, so neither can be read by their methods
+static BOOL DXClassNeedsKeyValueCoding(Class cls)
+{
+    Class dictionaryClass = [NSDictionary class];
+    Class arrayClass = [NSArray class];
+    Class setClass = [NSSet class];
+    Class orderedSetClass = [NSOrderedSet class];
+    Class proxyClass = [NSProxy class];
+    for (; Nil != cls; cls = class_getSuperclass(cls)) {
+        if (dictionaryClass == cls || arrayClass == cls || setClass == cls || orderedSetClass == cls || proxyClass == cls)
+            return YES;
+    }
+    return NO;
+}
+
+@implementation DXTableViewRowKeyPathAccessor {
+    Class _class;
+    NSString *_keyPath;
+    NSString *_key;
+    NSString *_remainingKeyPath;
+    BOOL _usesKeyValueCoding;
+    SEL _getter;
+    IMP _getterIMP;
+    SEL _setter;
+    IMP _setterIMP;
+    // kept by the shared table for good, so it isn't retained here
+    __unsafe_unretained DXTableViewRowKeyPathAccessor *_remainingAccessor;
+}
+
++ (instancetype)accessorForClass:(Class)cls keyPath:(NSString *)keyPath
+{
+    static NSMapTable *accessorsByClass;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        accessorsByClass = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsOpaqueMemory | NSPointerFunctionsOpaquePersonality
+                                                 valueOptions:NSPointerFunctionsStrongMemory];
+    });
+
+    pthread_mutex_lock(&DXTableViewRowKeyPathAccessorsMutex);
+    DXTableViewRowKeyPathAccessor *accessor = [[accessorsByClass objectForKey:cls] objectForKey:keyPath];
+    pthread_mutex_unlock(&DXTableViewRowKeyPathAccessorsMutex);
+    if (nil != accessor)
+        return accessor;
+
+    // resolved outside of the lock, runtime may initialize the class meanwhile
+    DXTableViewRowKeyPathAccessor *newAccessor = [[self alloc] initWithClass:cls keyPath:keyPath];
+    pthread_mutex_lock(&DXTableViewRowKeyPathAccessorsMutex);
+    NSMutableDictionary *accessorByKeyPath = [accessorsByClass objectForKey:cls];
+    if (nil == accessorByKeyPath) {
+        accessorByKeyPath = [NSMutableDictionary dictionary];
+        [accessorsByClass setObject:accessorByKeyPath forKey:cls];
+    }
+    accessor = accessorByKeyPath[keyPath];
+    if (nil == accessor) {
+        accessor = newAccessor;
+        accessorByKeyPath[keyPath] = accessor;
+    }
+    pthread_mutex_unlock(&DXTableViewRowKeyPathAccessorsMutex);
+    return accessor;
+}
+
+- (instancetype)initWithClass:(Class)cls keyPath:(NSString *)keyPath
+{
+    self = [super init];
+    if (self) {
+        _class = cls;
+        _keyPath = keyPath.copy;
+        if (NSNotFound != [keyPath rangeOfString:@"@"].location || DXClassNeedsKeyValueCoding(cls)) {
+            _usesKeyValueCoding = YES;
+            return self;
+        }
+
+        NSRange dotRange = [keyPath rangeOfString:@"."];
+        if (NSNotFound == dotRange.location) {
+            _key = keyPath.copy;
+        }
+        else {
+            _key = [keyPath substringToIndex:dotRange.location];
+            _remainingKeyPath = [keyPath substringFromIndex:NSMaxRange(dotRange)];
+        }
+
+        if (0 == _key.length)
+            return self;
+
+        SEL getter = NSSelectorFromString(_key);
+        Method getterMethod = class_getInstanceMethod(cls, getter);
+        if (NULL != getterMethod && 2 == method_getNumberOfArguments(getterMethod) &&
+            '@' == method_getTypeEncoding(getterMethod)[0]) {
+            _getter = getter;
+            _getterIMP = method_getImplementation(getterMethod);
+        }
+
+        NSString *setterName = [NSString stringWithFormat:@"set%@%@:",
+                                [_key substringToIndex:1].uppercaseString, [_key substringFromIndex:1]];
+        SEL setter = NSSelectorFromString(setterName);
+        Method setterMethod = class_getInstanceMethod(cls, setter);
+        if (NULL != setterMethod && 3 == method_getNumberOfArguments(setterMethod)) {
+            char *argumentType = method_copyArgumentType(setterMethod, 2);
+            if ('@' == argumentType[0]) {
+                _setter = setter;
+                _setterIMP = method_getImplementation(setterMethod);
+            }
+            free(argumentType);
+        }
+    }
+    return self;
+}
+
+- (id)valueForKeyOfObject:(id)object
+{
+    if (NULL != _getterIMP)
+        return ((id (*)(id, SEL))_getterIMP)(object, _getter);
+    return [object valueForKey:_key];
+}
+
+// Intermediate objects of a key path are mostly of one class, so accessor for the last seen one is tried before
+// the shared table, which is looked up under the lock
+- (DXTableViewRowKeyPathAccessor *)remainingAccessorForObject:(id)object
+{
+    Class cls = object_getClass(object);
+    DXTableViewRowKeyPathAccessor *accessor = _remainingAccessor;
+    if (nil == accessor || accessor->_class != cls) {
+        accessor = [DXTableViewRowKeyPathAccessor accessorForClass:cls keyPath:_remainingKeyPath];
+        _remainingAccessor = accessor;
+    }
+    return accessor;
+}
+
+- (id)valueOfObject:(id)object
+{
+    if (_usesKeyValueCoding)
+        return [object valueForKeyPath:_keyPath];
+    id value = [self valueForKeyOfObject:object];
+    if (nil == _remainingKeyPath || nil == value)
+        return value;
+    return [[self remainingAccessorForObject:value] valueOfObject:value];
+}
+
+- (void)setValue:(id)value ofObject:(id)object
+{
+    if (_usesKeyValueCoding) {
+        [object setValue:value forKeyPath:_keyPath];
+        return;
+    }
+    if (nil != _remainingKeyPath) {
+        id target = [self valueForKeyOfObject:object];
+        if (nil != target)
+            [[self remainingAccessorForObject:target] setValue:value ofObject:target];
+        return;
+    }
+
+    if (NULL != _setterIMP)
+        ((void (*)(id, SEL, id))_setterIMP)(object, _setter, value);
+    else
+        [object setValue:value forKey:_key];
+}
+
+@end
+
 @interface DXTableViewSection (ForTableViewRowEyes)
 
+@property (nonatomic, readonly) NSUInteger rowsGeneration;
+@property (nonatomic, readonly) NSUInteger sectionsGeneration;
+
 - (NSIndexPath *)indexPathForRow:(DXTableViewRow *)row;
+- (void)repositionRowIfNeeded:(DXTableViewRow *)row;
 
 @end
 
+@interface DXTableViewModel (ForTableViewRowEyes)
+
+- (void)registerCellNib:(UINib *)nib class:(Class)cls reuseIdentifier:(NSString *)reuseIdentifier;
+- (void)setNeedsReloadChangedBoundDataForRow:(DXTableViewRow *)row;
+- (void)loadCellImageForRow:(DXTableViewRow *)row;
+- (void)rowDidChangeCallbacks:(DXTableViewRow *)row;
+- (void)rowDidModifyBoundData:(DXTableViewRow *)row;
+
+@end
+
+static void *DXTableViewRowBoundObjectObservingContext = &DXTableViewRowBoundObjectObservingContext;
+
+// Bumped when attributes of a row used as template that affect heights or needed callbacks change, so models
+// measure rows created from it again and find out what they need
+static NSUInteger DXTableViewRowTemplateGeneration = 1;
+
 @interface DXTableViewRow () <UITextViewDelegate>
 
 @property (strong, nonatomic) id cell;
+@property (strong, nonatomic) DXTableViewRow *templateRow;
+@property (nonatomic) BOOL usedAsTemplate;
+@property (strong, nonatomic) DXTableViewRowAttributes *attributes;
 @property (strong, nonatomic) DXTableViewModel *tableViewModel;
 @property (strong, nonatomic) DXTableViewSection *section;
 @property (strong, nonatomic) id boundObject;
@@ -36,6 +364,35 @@
 @property (strong, nonatomic) NSMutableDictionary *boundObjectData;
 @property (copy, nonatomic) void (^textViewDidChangeBlock)(UITextView *);
 @property (strong, nonatomic) NSMutableDictionary *actionBlockByControlMap;
+@property (nonatomic, getter = isObservingBoundObject) BOOL observingBoundObject;
+@property (strong, nonatomic) NSMutableSet *changedBoundKeyPaths;
+@property (strong, nonatomic) NSMutableSet *mutableModifiedBoundKeyPaths;
+@property (unsafe_unretained, nonatomic) Class boundAccessorsClass;
+@property (strong, nonatomic) NSArray *boundAccessors;
+
+@property (nonatomic) NSInteger cachedRowIndex;
+@property (nonatomic) NSUInteger cachedRowIndexGeneration;
+@property (strong, nonatomic) NSIndexPath *cachedRowIndexPath;
+@property (nonatomic) NSUInteger cachedRowIndexPathRowsGeneration;
+@property (nonatomic) NSUInteger cachedRowIndexPathSectionsGeneration;
+
+@property (nonatomic) CGFloat cachedRowHeight;
+@property (nonatomic) NSUInteger cachedRowHeightGeneration;
+@property (nonatomic) NSUInteger rowHeightToken;
+@property (nonatomic) NSUInteger mergedRowCallbacks;
+@property (nonatomic) CGFloat mergedRowHeight;
+
+@property (nonatomic) NSInteger prefetchState;
+@property (nonatomic) NSUInteger prefetchToken;
+@property (strong, nonatomic) NSArray *prefetchedKeyPaths;
+@property (strong, nonatomic) id cellImageCacheKey;
+
+@property (strong, nonatomic) id preparedContent;
+@property (nonatomic) NSUInteger preparedContentToken;
+@property (nonatomic) BOOL contentPrepared;
+@property (copy, nonatomic) id (^preparedContentBlock)(NSDictionary *);
+
+@property (copy, nonatomic) NSDictionary *filterData;
 
 @end
 
@@ -45,20 +402,35 @@
 {
     self = [super init];
     if (self) {
-        _cellReuseIdentifier = identifier;
-        _rowHeight = UITableViewAutomaticDimension;
-        _editingStyle = UITableViewCellEditingStyleDelete;
-        _canMoveRow = NO;
-        _canEditRow = YES;
-        _shouldHighlightRow = YES;
-        _shouldIndentWhileEditingRow = YES;
-        _indentationLevelForRow = 0;
-        _shouldShowMenuForRow = NO;
-        _shouldDeselectRow = YES;
+        _attributes = [[DXTableViewRowAttributes alloc] init];
+        _attributes.cellReuseIdentifier = identifier;
     }
     return self;
 }
 
+- (instancetype)initWithTemplateRow:(DXTableViewRow *)templateRow
+{
+    if (nil == templateRow)
+        [NSException raise:NSInvalidArgumentException format:@"template row must not be nil"];
+
+    self = [super init];
+    if (self) {
+        _templateRow = templateRow;
+        templateRow.usedAsTemplate = YES;
+    }
+    return self;
+}
+
++ (NSUInteger)templateGeneration
+{
+    return DXTableViewRowTemplateGeneration;
+}
+
+- (void)dealloc
+{
+    [self stopObservingBoundObject];
+}
+
 - (NSString *)description
 {
     NSString *description = [NSString stringWithFormat:@"<%@: %p; ID='%@'; indexPath=%@; sectionName='%@'>",
@@ -68,7 +440,19 @@
 
 - (NSIndexPath *)rowIndexPath
 {
-    return [self.section indexPathForRow:self];
+    if (nil == _section)
+        return nil;
+
+    NSUInteger rowsGeneration = _section.rowsGeneration;
+    NSUInteger sectionsGeneration = _section.sectionsGeneration;
+    if (nil == _cachedRowIndexPath ||
+        _cachedRowIndexPathRowsGeneration != rowsGeneration ||
+        _cachedRowIndexPathSectionsGeneration != sectionsGeneration) {
+        _cachedRowIndexPath = [_section indexPathForRow:self];
+        _cachedRowIndexPathRowsGeneration = rowsGeneration;
+        _cachedRowIndexPathSectionsGeneration = sectionsGeneration;
+    }
+    return _cachedRowIndexPath;
 }
 
 - (UITableView *)tableView
@@ -78,10 +462,7 @@
 
 - (void)registerNibOrClass
 {
-    if (nil != self.cellClass)
-        [self.tableViewModel.tableView registerClass:self.cellClass forCellReuseIdentifier:self.cellReuseIdentifier];
-    else if (nil != self.cellNib)
-        [self.tableViewModel.tableView registerNib:self.cellNib forCellReuseIdentifier:self.cellReuseIdentifier];
+    [self.tableViewModel registerCellNib:self.cellNib class:self.cellClass reuseIdentifier:self.cellReuseIdentifier];
 }
 
 - (NSMutableDictionary *)actionBlockByControlMap
@@ -91,6 +472,595 @@
     return _actionBlockByControlMap;
 }
 
+#pragma mark - Shared attributes
+
+- (DXTableViewRowAttributes *)attributesForReading:(DXTableViewRowAttribute)attribute
+{
+    DXTableViewRow *row = self;
+    while (nil != row->_templateRow && 0 == (row->_attributes.overriddenAttributes & attribute))
+        row = row->_templateRow;
+    return row->_attributes;
+}
+
+- (DXTableViewRowAttributes *)attributesForWriting:(DXTableViewRowAttribute)attribute
+{
+    if (nil == _attributes)
+        _attributes = [[DXTableViewRowAttributes alloc] init];
+    _attributes.overriddenAttributes |= attribute;
+    return _attributes;
+}
+
+- (NSString *)cellReuseIdentifier
+{
+    return [self attributesForReading:DXTableViewRowAttributeCellReuseIdentifier].cellReuseIdentifier;
+}
+
+- (void)setCellReuseIdentifier:(NSString *)cellReuseIdentifier
+{
+    [self attributesForWriting:DXTableViewRowAttributeCellReuseIdentifier].cellReuseIdentifier = cellReuseIdentifier;
+}
+
+- (Class)cellClass
+{
+    return [self attributesForReading:DXTableViewRowAttributeCellClass].cellClass;
+}
+
+- (void)setCellClass:(Class)cellClass
+{
+    [self attributesForWriting:DXTableViewRowAttributeCellClass].cellClass = cellClass;
+}
+
+- (UINib *)cellNib
+{
+    return [self attributesForReading:DXTableViewRowAttributeCellNib].cellNib;
+}
+
+- (void)setCellNib:(UINib *)cellNib
+{
+    [self attributesForWriting:DXTableViewRowAttributeCellNib].cellNib = cellNib;
+}
+
+- (CGFloat)rowHeight
+{
+    return [self attributesForReading:DXTableViewRowAttributeRowHeight].rowHeight;
+}
+
+- (void)setRowHeight:(CGFloat)rowHeight
+{
+    [self attributesForWriting:DXTableViewRowAttributeRowHeight].rowHeight = rowHeight;
+    [self didChangeHeightAttributes];
+}
+
+- (CGFloat (^)(DXTableViewRow *))rowHeightBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributeRowHeightBlock].rowHeightBlock;
+}
+
+- (void)setRowHeightBlock:(CGFloat (^)(DXTableViewRow *))rowHeightBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributeRowHeightBlock].rowHeightBlock = rowHeightBlock;
+    [self didChangeHeightAttributes];
+}
+
+- (CGFloat)estimatedRowHeight
+{
+    return [self attributesForReading:DXTableViewRowAttributeEstimatedRowHeight].estimatedRowHeight;
+}
+
+- (void)setEstimatedRowHeight:(CGFloat)estimatedRowHeight
+{
+    [self attributesForWriting:DXTableViewRowAttributeEstimatedRowHeight].estimatedRowHeight = estimatedRowHeight;
+    [self didChangeCallbackAttributes];
+}
+
+- (CGFloat (^)(DXTableViewRow *))estimatedRowHeightBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributeEstimatedRowHeightBlock].estimatedRowHeightBlock;
+}
+
+- (void)setEstimatedRowHeightBlock:(CGFloat (^)(DXTableViewRow *))estimatedRowHeightBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributeEstimatedRowHeightBlock].estimatedRowHeightBlock = estimatedRowHeightBlock;
+    [self didChangeCallbackAttributes];
+}
+
+- (CGFloat (^)(NSDictionary *, CGFloat))rowHeightForWidthBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributeRowHeightForWidthBlock].rowHeightForWidthBlock;
+}
+
+- (void)setRowHeightForWidthBlock:(CGFloat (^)(NSDictionary *, CGFloat))rowHeightForWidthBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributeRowHeightForWidthBlock].rowHeightForWidthBlock = rowHeightForWidthBlock;
+    [self didChangeHeightAttributes];
+}
+
+- (BOOL)shouldHighlightRow
+{
+    return [self attributesForReading:DXTableViewRowAttributeShouldHighlightRow].shouldHighlightRow;
+}
+
+- (void)setShouldHighlightRow:(BOOL)shouldHighlightRow
+{
+    [self attributesForWriting:DXTableViewRowAttributeShouldHighlightRow].shouldHighlightRow = shouldHighlightRow;
+}
+
+- (UITableViewCellEditingStyle)editingStyle
+{
+    return [self attributesForReading:DXTableViewRowAttributeEditingStyle].editingStyle;
+}
+
+- (void)setEditingStyle:(UITableViewCellEditingStyle)editingStyle
+{
+    [self attributesForWriting:DXTableViewRowAttributeEditingStyle].editingStyle = editingStyle;
+}
+
+- (NSString *)titleForDeleteConfirmationButton
+{
+    return [self attributesForReading:DXTableViewRowAttributeTitleForDeleteConfirmationButton].titleForDeleteConfirmationButton;
+}
+
+- (void)setTitleForDeleteConfirmationButton:(NSString *)titleForDeleteConfirmationButton
+{
+    [self attributesForWriting:DXTableViewRowAttributeTitleForDeleteConfirmationButton].titleForDeleteConfirmationButton = titleForDeleteConfirmationButton;
+}
+
+- (void (^)(DXTableViewRow *))willBeginEditingRowBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributeWillBeginEditingRowBlock].willBeginEditingRowBlock;
+}
+
+- (void)setWillBeginEditingRowBlock:(void (^)(DXTableViewRow *))willBeginEditingRowBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributeWillBeginEditingRowBlock].willBeginEditingRowBlock = willBeginEditingRowBlock;
+}
+
+- (void (^)(DXTableViewRow *))didEndEditingRowBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributeDidEndEditingRowBlock].didEndEditingRowBlock;
+}
+
+- (void)setDidEndEditingRowBlock:(void (^)(DXTableViewRow *))didEndEditingRowBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributeDidEndEditingRowBlock].didEndEditingRowBlock = didEndEditingRowBlock;
+}
+
+- (BOOL)canMoveRow
+{
+    return [self attributesForReading:DXTableViewRowAttributeCanMoveRow].canMoveRow;
+}
+
+- (void)setCanMoveRow:(BOOL)canMoveRow
+{
+    [self attributesForWriting:DXTableViewRowAttributeCanMoveRow].canMoveRow = canMoveRow;
+}
+
+- (BOOL)canEditRow
+{
+    return [self attributesForReading:DXTableViewRowAttributeCanEditRow].canEditRow;
+}
+
+- (void)setCanEditRow:(BOOL)canEditRow
+{
+    [self attributesForWriting:DXTableViewRowAttributeCanEditRow].canEditRow = canEditRow;
+}
+
+- (BOOL)shouldIndentWhileEditingRow
+{
+    return [self attributesForReading:DXTableViewRowAttributeShouldIndentWhileEditingRow].shouldIndentWhileEditingRow;
+}
+
+- (void)setShouldIndentWhileEditingRow:(BOOL)shouldIndentWhileEditingRow
+{
+    [self attributesForWriting:DXTableViewRowAttributeShouldIndentWhileEditingRow].shouldIndentWhileEditingRow = shouldIndentWhileEditingRow;
+}
+
+- (NSInteger)indentationLevelForRow
+{
+    return [self attributesForReading:DXTableViewRowAttributeIndentationLevelForRow].indentationLevelForRow;
+}
+
+- (void)setIndentationLevelForRow:(NSInteger)indentationLevelForRow
+{
+    [self attributesForWriting:DXTableViewRowAttributeIndentationLevelForRow].indentationLevelForRow = indentationLevelForRow;
+}
+
+- (void (^)(DXTableViewRow *))didHighlightRowBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributeDidHighlightRowBlock].didHighlightRowBlock;
+}
+
+- (void)setDidHighlightRowBlock:(void (^)(DXTableViewRow *))didHighlightRowBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributeDidHighlightRowBlock].didHighlightRowBlock = didHighlightRowBlock;
+}
+
+- (void (^)(DXTableViewRow *))didUnhighlightRowBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributeDidUnhighlightRowBlock].didUnhighlightRowBlock;
+}
+
+- (void)setDidUnhighlightRowBlock:(void (^)(DXTableViewRow *))didUnhighlightRowBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributeDidUnhighlightRowBlock].didUnhighlightRowBlock = didUnhighlightRowBlock;
+}
+
+- (NSIndexPath *(^)(DXTableViewRow *))willSelectRowBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributeWillSelectRowBlock].willSelectRowBlock;
+}
+
+- (void)setWillSelectRowBlock:(NSIndexPath *(^)(DXTableViewRow *))willSelectRowBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributeWillSelectRowBlock].willSelectRowBlock = willSelectRowBlock;
+}
+
+- (NSIndexPath *(^)(DXTableViewRow *))willDeselectRowBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributeWillDeselectRowBlock].willDeselectRowBlock;
+}
+
+- (void)setWillDeselectRowBlock:(NSIndexPath *(^)(DXTableViewRow *))willDeselectRowBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributeWillDeselectRowBlock].willDeselectRowBlock = willDeselectRowBlock;
+}
+
+- (void (^)(DXTableViewRow *))didSelectRowBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributeDidSelectRowBlock].didSelectRowBlock;
+}
+
+- (void)setDidSelectRowBlock:(void (^)(DXTableViewRow *))didSelectRowBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributeDidSelectRowBlock].didSelectRowBlock = didSelectRowBlock;
+}
+
+- (void (^)(DXTableViewRow *))didDeselectRowBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributeDidDeselectRowBlock].didDeselectRowBlock;
+}
+
+- (void)setDidDeselectRowBlock:(void (^)(DXTableViewRow *))didDeselectRowBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributeDidDeselectRowBlock].didDeselectRowBlock = didDeselectRowBlock;
+}
+
+- (void (^)(DXTableViewRow *))commitEditingStyleForRowBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributeCommitEditingStyleForRowBlock].commitEditingStyleForRowBlock;
+}
+
+- (void)setCommitEditingStyleForRowBlock:(void (^)(DXTableViewRow *))commitEditingStyleForRowBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributeCommitEditingStyleForRowBlock].commitEditingStyleForRowBlock = commitEditingStyleForRowBlock;
+}
+
+- (void (^)(DXTableViewRow *, id))willDisplayCellBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributeWillDisplayCellBlock].willDisplayCellBlock;
+}
+
+- (void)setWillDisplayCellBlock:(void (^)(DXTableViewRow *, id))willDisplayCellBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributeWillDisplayCellBlock].willDisplayCellBlock = willDisplayCellBlock;
+    [self didChangeCallbackAttributes];
+}
+
+- (void (^)(DXTableViewRow *))accessoryButtonTappedForRowBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributeAccessoryButtonTappedForRowBlock].accessoryButtonTappedForRowBlock;
+}
+
+- (void)setAccessoryButtonTappedForRowBlock:(void (^)(DXTableViewRow *))accessoryButtonTappedForRowBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributeAccessoryButtonTappedForRowBlock].accessoryButtonTappedForRowBlock = accessoryButtonTappedForRowBlock;
+}
+
+- (UITableViewCell *(^)(DXTableViewRow *))cellForRowBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributeCellForRowBlock].cellForRowBlock;
+}
+
+- (void)setCellForRowBlock:(UITableViewCell *(^)(DXTableViewRow *))cellForRowBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributeCellForRowBlock].cellForRowBlock = cellForRowBlock;
+}
+
+- (void (^)(DXTableViewRow *, id))configureCellBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributeConfigureCellBlock].configureCellBlock;
+}
+
+- (void)setConfigureCellBlock:(void (^)(DXTableViewRow *, id))configureCellBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributeConfigureCellBlock].configureCellBlock = configureCellBlock;
+}
+
+- (BOOL)shouldShowMenuForRow
+{
+    return [self attributesForReading:DXTableViewRowAttributeShouldShowMenuForRow].shouldShowMenuForRow;
+}
+
+- (void)setShouldShowMenuForRow:(BOOL)shouldShowMenuForRow
+{
+    [self attributesForWriting:DXTableViewRowAttributeShouldShowMenuForRow].shouldShowMenuForRow = shouldShowMenuForRow;
+}
+
+- (BOOL (^)(DXTableViewRow *, SEL, id))canPerformActionBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributeCanPerformActionBlock].canPerformActionBlock;
+}
+
+- (void)setCanPerformActionBlock:(BOOL (^)(DXTableViewRow *, SEL, id))canPerformActionBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributeCanPerformActionBlock].canPerformActionBlock = canPerformActionBlock;
+}
+
+- (void (^)(DXTableViewRow *, SEL, id))performActionBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributePerformActionBlock].performActionBlock;
+}
+
+- (void)setPerformActionBlock:(void (^)(DXTableViewRow *, SEL, id))performActionBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributePerformActionBlock].performActionBlock = performActionBlock;
+}
+
+- (BOOL)shouldDeselectRow
+{
+    return [self attributesForReading:DXTableViewRowAttributeShouldDeselectRow].shouldDeselectRow;
+}
+
+- (void)setShouldDeselectRow:(BOOL)shouldDeselectRow
+{
+    [self attributesForWriting:DXTableViewRowAttributeShouldDeselectRow].shouldDeselectRow = shouldDeselectRow;
+}
+
+- (void (^)(DXTableViewRow *, void (^)(NSDictionary *)))prefetchBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributePrefetchBlock].prefetchBlock;
+}
+
+- (void)setPrefetchBlock:(void (^)(DXTableViewRow *, void (^)(NSDictionary *)))prefetchBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributePrefetchBlock].prefetchBlock = prefetchBlock;
+}
+
+- (void (^)(DXTableViewRow *))cancelPrefetchBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributeCancelPrefetchBlock].cancelPrefetchBlock;
+}
+
+- (void)setCancelPrefetchBlock:(void (^)(DXTableViewRow *))cancelPrefetchBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributeCancelPrefetchBlock].cancelPrefetchBlock = cancelPrefetchBlock;
+}
+
+- (id (^)(NSDictionary *))prepareContentBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributePrepareContentBlock].prepareContentBlock;
+}
+
+- (void)setPrepareContentBlock:(id (^)(NSDictionary *))prepareContentBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributePrepareContentBlock].prepareContentBlock = prepareContentBlock;
+    [self invalidatePreparedContent];
+}
+
+- (void (^)(DXTableViewRow *, id, id))applyContentBlock
+{
+    return [self attributesForReading:DXTableViewRowAttributeApplyContentBlock].applyContentBlock;
+}
+
+- (void)setApplyContentBlock:(void (^)(DXTableViewRow *, id, id))applyContentBlock
+{
+    [self attributesForWriting:DXTableViewRowAttributeApplyContentBlock].applyContentBlock = applyContentBlock;
+}
+
+- (UIImage *(^)(NSString *))cellImageLoader
+{
+    return [self attributesForReading:DXTableViewRowAttributeCellImageLoader].cellImageLoader;
+}
+
+- (void)setCellImageLoader:(UIImage *(^)(NSString *))cellImageLoader
+{
+    [self attributesForWriting:DXTableViewRowAttributeCellImageLoader].cellImageLoader = cellImageLoader;
+}
+
+- (CGSize)cellImageSize
+{
+    return [self attributesForReading:DXTableViewRowAttributeCellImageSize].cellImageSize;
+}
+
+- (void)setCellImageSize:(CGSize)cellImageSize
+{
+    [self attributesForWriting:DXTableViewRowAttributeCellImageSize].cellImageSize = cellImageSize;
+    [self didChangeTextMeasurementAttributes];
+}
+
+- (BOOL)sizesRowHeightToCellText
+{
+    return [self attributesForReading:DXTableViewRowAttributeSizesRowHeightToCellText].sizesRowHeightToCellText;
+}
+
+- (void)setSizesRowHeightToCellText:(BOOL)sizesRowHeightToCellText
+{
+    [self attributesForWriting:DXTableViewRowAttributeSizesRowHeightToCellText].sizesRowHeightToCellText = sizesRowHeightToCellText;
+    [self didChangeTextMeasurementAttributes];
+    [self.tableViewModel rowDidChangeCallbacks:self];
+}
+
+- (UIFont *)cellTextFont
+{
+    return [self attributesForReading:DXTableViewRowAttributeCellTextFont].cellTextFont;
+}
+
+- (void)setCellTextFont:(UIFont *)cellTextFont
+{
+    [self attributesForWriting:DXTableViewRowAttributeCellTextFont].cellTextFont = cellTextFont;
+    [self didChangeTextMeasurementAttributes];
+}
+
+- (UIFont *)cellDetailTextFont
+{
+    return [self attributesForReading:DXTableViewRowAttributeCellDetailTextFont].cellDetailTextFont;
+}
+
+- (void)setCellDetailTextFont:(UIFont *)cellDetailTextFont
+{
+    [self attributesForWriting:DXTableViewRowAttributeCellDetailTextFont].cellDetailTextFont = cellDetailTextFont;
+    [self didChangeTextMeasurementAttributes];
+}
+
+- (NSInteger)cellTextNumberOfLines
+{
+    return [self attributesForReading:DXTableViewRowAttributeCellTextNumberOfLines].cellTextNumberOfLines;
+}
+
+- (void)setCellTextNumberOfLines:(NSInteger)cellTextNumberOfLines
+{
+    [self attributesForWriting:DXTableViewRowAttributeCellTextNumberOfLines].cellTextNumberOfLines = cellTextNumberOfLines;
+    [self didChangeTextMeasurementAttributes];
+}
+
+- (NSInteger)cellDetailTextNumberOfLines
+{
+    return [self attributesForReading:DXTableViewRowAttributeCellDetailTextNumberOfLines].cellDetailTextNumberOfLines;
+}
+
+- (void)setCellDetailTextNumberOfLines:(NSInteger)cellDetailTextNumberOfLines
+{
+    [self attributesForWriting:DXTableViewRowAttributeCellDetailTextNumberOfLines].cellDetailTextNumberOfLines = cellDetailTextNumberOfLines;
+    [self didChangeTextMeasurementAttributes];
+}
+
+- (UIEdgeInsets)cellTextInsets
+{
+    return [self attributesForReading:DXTableViewRowAttributeCellTextInsets].cellTextInsets;
+}
+
+- (void)setCellTextInsets:(UIEdgeInsets)cellTextInsets
+{
+    [self attributesForWriting:DXTableViewRowAttributeCellTextInsets].cellTextInsets = cellTextInsets;
+    [self didChangeTextMeasurementAttributes];
+}
+
+- (UITableViewCellAccessoryType)cellAccessoryType
+{
+    return [self attributesForReading:DXTableViewRowAttributeCellAccessoryType].cellAccessoryType;
+}
+
+- (void)setCellAccessoryType:(UITableViewCellAccessoryType)cellAccessoryType
+{
+    [self attributesForWriting:DXTableViewRowAttributeCellAccessoryType].cellAccessoryType = cellAccessoryType;
+    [self didChangeTextMeasurementAttributes];
+}
+
+// Rows created from the receiver don't know about the change, their models notice it by the generation
+- (void)didChangeTemplateAttributes
+{
+    if (self.usedAsTemplate)
+        ++DXTableViewRowTemplateGeneration;
+}
+
+- (void)didChangeTextMeasurementAttributes
+{
+    [self.tableViewModel invalidateHeightForRow:self];
+    [self didChangeTemplateAttributes];
+}
+
+- (void)didChangeHeightAttributes
+{
+    [self.tableViewModel invalidateHeightForRow:self];
+    [self.tableViewModel rowDidChangeCallbacks:self];
+    [self didChangeTemplateAttributes];
+}
+
+- (void)didChangeCallbackAttributes
+{
+    [self.tableViewModel rowDidChangeCallbacks:self];
+    [self didChangeTemplateAttributes];
+}
+
+- (void)setCellText:(NSString *)cellText
+{
+    _cellText = [cellText copy];
+    self.filterData = nil;
+    if (self.sizesRowHeightToCellText)
+        [self.tableViewModel invalidateHeightForRow:self];
+}
+
+- (void)setCellDetailText:(NSString *)cellDetailText
+{
+    _cellDetailText = [cellDetailText copy];
+    self.filterData = nil;
+    if (self.sizesRowHeightToCellText)
+        [self.tableViewModel invalidateHeightForRow:self];
+}
+
+- (void)setTableViewModel:(DXTableViewModel *)tableViewModel
+{
+    _tableViewModel = tableViewModel;
+    // rows edited before insertion are written back by updateRowObjects too
+    if (self.mutableModifiedBoundKeyPaths.count > 0)
+        [_tableViewModel rowDidModifyBoundData:self];
+}
+
+#pragma mark - Prepared content
+
+- (void)didChangeBoundData
+{
+    [self invalidatePreparedContent];
+    self.filterData = nil;
+}
+
+- (void)invalidatePreparedContent
+{
+    self.preparedContent = nil;
+    self.contentPrepared = NO;
+    self.preparedContentBlock = nil;
+    ++self.preparedContentToken;
+}
+
+// Content prepared with another block is stale, including when the block was replaced on template row
+- (BOOL)hasPreparedContent
+{
+    return self.contentPrepared && self.preparedContentBlock == self.prepareContentBlock;
+}
+
+- (void)setPreparedContent:(id)content preparedWithBlock:(id (^)(NSDictionary *))block
+{
+    self.preparedContent = content;
+    self.contentPrepared = YES;
+    self.preparedContentBlock = block;
+}
+
+- (id)preparedContentPreparingIfNeeded
+{
+    if (![self hasPreparedContent]) {
+        id (^block)(NSDictionary *) = self.prepareContentBlock;
+        [self setPreparedContent:block(self.boundObjectData.copy) preparedWithBlock:block];
+        ++self.preparedContentToken;
+    }
+    return self.preparedContent;
+}
+
+#pragma mark - Filter data
+
+// Rows are filtered with many queries between changes of their data, so the snapshot is kept until data changes
+- (NSDictionary *)filterData
+{
+    if (nil == _filterData) {
+        NSMutableDictionary *data = [self.boundObjectData mutableCopy];
+        if (nil != self.cellText && nil == data[@"cellText"])
+            data[@"cellText"] = self.cellText;
+        if (nil != self.cellDetailText && nil == data[@"cellDetailText"])
+            data[@"cellDetailText"] = self.cellDetailText;
+        _filterData = [data copy];
+    }
+    return _filterData;
+}
+
 #pragma mark - Data Bind Capabilities
 
 - (void)bindObject:(id)object withKeyPath:(NSString *)keyPath
@@ -101,12 +1071,96 @@
 - (void)bindObject:(id)object withKeyPaths:(NSArray *)keyPaths
 {
     [self willBindObject:object withKeyPaths:keyPaths];
+    [self stopObservingBoundObject];
     self.boundObject = object;
     self.boundKeyPaths = keyPaths;
+    self.boundAccessors = nil;
     [self reloadBoundData];
+    if (self.observesBoundObject)
+        [self startObservingBoundObject];
     [self didBindObject:self.boundObject withKeyPaths:self.boundKeyPaths];
 }
 
+#pragma mark - Bound object observing
+
+- (void)setObservesBoundObject:(BOOL)observesBoundObject
+{
+    _observesBoundObject = observesBoundObject;
+    if (observesBoundObject)
+        [self startObservingBoundObject];
+    else
+        [self stopObservingBoundObject];
+}
+
+- (void)startObservingBoundObject
+{
+    if (self.isObservingBoundObject || nil == self.boundObject)
+        return;
+    for (NSString *keyPath in self.boundKeyPaths)
+        [self.boundObject addObserver:self forKeyPath:keyPath options:0 context:DXTableViewRowBoundObjectObservingContext];
+    self.observingBoundObject = YES;
+}
+
+- (void)stopObservingBoundObject
+{
+    if (!self.isObservingBoundObject)
+        return;
+    for (NSString *keyPath in self.boundKeyPaths)
+        [self.boundObject removeObserver:self forKeyPath:keyPath context:DXTableViewRowBoundObjectObservingContext];
+    self.observingBoundObject = NO;
+    [self.changedBoundKeyPaths removeAllObjects];
+}
+
+- (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary *)change context:(void *)context
+{
+    if (context != DXTableViewRowBoundObjectObservingContext) {
+        [super observeValueForKeyPath:keyPath ofObject:object change:change context:context];
+        return;
+    }
+
+    if (![NSThread isMainThread]) {
+        __weak DXTableViewRow *weakSelf = self;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [weakSelf boundObjectDidChangeValueForKeyPath:keyPath];
+        });
+        return;
+    }
+    [self boundObjectDidChangeValueForKeyPath:keyPath];
+}
+
+- (void)boundObjectDidChangeValueForKeyPath:(NSString *)keyPath
+{
+    if (!self.isObservingBoundObject)
+        return;
+    if (nil == self.changedBoundKeyPaths)
+        self.changedBoundKeyPaths = [NSMutableSet set];
+    [self.changedBoundKeyPaths addObject:keyPath];
+
+    // rows outside of table view model have nobody to coalesce changes with
+    if (nil == self.tableViewModel)
+        [self reloadChangedBoundData];
+    else
+        [self.tableViewModel setNeedsReloadChangedBoundDataForRow:self];
+}
+
+- (BOOL)reloadChangedBoundData
+{
+    if (0 == self.changedBoundKeyPaths.count)
+        return NO;
+
+    NSSet *changedKeyPaths = self.changedBoundKeyPaths.copy;
+    [self.changedBoundKeyPaths removeAllObjects];
+    [self willReloadBoundData];
+    for (NSString *keyPath in changedKeyPaths) {
+        [self setBoundValue:[[self boundObjectValueForKeyPath:keyPath] copy] forKeyPath:keyPath];
+        [self.mutableModifiedBoundKeyPaths removeObject:keyPath];
+    }
+    [self.tableViewModel invalidateHeightForRow:self];
+    [self didReloadBoundData];
+    [self.section repositionRowIfNeeded:self];
+    return YES;
+}
+
 #pragma mark - Controls' handling
 
 - (void)becomeTargetOfControl:(UIControl *)control
@@ -158,6 +1212,13 @@
         cell.detailTextLabel.text = self.cellDetailText;
     if (nil != self.cellImage)
         cell.imageView.image = self.cellImage;
+    if (UITableViewCellAccessoryNone != self.cellAccessoryType)
+        cell.accessoryType = self.cellAccessoryType;
+    if (nil != self.cellImageKey && nil != self.cellImageLoader)
+        [self.tableViewModel loadCellImageForRow:self];
+
+    if (nil != self.prepareContentBlock && nil != self.applyContentBlock)
+        self.applyContentBlock(self, self.cell, [self preparedContentPreparingIfNeeded]);
 
     if (nil != self.configureCellBlock)
         self.configureCellBlock(self, self.cell);
@@ -169,16 +1230,30 @@
 {
     [self willReloadBoundData];
     for (NSString *keyPath in self.boundKeyPaths)
-        self[keyPath] = [[self.boundObject valueForKeyPath:keyPath] copy];
+        [self setBoundValue:[[self boundObjectValueForKeyPath:keyPath] copy] forKeyPath:keyPath];
+    [self.mutableModifiedBoundKeyPaths removeAllObjects];
+    [self.tableViewModel invalidateHeightForRow:self];
     [self didReloadBoundData];
+    [self.section repositionRowIfNeeded:self];
 }
 
 - (void)updateObject
 {
+    [self updateObjectReturningWrittenKeyPaths];
+}
+
+- (NSSet *)updateObjectReturningWrittenKeyPaths
+{
+    if (0 == self.mutableModifiedBoundKeyPaths.count)
+        return [NSSet set];
+
+    NSSet *modifiedKeyPaths = self.mutableModifiedBoundKeyPaths.copy;
+    [self.mutableModifiedBoundKeyPaths removeAllObjects];
     [self willUpdateObject];
-    for (NSString *keyPath in self.boundKeyPaths)
-        [self.boundObject setValue:self[keyPath] forKeyPath:keyPath];
+    for (NSString *keyPath in modifiedKeyPaths)
+        [self setBoundObjectValue:self[keyPath] forKeyPath:keyPath];
     [self didUpdateObject];
+    return modifiedKeyPaths;
 }
 
 #pragma mark - Subclass Hooks
@@ -239,8 +1314,68 @@
 
 - (void)setObject:(id)obj forKeyedSubscript:(id <NSCopying>)key
 {
-    if (nil != obj)
-        self.boundObjectData[key] = obj;
+    if (nil == obj)
+        return;
+
+    id oldValue = self.boundObjectData[key];
+    self.boundObjectData[key] = obj;
+    if ([oldValue isEqual:obj])
+        return;
+
+    [self didChangeBoundData];
+    if ([self.boundKeyPaths containsObject:key]) {
+        if (nil == self.mutableModifiedBoundKeyPaths)
+            self.mutableModifiedBoundKeyPaths = [NSMutableSet set];
+        [self.mutableModifiedBoundKeyPaths addObject:key];
+        [self.tableViewModel rowDidModifyBoundData:self];
+    }
+}
+
+- (void)setBoundValue:(id)value forKeyPath:(NSString *)keyPath
+{
+    if (nil != value) {
+        self.boundObjectData[keyPath] = value;
+        [self didChangeBoundData];
+    }
+}
+
+// uses object_getClass() rather than -class, so observed objects are updated via their KVO notifying setters
+- (DXTableViewRowKeyPathAccessor *)accessorForBoundKeyPath:(NSString *)keyPath ofObject:(id)object
+{
+    Class cls = object_getClass(object);
+    NSUInteger index = [self.boundKeyPaths indexOfObject:keyPath];
+    if (NSNotFound == index)
+        return [DXTableViewRowKeyPathAccessor accessorForClass:cls keyPath:keyPath];
+
+    if (cls != self.boundAccessorsClass || nil == self.boundAccessors) {
+        NSMutableArray *accessors = [NSMutableArray arrayWithCapacity:self.boundKeyPaths.count];
+        for (NSString *boundKeyPath in self.boundKeyPaths)
+            [accessors addObject:[DXTableViewRowKeyPathAccessor accessorForClass:cls keyPath:boundKeyPath]];
+        self.boundAccessors = accessors;
+        self.boundAccessorsClass = cls;
+    }
+    return self.boundAccessors[index];
+}
+
+- (id)boundObjectValueForKeyPath:(NSString *)keyPath
+{
+    id object = self.boundObject;
+    if (nil == object)
+        return nil;
+    return [[self accessorForBoundKeyPath:keyPath ofObject:object] valueOfObject:object];
+}
+
+- (void)setBoundObjectValue:(id)value forKeyPath:(NSString *)keyPath
+{
+    id object = self.boundObject;
+    if (nil == object)
+        return;
+    [[self accessorForBoundKeyPath:keyPath ofObject:object] setValue:value ofObject:object];
+}
+
+- (NSSet *)modifiedBoundKeyPaths
+{
+    return self.mutableModifiedBoundKeyPaths.copy ?: [NSSet set];
 }
 
 
@@ -52,6 +52,186 @@
  */
 - (instancetype)initWithName:(NSString *)name;
 
+/**
+ Returns row object located at the given `index` in the receiver's rows contents.
+
+ Unlike `rows` property this method doesn't copy the receiver's contents, so it is suitable for frequent calls
+ (e.g. from table view data source and delegate methods).
+
+ @param index The index of row object. Raises an `NSRangeException` if `index` is beyond the number of rows in the receiver.
+ */
+- (DXTableViewRow *)rowAtIndex:(NSInteger)index;
+
+/// @name Virtualized section
+#pragma mark - Virtualized section
+
+/**
+ Boolean value that indicates whether the receiver creates its rows on demand. Default is NO.
+
+ @see virtualizeWithNumberOfRows:rowBlock:
+ */
+@property (nonatomic, readonly, getter = isVirtualized) BOOL virtualized;
+
+/**
+ Maximum number of rows that virtualized receiver keeps materialized. Least recently used rows are evicted
+ when the limit is reached, rows whose cells are visible are never evicted. Default is 128.
+ */
+@property (nonatomic) NSUInteger maximumNumberOfMaterializedRows;
+
+/**
+ Turns the receiver into virtualized section with given number of rows. Rows are not created upfront, instead
+ `rowBlock` is invoked when row at particular index is requested (e.g. by table view data source methods), so memory
+ consumption is proportional to the number of visible rows rather than to `numberOfRows`.
+
+ `rowBlock` takes three parameters: `section` - the receiver, `index` - index of requested row and `reusableRow` - row
+ object that was evicted from the receiver, or `nil`. Block should return new row object or `reusableRow` configured
+ for the given `index`. Before eviction row's bound data is pushed into its bound object with `[DXTableViewRow updateObject]`.
+
+ Rows of virtualized section cannot be inserted, removed or moved with section's methods, `rows` property contains
+ no rows. Raises `NSInternalInconsistencyException` if the receiver already contains rows.
+
+ @param numberOfRows Number of rows in the receiver.
+ @param rowBlock A block object that returns row object for given index.
+ */
+- (void)virtualizeWithNumberOfRows:(NSInteger)numberOfRows
+                          rowBlock:(DXTableViewRow *(^)(DXTableViewSection *section, NSInteger index, DXTableViewRow *reusableRow))rowBlock;
+
+/**
+ Discards materialized rows of virtualized receiver and sets new number of rows.
+ Table view must be reloaded afterwards.
+
+ @param numberOfRows Number of rows in the receiver.
+ */
+- (void)reloadVirtualRowsWithNumberOfRows:(NSInteger)numberOfRows;
+
+/// @name Paged section
+#pragma mark - Paged section
+
+/**
+ Boolean value that indicates whether the receiver loads its rows page by page. Default is NO.
+
+ @see pageWithSize:prefetchDistance:loaderBlock:
+ */
+@property (nonatomic, readonly, getter = isPaged) BOOL paged;
+
+/**
+ Number of rows in every page of paged receiver except the last one.
+ */
+@property (nonatomic, readonly) NSInteger pageSize;
+
+/**
+ Boolean value that indicates whether loader of paged receiver has more pages to load.
+ */
+@property (nonatomic, readonly) BOOL hasMorePages;
+
+/**
+ Boolean value that indicates whether paged receiver waits for any page.
+ */
+@property (nonatomic, readonly, getter = isLoadingPages) BOOL loadingPages;
+
+/**
+ Maximum number of pages which rows paged receiver keeps. Pages farthest from displayed rows are replaced with
+ placeholder rows when the limit is exceeded and are loaded again once displayed. Default is 0, which means
+ no limit.
+
+ @see placeholderRowBlock
+ */
+@property (nonatomic) NSUInteger maximumNumberOfLoadedPages;
+
+/**
+ Block object which returns placeholder for the row of evicted page. Takes two parameters: `section` - the receiver,
+ `row` - the row being evicted. Default placeholder has the same cell class and height as evicted row.
+ */
+@property (copy, nonatomic) DXTableViewRow *(^placeholderRowBlock)(DXTableViewSection *section, DXTableViewRow *row);
+
+/**
+ Number of seconds after which page request that hasn't completed fails, its late completion is ignored.
+ Default is 30 seconds, 0 means requests never time out.
+
+ @see didFailToLoadPageBlock
+ */
+@property (nonatomic) NSTimeInterval pageLoadingTimeout;
+
+/**
+ Block object to be invoked on main queue when page request fails or times out. Takes two parameters: `section` - the
+ receiver, `pageIndex` - index of failed page. Failed page is requested again when its rows are displayed or
+ `loadNextPage` is called, e.g. from retry control shown by this block.
+ */
+@property (copy, nonatomic) void (^didFailToLoadPageBlock)(DXTableViewSection *section, NSInteger pageIndex);
+
+/**
+ Turns the receiver into paged section and requests the first page.
+
+ Next page is requested when table view displays or prefetches one of the last `prefetchDistance` rows. Only one
+ request per page is in flight at a time and the next page is requested only after the previous one arrived, so fast
+ scrolling doesn't pile up requests; once page arrives the receiver catches up with the latest displayed row. Every
+ page is appended with single batched insertion of rows. Evicted page which is loaded again with another number
+ of rows fills only positions it had, so rows of following pages keep their positions. Paged receiver isn't filtered
+ by `[DXTableViewModel filterRowsWithQuery:]`, so pages keep arriving while other sections are filtered.
+
+ @param pageSize Number of rows in every page except the last one.
+ @param prefetchDistance Number of rows from the end of loaded rows which being displayed triggers the next page.
+ @param loaderBlock A block object that loads page at `pageIndex` and invokes `completion` on any queue with rows of
+ the page and boolean value indicating whether the page is the last one. Passing `nil` rows reports that the page
+ failed to load, empty array ends the pages.
+ */
+- (void)pageWithSize:(NSInteger)pageSize
+    prefetchDistance:(NSInteger)prefetchDistance
+         loaderBlock:(void (^)(DXTableViewSection *section, NSInteger pageIndex, void (^completion)(NSArray *rows, BOOL lastPage)))loaderBlock;
+
+/**
+ Requests the next page of paged receiver unless it is being loaded or there are no more pages.
+ */
+- (void)loadNextPage;
+
+/**
+ Discards rows of paged receiver and pending pages and requests the first page again.
+ Table view must be reloaded afterwards.
+ */
+- (void)reloadPages;
+
+/**
+ Returns loader block which serves pages of `numberOfRows` rows created by `rowBlock` after `latency` seconds.
+ Stands in for remote page source, e.g. to exercise paged sections without network.
+
+ @param latency Delay before each page is completed.
+ @param numberOfRows Total number of rows served.
+ @param rowBlock A block object that returns row at given index.
+ */
++ (void (^)(DXTableViewSection *section, NSInteger pageIndex, void (^completion)(NSArray *rows, BOOL lastPage)))
+    pageLoaderWithLatency:(NSTimeInterval)latency
+             numberOfRows:(NSInteger)numberOfRows
+                 rowBlock:(DXTableViewRow *(^)(NSInteger index))rowBlock;
+
+/// @name Sorted section
+#pragma mark - Sorted section
+
+/**
+ Sort descriptors which keep the receiver's rows sorted. Keys of descriptors are looked up in rows' bound data as whole
+ keys, so value bound with key path `owner.name` is compared by key `owner.name`. Setting sort descriptors sorts rows
+ at once and moves them in table view. Default is `nil`.
+
+ While the receiver is sorted, rows can only be added with `addRow:`, `addRows:` or other methods which insert after
+ the last row, and go to their sorted positions, many rows added at once are sorted together with existing rows in one
+ pass. Insertion at other indexes raises an `NSInvalidArgumentException`, moving rows with `moveRow:toIndexPath:` or
+ `moveRow:animatedToIndexPath:` raises an `NSInternalInconsistencyException` and table view doesn't offer to reorder
+ rows of the receiver. Row whose bound data is reloaded is moved in table view to its new position if its order has
+ changed. Rows are not repositioned while
+ the receiver is filtered, they are sorted when filter is removed.
+
+ @see rowComparator
+ @see [DXTableViewRow reloadBoundData]
+ */
+@property (copy, nonatomic) NSArray *sortDescriptors;
+
+/**
+ Block object which compares two rows to keep the receiver's rows sorted. Takes precedence over `sortDescriptors`.
+ Setting comparator sorts rows at once and moves them in table view. Default is `nil`.
+
+ @see sortDescriptors
+ */
+@property (copy, nonatomic) NSComparisonResult (^rowComparator)(DXTableViewRow *row, DXTableViewRow *otherRow);
+
 /// @name Header and Footer support
 #pragma mark - Header and Footer support
 
@@ -158,6 +338,16 @@
  */
 @property (copy, nonatomic) void (^configureFooterBlock)(DXTableViewSection *section, id footerView);
 
+/**
+ Default `[DXTableViewRow prefetchBlock]` for rows of the receiver that don't provide their own. Default is `nil`.
+ */
+@property (copy, nonatomic) void (^prefetchRowBlock)(DXTableViewRow *row, void (^completion)(NSDictionary *prefetchedData));
+
+/**
+ Default `[DXTableViewRow cancelPrefetchBlock]` for rows of the receiver that don't provide their own. Default is `nil`.
+ */
+@property (copy, nonatomic) void (^cancelPrefetchRowBlock)(DXTableViewRow *row);
+
 #pragma mark - Header and Footer subclass hooks
 
 /**
@@ -219,6 +409,20 @@
  */
 - (NSIndexPath *)insertRow:(DXTableViewRow *)row atIndex:(NSInteger)index;
 
+/**
+ Inserts `rows` objects at the given `indexes` into the section's rows contents in one step and returns an array of
+ index path objects that represent locations of inserted rows in table view model and table view. Order of the given
+ `rows` is preserved. Cell classes and nibs are registered once for the whole batch.
+ If section object is not inserted to model, section value of index path objects is `NSNotFound`.
+
+ @param rows An array of `DXTableViewRow` objects to be inserted to section.
+ @param indexes The indexes at which to insert `rows` objects. The count of locations in `indexes` must equal
+ the count of `rows`. See `-[NSMutableArray insertObjects:atIndexes:]` for details.
+ Sorted section accepts only indexes following its last row, raises an `NSInvalidArgumentException` otherwise, and
+ inserts rows at their sorted positions.
+ */
+- (NSArray *)insertRows:(NSArray *)rows atIndexes:(NSIndexSet *)indexes;
+
 /**
  Removes given `row` object from section's rows contents and returns index path object that represents location
  of row in table view model and cell in table view. If section object is not inserted to model, section value of index path
@@ -250,7 +454,7 @@
 /**
  Moves `row` object to the given `destinationIndexPath` and returns array containing `row`s index path at the first position
  and `destinationIndexPath` at the second position. If section object is not inserted to model, section value of both index path
- objects is `NSNotFound`.
+ objects is `NSNotFound`. Raises an `NSInternalInconsistencyException` if the receiver is sorted.
  
  @param row The row object to be moved. Must be already inserted to section.
  @param destinationIndexPath Index path object that represents row that is destination of `row` object.
@@ -269,6 +473,17 @@
 /// @name Animated row manupulations
 #pragma mark Animated row manupulations
 
+/**
+ Inserts `rows` objects starting at the given `index` to the receiver and appropriate cells to
+ the associated table view with an option to animate the insertion. Order of the given `rows` is preserved and
+ the table view receives a single `insertRowsAtIndexPaths:withRowAnimation:` message for the whole batch.
+
+ @param rows An array of rows objects to be inserted in section.
+ @param index The index at which to insert first object of `rows`. This value must not be greater than the number of rows in section.
+ @param animation A constant that specifies type of animation when performing cells insertion.
+ */
+- (void)insertRows:(NSArray *)rows atIndex:(NSInteger)index withRowAnimation:(UITableViewRowAnimation)animation;
+
 /**
  Inserts `rows` objects starting at the index next to `otherRow` object to the receiver and appropriate cells to 
  the associated table view with an option to animate the insertion.
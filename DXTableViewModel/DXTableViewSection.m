@@ -9,6 +9,9 @@
 #import "DXTableViewSection.h"
 #import "DXTableViewModel.h"
 #import "DXTableViewRow.h"
+#import <objc/message.h>
+
+static NSUInteger DXTableViewSectionRowsGeneration = 0;
 
 /* TODO
  - add section wide row properties (or just use for..in and enumerateObjectsUsingBlock: on rows ?)
@@ -23,8 +26,36 @@
 
 @property (strong, nonatomic) DXTableViewModel *tableViewModel;
 @property (strong, nonatomic) DXTableViewSection *section;
+@property (nonatomic) NSInteger cachedRowIndex;
+@property (nonatomic) NSUInteger cachedRowIndexGeneration;
+@property (strong, nonatomic) NSIndexPath *cachedRowIndexPath;
+@property (strong, nonatomic) id cell;
+@property (strong, nonatomic, readonly) NSMutableDictionary *boundObjectData;
 
 - (void)registerNibOrClass;
+- (void)invalidatePreparedContent;
+
+@end
+
+@interface DXTableViewModel (ForTableViewSectionEyes)
+
+@property (nonatomic, readonly) NSUInteger sectionsGeneration;
+
+- (void)reindexSections;
+- (void)setNeedsRebuildHeightTree;
+- (void)section:(DXTableViewSection *)section didInsertRowAtIndex:(NSInteger)index;
+- (void)section:(DXTableViewSection *)section didRemoveRowAtIndex:(NSInteger)index;
+- (void)registerHeaderFooterNib:(UINib *)nib class:(Class)cls reuseIdentifier:(NSString *)reuseIdentifier;
+- (void)section:(DXTableViewSection *)section willChangeNameTo:(NSString *)newName;
+- (BOOL)deferUpdateWithRowAnimation:(UITableViewRowAnimation)animation;
+- (BOOL)deferUpdateOfRows:(NSArray *)rows withRowAnimation:(UITableViewRowAnimation)animation;
+- (void)reloadRowsOnEndUpdates:(NSArray *)rows;
+- (void)sectionWillChangeRows:(DXTableViewSection *)section;
+- (void)section:(DXTableViewSection *)section didInsertRows:(NSArray *)rows;
+- (void)sectionDidRemoveRows:(DXTableViewSection *)section;
+- (void)sectionDidChangeRows:(DXTableViewSection *)section;
+- (void)sectionDidChangeCallbacks:(DXTableViewSection *)section;
+- (void)discardPrefetchForRow:(DXTableViewRow *)row;
 
 @end
 
@@ -32,6 +63,36 @@
 
 @property (strong, nonatomic) DXTableViewModel *tableViewModel;
 @property (strong, nonatomic) NSMutableArray *mutableRows;
+@property (nonatomic) NSUInteger rowsGeneration;
+@property (nonatomic) NSInteger cachedSectionIndex;
+@property (nonatomic) NSUInteger cachedSectionIndexGeneration;
+
+@property (nonatomic) NSUInteger summarizedRowCallbacks;
+@property (nonatomic) CGFloat summarizedRowHeight;
+@property (nonatomic) BOOL rowCallbacksSummarized;
+@property (nonatomic) BOOL rowCallbacksSummaryExact;
+
+@property (nonatomic) BOOL paged;
+@property (nonatomic) NSInteger pageSize;
+@property (nonatomic) NSInteger pagePrefetchDistance;
+@property (copy, nonatomic) void (^pageLoaderBlock)(DXTableViewSection *section, NSInteger pageIndex, void (^completion)(NSArray *rows, BOOL lastPage));
+@property (nonatomic) NSInteger numberOfAppendedPages;
+@property (nonatomic) BOOL hasMorePages;
+@property (nonatomic) NSUInteger numberOfPageRequests;
+@property (strong, nonatomic) NSMutableDictionary *pageRequestByIndex;
+@property (nonatomic) NSInteger lastDisplayedRowIndex;
+@property (strong, nonatomic) NSMutableIndexSet *loadingPageIndexes;
+@property (strong, nonatomic) NSMutableIndexSet *evictedPageIndexes;
+
+@property (copy, nonatomic) NSArray *unfilteredRows;
+@property (copy, nonatomic) NSIndexSet *filteredRowIndexes;
+@property (nonatomic) BOOL needsSortingAfterFilter;
+
+@property (nonatomic) BOOL virtualized;
+@property (nonatomic) NSInteger virtualNumberOfRows;
+@property (copy, nonatomic) DXTableViewRow *(^virtualRowBlock)(DXTableViewSection *section, NSInteger index, DXTableViewRow *reusableRow);
+@property (strong, nonatomic) NSMutableDictionary *materializedRowByIndex;
+@property (strong, nonatomic) NSMutableOrderedSet *materializedRowIndexes;
 
 @property (strong, nonatomic) UIView *headerView;
 @property (strong, nonatomic) UIView *footerView;
@@ -47,6 +108,9 @@
         _sectionName = name;
         _headerHeight = UITableViewAutomaticDimension;
         _footerHeight = UITableViewAutomaticDimension;
+        _rowsGeneration = ++DXTableViewSectionRowsGeneration;
+        _maximumNumberOfMaterializedRows = 128;
+        _pageLoadingTimeout = 30.0;
     }
     return self;
 }
@@ -58,6 +122,14 @@
     return description;
 }
 
+- (void)setSectionName:(NSString *)sectionName
+{
+    if (_sectionName != sectionName && ![_sectionName isEqualToString:sectionName]) {
+        [_tableViewModel section:self willChangeNameTo:sectionName];
+        _sectionName = sectionName.copy;
+    }
+}
+
 - (NSMutableArray *)mutableRows
 {
     if (nil == _mutableRows) {
@@ -71,21 +143,310 @@
     return self.mutableRows.copy;
 }
 
+- (DXTableViewRow *)rowAtIndex:(NSInteger)index
+{
+    if (_virtualized)
+        return [self materializeRowAtIndex:index];
+    return self.mutableRows[index];
+}
+
+- (DXTableViewRow *)existingRowAtIndex:(NSInteger)index
+{
+    if (_virtualized)
+        return self.materializedRowByIndex[@(index)];
+    return self.mutableRows[index];
+}
+
+// Rows that exist now, materialized rows of virtualized section in no particular order
+- (NSArray *)existingRows
+{
+    if (_virtualized)
+        return self.materializedRowByIndex.allValues;
+    return self.mutableRows.copy;
+}
+
 - (NSInteger)numberOfRows
 {
+    if (_virtualized)
+        return _virtualNumberOfRows;
     return self.mutableRows.count;
 }
 
+- (void)raiseIfVirtualized
+{
+    if (_virtualized)
+        [NSException raise:NSInternalInconsistencyException format:@"rows of virtualized section \"%@\" cannot be altered", _sectionName];
+}
+
+- (void)raiseIfFiltered
+{
+    if (nil != _unfilteredRows)
+        [NSException raise:NSInternalInconsistencyException format:@"rows of filtered section \"%@\" cannot be altered", _sectionName];
+}
+
+- (void)raiseIfSorted
+{
+    if ([self sortsRows])
+        [NSException raise:NSInternalInconsistencyException format:@"rows of sorted section \"%@\" cannot be moved", _sectionName];
+}
+
+- (void)filterRowsAtIndexes:(NSIndexSet *)indexes
+{
+    [_tableViewModel sectionWillChangeRows:self];
+    if (nil == _unfilteredRows)
+        _unfilteredRows = self.mutableRows.copy;
+    _filteredRowIndexes = indexes.copy;
+    [self.mutableRows setArray:[_unfilteredRows objectsAtIndexes:indexes]];
+    [self invalidateRowIndexes];
+    [_tableViewModel sectionDidChangeRows:self];
+}
+
+// Returns YES if rows whose order changed while filtered have been sorted, their positions differ from unfiltered ones
+- (BOOL)removeRowFilter
+{
+    if (nil == _unfilteredRows)
+        return NO;
+    [_tableViewModel sectionWillChangeRows:self];
+    [self.mutableRows setArray:_unfilteredRows];
+    _unfilteredRows = nil;
+    _filteredRowIndexes = nil;
+    BOOL sorted = _needsSortingAfterFilter && [self sortsRows];
+    _needsSortingAfterFilter = NO;
+    if (sorted) {
+        [self.mutableRows sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(DXTableViewRow *row1, DXTableViewRow *row2) {
+            return [self compareRow:row1 toRow:row2];
+        }];
+    }
+    [self invalidateRowIndexes];
+    [_tableViewModel sectionDidChangeRows:self];
+    return sorted;
+}
+
+- (BOOL)sortsRows
+{
+    return nil != _rowComparator || 0 < _sortDescriptors.count;
+}
+
+- (void)setSortDescriptors:(NSArray *)sortDescriptors
+{
+    _sortDescriptors = sortDescriptors.copy;
+    [self sortRows];
+}
+
+- (void)setRowComparator:(NSComparisonResult (^)(DXTableViewRow *, DXTableViewRow *))rowComparator
+{
+    _rowComparator = [rowComparator copy];
+    [self sortRows];
+}
+
+// Bound data is keyed by whole key paths, so key of descriptor is looked up as one key rather than traversed with KVC
+static NSComparisonResult DXCompareBoundData(NSSortDescriptor *sortDescriptor, NSDictionary *data, NSDictionary *otherData)
+{
+    if (nil == sortDescriptor.key)
+        return [sortDescriptor compareObject:data toObject:otherData];
+
+    id value = data[sortDescriptor.key];
+    id otherValue = otherData[sortDescriptor.key];
+    NSComparisonResult res;
+    if (value == otherValue)
+        res = NSOrderedSame;
+    else if (nil == value)
+        res = NSOrderedAscending;
+    else if (nil == otherValue)
+        res = NSOrderedDescending;
+    else if (nil != sortDescriptor.comparator)
+        res = sortDescriptor.comparator(value, otherValue);
+    else
+        res = ((NSComparisonResult (*)(id, SEL, id))objc_msgSend)(value, sortDescriptor.selector, otherValue);
+    return sortDescriptor.ascending ? res : -res;
+}
+
+- (NSComparisonResult)compareRow:(DXTableViewRow *)row toRow:(DXTableViewRow *)otherRow
+{
+    if (nil != _rowComparator)
+        return _rowComparator(row, otherRow);
+    for (NSSortDescriptor *sortDescriptor in _sortDescriptors) {
+        NSComparisonResult res = DXCompareBoundData(sortDescriptor, row.boundObjectData, otherRow.boundObjectData);
+        if (NSOrderedSame != res)
+            return res;
+    }
+    return NSOrderedSame;
+}
+
+- (void)sortRows
+{
+    if (![self sortsRows] || 0 == self.mutableRows.count)
+        return;
+    [self raiseIfVirtualized];
+    // positions of filtered rows refer to unfiltered order, so rows are sorted when filter is removed
+    if (nil != _unfilteredRows) {
+        _needsSortingAfterFilter = YES;
+        return;
+    }
+    // table view receives moves of rows found by transaction diff, within caller's transaction if there is one
+    [_tableViewModel beginUpdates];
+    [_tableViewModel sectionWillChangeRows:self];
+    [self.mutableRows sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(DXTableViewRow *row1, DXTableViewRow *row2) {
+        return [self compareRow:row1 toRow:row2];
+    }];
+    [self invalidateRowIndexes];
+    [_tableViewModel endUpdates];
+}
+
+// Index after the last row which isn't ordered after `row`, so rows with equal keys keep their insertion order
+- (NSUInteger)sortedIndexForRow:(DXTableViewRow *)row
+{
+    return [self.mutableRows indexOfObject:row
+                             inSortedRange:NSMakeRange(0, self.mutableRows.count)
+                                   options:NSBinarySearchingInsertionIndex | NSBinarySearchingLastEqual
+                           usingComparator:^NSComparisonResult(DXTableViewRow *row1, DXTableViewRow *row2) {
+                               return [self compareRow:row1 toRow:row2];
+                           }];
+}
+
+- (void)insertSortedRows:(NSArray *)rows
+{
+    // few rows are binary inserted, many rows are sorted together with existing ones in one pass
+    if (rows.count * 8 < self.mutableRows.count) {
+        for (DXTableViewRow *row in rows)
+            [self.mutableRows insertObject:row atIndex:[self sortedIndexForRow:row]];
+        return;
+    }
+    [self.mutableRows addObjectsFromArray:rows];
+    [self.mutableRows sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(DXTableViewRow *row1, DXTableViewRow *row2) {
+        return [self compareRow:row1 toRow:row2];
+    }];
+}
+
+- (void)repositionRowIfNeeded:(DXTableViewRow *)row
+{
+    if (![self sortsRows] || _virtualized)
+        return;
+    if (nil != _unfilteredRows) {
+        _needsSortingAfterFilter = YES;
+        return;
+    }
+    NSInteger index = [self indexOfRow:row];
+    if (NSNotFound == index)
+        return;
+
+    NSInteger lastIndex = self.mutableRows.count - 1;
+    if ((0 == index || NSOrderedDescending != [self compareRow:self.mutableRows[index - 1] toRow:row]) &&
+        (lastIndex == index || NSOrderedDescending != [self compareRow:row toRow:self.mutableRows[index + 1]]))
+        return;
+
+    // destination is searched among other rows, which is where row ends up after the move
+    [self.mutableRows removeObjectAtIndex:index];
+    NSUInteger destination = [self sortedIndexForRow:row];
+    [self.mutableRows insertObject:row atIndex:index];
+    NSArray *indexPaths = [self relocateRow:row toIndexPath:[NSIndexPath indexPathForRow:destination inSection:self.sectionIndex]];
+    if (!self.tableViewModel.isUpdating)
+        [self.tableViewModel.tableView moveRowAtIndexPath:indexPaths[0] toIndexPath:indexPaths[1]];
+}
+
 - (NSInteger)sectionIndex
 {
-    return [self.tableViewModel indexOfSectionWithName:self.sectionName];
+    if (nil == _tableViewModel)
+        return NSNotFound;
+    if (_cachedSectionIndexGeneration != _tableViewModel.sectionsGeneration)
+        [_tableViewModel reindexSections];
+    return _cachedSectionIndex;
+}
+
+- (NSUInteger)sectionsGeneration
+{
+    return _tableViewModel.sectionsGeneration;
+}
+
+- (void)invalidateRowIndexes
+{
+    _rowsGeneration = ++DXTableViewSectionRowsGeneration;
+    [_tableViewModel setNeedsRebuildHeightTree];
+}
+
+- (void)setHeaderHeight:(CGFloat)headerHeight
+{
+    _headerHeight = headerHeight;
+    [_tableViewModel setNeedsRebuildHeightTree];
+    [_tableViewModel sectionDidChangeCallbacks:self];
+}
+
+- (void)setFooterHeight:(CGFloat)footerHeight
+{
+    _footerHeight = footerHeight;
+    [_tableViewModel setNeedsRebuildHeightTree];
+    [_tableViewModel sectionDidChangeCallbacks:self];
+}
+
+- (void)setHeaderReuseIdentifier:(NSString *)headerReuseIdentifier
+{
+    _headerReuseIdentifier = headerReuseIdentifier.copy;
+    [_tableViewModel sectionDidChangeCallbacks:self];
+}
+
+- (void)setFooterReuseIdentifier:(NSString *)footerReuseIdentifier
+{
+    _footerReuseIdentifier = footerReuseIdentifier.copy;
+    [_tableViewModel sectionDidChangeCallbacks:self];
+}
+
+- (void)setViewForHeaderInSectionBlock:(UIView *(^)(DXTableViewSection *))viewForHeaderInSectionBlock
+{
+    _viewForHeaderInSectionBlock = [viewForHeaderInSectionBlock copy];
+    [_tableViewModel sectionDidChangeCallbacks:self];
+}
+
+- (void)setViewForFooterInSectionBlock:(UIView *(^)(DXTableViewSection *))viewForFooterInSectionBlock
+{
+    _viewForFooterInSectionBlock = [viewForFooterInSectionBlock copy];
+    [_tableViewModel sectionDidChangeCallbacks:self];
+}
+
+- (void)setConfigureHeaderBlock:(void (^)(DXTableViewSection *, id))configureHeaderBlock
+{
+    _configureHeaderBlock = [configureHeaderBlock copy];
+    [_tableViewModel sectionDidChangeCallbacks:self];
+}
+
+- (void)setConfigureFooterBlock:(void (^)(DXTableViewSection *, id))configureFooterBlock
+{
+    _configureFooterBlock = [configureFooterBlock copy];
+    [_tableViewModel sectionDidChangeCallbacks:self];
+}
+
+- (void)setWillDisplayHeaderViewBlock:(void (^)(DXTableViewSection *, UIView *))willDisplayHeaderViewBlock
+{
+    _willDisplayHeaderViewBlock = [willDisplayHeaderViewBlock copy];
+    [_tableViewModel sectionDidChangeCallbacks:self];
+}
+
+- (void)setWillDisplayFooterViewBlock:(void (^)(DXTableViewSection *, UIView *))willDisplayFooterViewBlock
+{
+    _willDisplayFooterViewBlock = [willDisplayFooterViewBlock copy];
+    [_tableViewModel sectionDidChangeCallbacks:self];
+}
+
+- (void)reindexRows
+{
+    NSUInteger generation = _rowsGeneration;
+    [self.mutableRows enumerateObjectsUsingBlock:^(DXTableViewRow *row, NSUInteger index, BOOL *stop) {
+        row.cachedRowIndex = index;
+        row.cachedRowIndexGeneration = generation;
+    }];
+    [self.materializedRowByIndex enumerateKeysAndObjectsUsingBlock:^(NSNumber *key, DXTableViewRow *row, BOOL *stop) {
+        row.cachedRowIndex = key.integerValue;
+        row.cachedRowIndexGeneration = generation;
+    }];
 }
 
 - (void)setTableViewModel:(DXTableViewModel *)tableViewModel
 {
     if (_tableViewModel != tableViewModel) {
         _tableViewModel = tableViewModel;
-        for (DXTableViewRow *row in self.rows) {
+        for (DXTableViewRow *row in self.mutableRows) {
+            row.tableViewModel = _tableViewModel;
+        }
+        for (DXTableViewRow *row in self.materializedRowByIndex.allValues) {
             row.tableViewModel = _tableViewModel;
         }
     }
@@ -93,17 +454,376 @@
 
 - (void)registerNibOrClassForHeaderFooterNib:(UINib *)nib class:(Class)cls reuseIdentifier:(NSString *)reuseIdentifier
 {
-    if (nil != nib)
-        [self.tableViewModel.tableView registerNib:nib forHeaderFooterViewReuseIdentifier:reuseIdentifier];
-    else if (nil != cls)
-        [self.tableViewModel.tableView registerClass:cls forHeaderFooterViewReuseIdentifier:reuseIdentifier];
+    [self.tableViewModel registerHeaderFooterNib:nib class:cls reuseIdentifier:reuseIdentifier];
 }
 
-- (void)registerNibOrClassForRows
+- (void)registerNibOrClassForHeaderAndFooter
 {
     [self registerNibOrClassForHeaderFooterNib:self.headerNib class:self.headerClass reuseIdentifier:self.headerReuseIdentifier];
     [self registerNibOrClassForHeaderFooterNib:self.footerNib class:self.footerClass reuseIdentifier:self.footerReuseIdentifier];
-    [self.rows makeObjectsPerformSelector:@selector(registerNibOrClass)];
+}
+
+- (void)registerNibOrClassForRows
+{
+    [self registerNibOrClassForHeaderAndFooter];
+    [self.mutableRows makeObjectsPerformSelector:@selector(registerNibOrClass)];
+}
+
+#pragma mark - Virtualized section
+
+- (NSMutableDictionary *)materializedRowByIndex
+{
+    if (nil == _materializedRowByIndex) {
+        _materializedRowByIndex = [NSMutableDictionary dictionary];
+    }
+    return _materializedRowByIndex;
+}
+
+- (NSMutableOrderedSet *)materializedRowIndexes
+{
+    if (nil == _materializedRowIndexes) {
+        _materializedRowIndexes = [NSMutableOrderedSet orderedSet];
+    }
+    return _materializedRowIndexes;
+}
+
+- (void)virtualizeWithNumberOfRows:(NSInteger)numberOfRows
+                          rowBlock:(DXTableViewRow *(^)(DXTableViewSection *, NSInteger, DXTableViewRow *))rowBlock
+{
+    if (self.mutableRows.count > 0)
+        [NSException raise:NSInternalInconsistencyException format:@"section \"%@\" already contains rows", _sectionName];
+    self.virtualized = YES;
+    self.virtualRowBlock = rowBlock;
+    [self reloadVirtualRowsWithNumberOfRows:numberOfRows];
+}
+
+- (void)reloadVirtualRowsWithNumberOfRows:(NSInteger)numberOfRows
+{
+    [_tableViewModel sectionWillChangeRows:self];
+    for (DXTableViewRow *row in self.materializedRowByIndex.allValues)
+        [self detachMaterializedRow:row];
+    [self.materializedRowByIndex removeAllObjects];
+    [self.materializedRowIndexes removeAllObjects];
+    self.virtualNumberOfRows = numberOfRows;
+    [self invalidateRowIndexes];
+    [_tableViewModel sectionDidChangeRows:self];
+}
+
+- (DXTableViewRow *)materializeRowAtIndex:(NSInteger)index
+{
+    if (index < 0 || index >= _virtualNumberOfRows)
+        [NSException raise:NSRangeException format:@"index %ld beyond bounds [0 .. %ld]", (long)index, (long)_virtualNumberOfRows - 1];
+
+    NSNumber *key = @(index);
+    DXTableViewRow *row = self.materializedRowByIndex[key];
+    if (nil != row) {
+        [self.materializedRowIndexes removeObject:key];
+        [self.materializedRowIndexes addObject:key];
+        return row;
+    }
+
+    DXTableViewRow *reusableRow;
+    if (self.materializedRowIndexes.count >= MAX(_maximumNumberOfMaterializedRows, 1))
+        reusableRow = [self evictLeastRecentlyUsedRow];
+
+    row = self.virtualRowBlock(self, index, reusableRow);
+    row.tableViewModel = _tableViewModel;
+    row.section = self;
+    row.cachedRowIndex = index;
+    row.cachedRowIndexGeneration = _rowsGeneration;
+    [row registerNibOrClass];
+    self.materializedRowByIndex[key] = row;
+    [self.materializedRowIndexes addObject:key];
+    return row;
+}
+
+- (DXTableViewRow *)evictLeastRecentlyUsedRow
+{
+    NSArray *visibleIndexPaths = _tableViewModel.tableView.indexPathsForVisibleRows;
+    NSInteger sectionIndex = self.sectionIndex;
+    NSNumber *evictedKey;
+    for (NSNumber *key in self.materializedRowIndexes) {
+        NSIndexPath *indexPath = [NSIndexPath indexPathForRow:key.integerValue inSection:sectionIndex];
+        if (![visibleIndexPaths containsObject:indexPath]) {
+            evictedKey = key;
+            break;
+        }
+    }
+    if (nil == evictedKey)
+        return nil;
+
+    DXTableViewRow *row = self.materializedRowByIndex[evictedKey];
+    [self.materializedRowByIndex removeObjectForKey:evictedKey];
+    [self.materializedRowIndexes removeObject:evictedKey];
+    [self detachMaterializedRow:row];
+    return row;
+}
+
+- (void)detachMaterializedRow:(DXTableViewRow *)row
+{
+    if (nil != row.boundObject)
+        [row updateObject];
+    [_tableViewModel discardPrefetchForRow:row];
+    [_tableViewModel invalidateHeightForRow:row];
+    [row invalidatePreparedContent];
+    row.cell = nil;
+    row.cachedRowIndexPath = nil;
+    row.tableViewModel = nil;
+    row.section = nil;
+}
+
+#pragma mark - Paged section
+
+// Evicted pages which are loaded again at once, more are requested as earlier ones arrive
+static const NSUInteger DXTableViewSectionMaximumNumberOfReloadedPages = 2;
+
+- (NSMutableIndexSet *)loadingPageIndexes
+{
+    if (nil == _loadingPageIndexes) {
+        _loadingPageIndexes = [NSMutableIndexSet indexSet];
+    }
+    return _loadingPageIndexes;
+}
+
+- (NSMutableDictionary *)pageRequestByIndex
+{
+    if (nil == _pageRequestByIndex) {
+        _pageRequestByIndex = [NSMutableDictionary dictionary];
+    }
+    return _pageRequestByIndex;
+}
+
+- (NSMutableIndexSet *)evictedPageIndexes
+{
+    if (nil == _evictedPageIndexes) {
+        _evictedPageIndexes = [NSMutableIndexSet indexSet];
+    }
+    return _evictedPageIndexes;
+}
+
+- (BOOL)isLoadingPages
+{
+    return 0 < _loadingPageIndexes.count;
+}
+
+- (void)pageWithSize:(NSInteger)pageSize
+    prefetchDistance:(NSInteger)prefetchDistance
+         loaderBlock:(void (^)(DXTableViewSection *, NSInteger, void (^)(NSArray *, BOOL)))loaderBlock
+{
+    [self raiseIfVirtualized];
+    if (self.mutableRows.count > 0)
+        [NSException raise:NSInternalInconsistencyException format:@"section \"%@\" already contains rows", _sectionName];
+    if (pageSize < 1)
+        [NSException raise:NSInvalidArgumentException format:@"page size must be positive"];
+    self.paged = YES;
+    self.pageSize = pageSize;
+    self.pagePrefetchDistance = prefetchDistance;
+    self.pageLoaderBlock = loaderBlock;
+    [self reloadPages];
+}
+
+- (void)reloadPages
+{
+    if (!_paged)
+        return;
+    // completions of requests made before are ignored
+    [self.pageRequestByIndex removeAllObjects];
+    [_tableViewModel sectionWillChangeRows:self];
+    for (DXTableViewRow *row in self.mutableRows)
+        [self detachMaterializedRow:row];
+    [self.mutableRows removeAllObjects];
+    [self.loadingPageIndexes removeAllIndexes];
+    [self.evictedPageIndexes removeAllIndexes];
+    self.numberOfAppendedPages = 0;
+    self.hasMorePages = YES;
+    self.lastDisplayedRowIndex = 0;
+    [self invalidateRowIndexes];
+    [_tableViewModel sectionDidChangeRows:self];
+    [self loadNextPage];
+}
+
+- (void)loadNextPage
+{
+    if (!_paged || !_hasMorePages)
+        return;
+    [self loadPageAtIndex:_numberOfAppendedPages];
+}
+
+- (void)loadPagesNearRowAtIndex:(NSInteger)index
+{
+    if (!_paged)
+        return;
+    self.lastDisplayedRowIndex = index;
+    NSInteger pageIndex = index / _pageSize;
+    if ([_evictedPageIndexes containsIndex:pageIndex] &&
+        self.loadingPageIndexes.count < DXTableViewSectionMaximumNumberOfReloadedPages)
+        [self loadPageAtIndex:pageIndex];
+    if (index >= (NSInteger)self.mutableRows.count - _pagePrefetchDistance)
+        [self loadNextPage];
+}
+
+- (void)loadPageAtIndex:(NSInteger)pageIndex
+{
+    // page that is already requested is not requested again, e.g. when display and prefetch signals overlap
+    if ([self.loadingPageIndexes containsIndex:pageIndex])
+        return;
+    [self.loadingPageIndexes addIndex:pageIndex];
+
+    NSNumber *request = @(++_numberOfPageRequests);
+    self.pageRequestByIndex[@(pageIndex)] = request;
+    __weak DXTableViewSection *weakSelf = self;
+    self.pageLoaderBlock(self, pageIndex, ^(NSArray *rows, BOOL lastPage) {
+        void (^didLoadPage)(void) = ^{
+            [weakSelf didLoadPageAtIndex:pageIndex rows:rows lastPage:lastPage request:request];
+        };
+        if ([NSThread isMainThread])
+            didLoadPage();
+        else
+            dispatch_async(dispatch_get_main_queue(), didLoadPage);
+    });
+    // request that never completes would hold the page forever, so it fails after timeout
+    if (0 < _pageLoadingTimeout && [self.loadingPageIndexes containsIndex:pageIndex]) {
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(_pageLoadingTimeout * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+            [weakSelf didLoadPageAtIndex:pageIndex rows:nil lastPage:NO request:request];
+        });
+    }
+}
+
+- (void)didLoadPageAtIndex:(NSInteger)pageIndex rows:(NSArray *)rows lastPage:(BOOL)lastPage request:(NSNumber *)request
+{
+    // pages were reloaded, or request timed out, meanwhile
+    if (![self.pageRequestByIndex[@(pageIndex)] isEqualToNumber:request])
+        return;
+    [self.pageRequestByIndex removeObjectForKey:@(pageIndex)];
+    [self.loadingPageIndexes removeIndex:pageIndex];
+
+    // failed page is requested again when its rows are displayed, or the next page is asked for
+    if (nil == rows) {
+        if (nil != self.didFailToLoadPageBlock)
+            self.didFailToLoadPageBlock(self, pageIndex);
+        return;
+    }
+
+    if (pageIndex == _numberOfAppendedPages) {
+        ++self.numberOfAppendedPages;
+        self.hasMorePages = !lastPage && rows.count > 0;
+        if (rows.count > 0)
+            [self insertRows:rows atIndex:self.mutableRows.count withRowAnimation:UITableViewRowAnimationNone];
+    }
+    else if ([self.evictedPageIndexes containsIndex:pageIndex]) {
+        [self.evictedPageIndexes removeIndex:pageIndex];
+        [self reloadRows:[self replaceRowsOfPageAtIndex:pageIndex withRows:rows] withRowAnimation:UITableViewRowAnimationNone];
+    }
+
+    [self evictFarPagesIfNeeded];
+    // scrolling went on while page was loading
+    [self loadPagesNearRowAtIndex:_lastDisplayedRowIndex];
+}
+
+- (NSRange)rangeOfPageAtIndex:(NSInteger)pageIndex
+{
+    NSInteger location = pageIndex * _pageSize;
+    return NSMakeRange(location, MIN(_pageSize, (NSInteger)self.mutableRows.count - location));
+}
+
+// Page which comes back with another number of rows fills only positions it had, so following pages keep theirs:
+// extra rows are dropped and missing ones keep their current rows. Returns rows which have been put into the receiver.
+- (NSArray *)replaceRowsOfPageAtIndex:(NSInteger)pageIndex withRows:(NSArray *)rows
+{
+    NSRange range = [self rangeOfPageAtIndex:pageIndex];
+    if (rows.count > range.length)
+        rows = [rows subarrayWithRange:NSMakeRange(0, range.length)];
+    else
+        range.length = rows.count;
+
+    [_tableViewModel sectionWillChangeRows:self];
+    NSArray *replacedRows = [self.mutableRows subarrayWithRange:range];
+    for (DXTableViewRow *row in rows) {
+        row.tableViewModel = _tableViewModel;
+        row.section = self;
+        [row registerNibOrClass];
+    }
+    [self.mutableRows replaceObjectsInRange:range withObjectsFromArray:rows];
+    [self invalidateRowIndexes];
+    [_tableViewModel sectionDidChangeRows:self];
+    for (DXTableViewRow *row in replacedRows)
+        [self detachMaterializedRow:row];
+    return rows;
+}
+
+- (DXTableViewRow *)placeholderForRow:(DXTableViewRow *)row
+{
+    if (nil != self.placeholderRowBlock)
+        return self.placeholderRowBlock(self, row);
+
+    DXTableViewRow *placeholder;
+    if (nil != row.templateRow) {
+        placeholder = [[DXTableViewRow alloc] initWithTemplateRow:row.templateRow];
+    }
+    else {
+        placeholder = [[DXTableViewRow alloc] initWithCellReuseIdentifier:row.cellReuseIdentifier];
+        placeholder.cellClass = row.cellClass;
+        placeholder.cellNib = row.cellNib;
+    }
+    // keeps content height, so scroll position doesn't jump
+    if (nil != _tableViewModel)
+        placeholder.rowHeight = [_tableViewModel heightForRow:row];
+    return placeholder;
+}
+
+- (void)evictPageAtIndex:(NSInteger)pageIndex
+{
+    NSRange range = [self rangeOfPageAtIndex:pageIndex];
+    NSMutableArray *placeholders = [NSMutableArray arrayWithCapacity:range.length];
+    for (DXTableViewRow *row in [self.mutableRows subarrayWithRange:range])
+        [placeholders addObject:[self placeholderForRow:row]];
+    // table view keeps cells and heights of evicted rows until it's told to reload them
+    [self reloadRows:[self replaceRowsOfPageAtIndex:pageIndex withRows:placeholders] withRowAnimation:UITableViewRowAnimationNone];
+    [self.evictedPageIndexes addIndex:pageIndex];
+}
+
+- (void)evictFarPagesIfNeeded
+{
+    if (0 == _maximumNumberOfLoadedPages)
+        return;
+
+    NSInteger currentPageIndex = _lastDisplayedRowIndex / _pageSize;
+    NSMutableIndexSet *visiblePageIndexes = [NSMutableIndexSet indexSetWithIndex:currentPageIndex];
+    NSInteger sectionIndex = self.sectionIndex;
+    for (NSIndexPath *indexPath in _tableViewModel.tableView.indexPathsForVisibleRows) {
+        if (indexPath.section == sectionIndex)
+            [visiblePageIndexes addIndex:indexPath.row / _pageSize];
+    }
+
+    NSMutableIndexSet *loadedPageIndexes = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(0, _numberOfAppendedPages)];
+    [loadedPageIndexes removeIndexes:self.evictedPageIndexes];
+    while (loadedPageIndexes.count > _maximumNumberOfLoadedPages) {
+        // farthest page is either the first or the last loaded one
+        NSInteger firstPageIndex = loadedPageIndexes.firstIndex;
+        NSInteger lastPageIndex = loadedPageIndexes.lastIndex;
+        NSInteger pageIndex = currentPageIndex - firstPageIndex > lastPageIndex - currentPageIndex ? firstPageIndex : lastPageIndex;
+        if ([visiblePageIndexes containsIndex:pageIndex])
+            break;
+        [self evictPageAtIndex:pageIndex];
+        [loadedPageIndexes removeIndex:pageIndex];
+    }
+}
+
++ (void (^)(DXTableViewSection *, NSInteger, void (^)(NSArray *, BOOL)))pageLoaderWithLatency:(NSTimeInterval)latency
+                                                                                  numberOfRows:(NSInteger)numberOfRows
+                                                                                      rowBlock:(DXTableViewRow *(^)(NSInteger))rowBlock
+{
+    return ^(DXTableViewSection *section, NSInteger pageIndex, void (^completion)(NSArray *, BOOL)) {
+        NSInteger pageSize = section.pageSize;
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(latency * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+            NSInteger start = MIN(pageIndex * pageSize, numberOfRows);
+            NSInteger end = MIN(start + pageSize, numberOfRows);
+            NSMutableArray *rows = [NSMutableArray arrayWithCapacity:end - start];
+            for (NSInteger index = start; index < end; ++index)
+                [rows addObject:rowBlock(index)];
+            completion(rows, end == numberOfRows);
+        });
+    };
 }
 
 #pragma mark - Header and Footer subclass hooks
@@ -123,7 +843,7 @@
 - (DXTableViewRow *)nextRowWithIdentifier:(NSString *)identifier greaterRowIndexThan:(NSInteger)index
 {
     __block DXTableViewRow *res;
-    [self.rows enumerateObjectsUsingBlock:^(DXTableViewRow *row, NSUInteger anIndex, BOOL *stop) {
+    [self.mutableRows enumerateObjectsUsingBlock:^(DXTableViewRow *row, NSUInteger anIndex, BOOL *stop) {
         BOOL hasGivenIdentifier = [row.cellReuseIdentifier isEqualToString:identifier];
         BOOL hasIndexGreaterThatGivenIndex = (NSInteger)anIndex > index;
         if (hasGivenIdentifier && hasIndexGreaterThatGivenIndex) {
@@ -141,15 +861,16 @@
 
 - (NSInteger)indexOfRow:(DXTableViewRow *)row
 {
-    return [self.mutableRows indexOfObject:row];
+    if (row.section != self)
+        return NSNotFound;
+    if (row.cachedRowIndexGeneration != _rowsGeneration)
+        [self reindexRows];
+    return row.cachedRowIndex;
 }
 
 - (NSIndexPath *)indexPathForRow:(DXTableViewRow *)row
 {
-    NSInteger sectionIndex = NSNotFound;
-    if (nil != _tableViewModel)
-        sectionIndex = [_tableViewModel indexOfSectionWithName:_sectionName];
-
+    NSInteger sectionIndex = self.sectionIndex;
     NSInteger rowIndex = [self indexOfRow:row];
     NSIndexPath *res = [NSIndexPath indexPathForRow:rowIndex inSection:sectionIndex];
     return res;
@@ -162,19 +883,60 @@
 
 - (NSIndexPath *)insertRow:(DXTableViewRow *)row atIndex:(NSInteger)index
 {
-    row.tableViewModel = _tableViewModel;
-    row.section = self;
-    [self.mutableRows insertObject:row atIndex:index];
-    [self registerNibOrClassForRows];
-    return [self indexPathForRow:row];
+    return [[self insertRows:@[row] atIndexes:[NSIndexSet indexSetWithIndex:index]] firstObject];
+}
+
+- (NSArray *)insertRows:(NSArray *)rows atIndexes:(NSIndexSet *)indexes
+{
+    [self raiseIfVirtualized];
+    [self raiseIfFiltered];
+    // position in sorted section is decided by its order, so only indexes following the last row are accepted
+    if ([self sortsRows] &&
+        ![indexes isEqualToIndexSet:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(self.mutableRows.count, rows.count)]])
+        [NSException raise:NSInvalidArgumentException
+                    format:@"rows of sorted section \"%@\" can only be added, they are placed at their sorted positions", _sectionName];
+    [_tableViewModel sectionWillChangeRows:self];
+    for (DXTableViewRow *row in rows) {
+        row.tableViewModel = _tableViewModel;
+        row.section = self;
+    }
+    if ([self sortsRows])
+        [self insertSortedRows:rows];
+    else
+        [self.mutableRows insertObjects:rows atIndexes:indexes];
+    if (1 == rows.count) {
+        _rowsGeneration = ++DXTableViewSectionRowsGeneration;
+        NSUInteger index = [self sortsRows] ? [self.mutableRows indexOfObjectIdenticalTo:rows.firstObject] : indexes.firstIndex;
+        [_tableViewModel section:self didInsertRowAtIndex:index];
+    }
+    else {
+        [self invalidateRowIndexes];
+    }
+    // rows which were already in section are registered
+    [self registerNibOrClassForHeaderAndFooter];
+    [rows makeObjectsPerformSelector:@selector(registerNibOrClass)];
+    [_tableViewModel section:self didInsertRows:rows];
+
+    NSMutableArray *indexPaths = [NSMutableArray arrayWithCapacity:rows.count];
+    for (DXTableViewRow *row in rows)
+        [indexPaths addObject:[self indexPathForRow:row]];
+    return indexPaths.copy;
 }
 
 - (NSIndexPath *)removeRow:(DXTableViewRow *)row
 {
+    [self raiseIfVirtualized];
+    [self raiseIfFiltered];
     NSIndexPath *res = [self indexPathForRow:row];
+    if (NSNotFound == res.row)
+        return res;
+    [_tableViewModel sectionWillChangeRows:self];
+    [self.mutableRows removeObjectAtIndex:res.row];
     row.tableViewModel = nil;
     row.section = nil;
-    [self.mutableRows removeObject:row];
+    _rowsGeneration = ++DXTableViewSectionRowsGeneration;
+    [_tableViewModel section:self didRemoveRowAtIndex:res.row];
+    [_tableViewModel sectionDidRemoveRows:self];
     return res;
 }
 
@@ -194,10 +956,21 @@
 
 - (NSArray *)moveRow:(DXTableViewRow *)row toIndexPath:(NSIndexPath *)destinationIndexPath
 {
+    [self raiseIfSorted];
+    return [self relocateRow:row toIndexPath:destinationIndexPath];
+}
+
+// Moves row without checking order, sorted section moves its rows to their sorted positions this way
+- (NSArray *)relocateRow:(DXTableViewRow *)row toIndexPath:(NSIndexPath *)destinationIndexPath
+{
+    [self raiseIfVirtualized];
+    [self raiseIfFiltered];
     NSIndexPath *indexPath = [self indexPathForRow:row];
 
-    [self.mutableRows removeObject:row];
+    [_tableViewModel sectionWillChangeRows:self];
+    [self.mutableRows removeObjectAtIndex:indexPath.row];
     [self.mutableRows insertObject:row atIndex:destinationIndexPath.row];
+    [self invalidateRowIndexes];
 
     return @[indexPath, destinationIndexPath];
 }
@@ -207,62 +980,64 @@
 
 - (void)addRows:(NSArray *)rows
 {
-    for (DXTableViewRow *row in rows)
-        [self addRow:row];
+    NSIndexSet *indexes = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(self.mutableRows.count, rows.count)];
+    [self insertRows:rows atIndexes:indexes];
 }
 
 #pragma mark Animated row manupulations
 
+- (void)insertRows:(NSArray *)rows atIndex:(NSInteger)index withRowAnimation:(UITableViewRowAnimation)animation
+{
+    NSIndexSet *indexes = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(index, rows.count)];
+    NSArray *indexPaths = [self insertRows:rows atIndexes:indexes];
+    if (![self.tableViewModel deferUpdateOfRows:rows withRowAnimation:animation])
+        [self.tableViewModel.tableView insertRowsAtIndexPaths:indexPaths withRowAnimation:animation];
+}
+
 - (void)insertRows:(NSArray *)rows afterRow:(DXTableViewRow *)row withRowAnimation:(UITableViewRowAnimation)animation
 {
-    NSMutableArray *indexPaths = [NSMutableArray array];
-    for (DXTableViewRow *aRow in rows) {
-        // TODO: insert whole array at once, inserting element by element changes the order
-        if (nil != row) {
-            [indexPaths addObject:[self insertRow:aRow afterRow:row]];
-        } else {
-            [indexPaths addObject:[self insertRow:aRow atIndex:self.numberOfRows]];
-        }
-    }
-    [self.tableViewModel.tableView insertRowsAtIndexPaths:indexPaths withRowAnimation:animation];
+    NSInteger index = nil != row ? [self indexOfRow:row] + 1 : self.numberOfRows;
+    [self insertRows:rows atIndex:index withRowAnimation:animation];
 }
 
 - (void)insertRows:(NSArray *)rows beforeRow:(DXTableViewRow *)row withRowAnimation:(UITableViewRowAnimation)animation
 {
-    NSMutableArray *indexPaths = [NSMutableArray array];
-    for (DXTableViewRow *aRow in rows) {
-        // TODO: insert whole array at once, inserting element by element changes the order
-        if (nil != row) {
-            [indexPaths addObject:[self insertRow:aRow beforeRow:row]];
-        } else {
-            [indexPaths addObject:[self insertRow:aRow atIndex:0]];
-        }
-    }
-    [self.tableViewModel.tableView insertRowsAtIndexPaths:indexPaths withRowAnimation:animation];
+    NSInteger index = nil != row ? [self indexOfRow:row] : 0;
+    [self insertRows:rows atIndex:index withRowAnimation:animation];
 }
 
 - (void)deleteRows:(NSArray *)rows withRowAnimation:(UITableViewRowAnimation)animation
 {
+    // index paths are taken before any row is removed, as table view expects
     NSMutableArray *indexPaths = [NSMutableArray array];
     for (DXTableViewRow *aRow in rows) {
-        [indexPaths addObject:[self removeRow:aRow]];
+        [indexPaths addObject:[self indexPathForRow:aRow]];
+    }
+    for (DXTableViewRow *aRow in rows) {
+        [self removeRow:aRow];
     }
-    [self.tableViewModel.tableView deleteRowsAtIndexPaths:indexPaths withRowAnimation:animation];
+    if (![self.tableViewModel deferUpdateOfRows:rows withRowAnimation:animation])
+        [self.tableViewModel.tableView deleteRowsAtIndexPaths:indexPaths withRowAnimation:animation];
 }
 
 - (void)reloadRows:(NSArray *)rows withRowAnimation:(UITableViewRowAnimation)animation
 {
     NSMutableArray *indexPaths = [NSMutableArray array];
     for (DXTableViewRow *aRow in rows) {
+        [self.tableViewModel invalidateHeightForRow:aRow];
         [indexPaths addObject:[self indexPathForRow:aRow]];
     }
-    [self.tableViewModel.tableView reloadRowsAtIndexPaths:indexPaths withRowAnimation:animation];
+    if ([self.tableViewModel deferUpdateOfRows:rows withRowAnimation:animation])
+        [self.tableViewModel reloadRowsOnEndUpdates:rows];
+    else
+        [self.tableViewModel.tableView reloadRowsAtIndexPaths:indexPaths withRowAnimation:animation];
 }
 
 - (void)moveRow:(DXTableViewRow *)row animatedToIndexPath:(NSIndexPath *)destinationIndexPath
 {
     NSArray *indexPaths = [self moveRow:row toIndexPath:destinationIndexPath];
-    [self.tableViewModel.tableView moveRowAtIndexPath:indexPaths[0] toIndexPath:indexPaths[1]];
+    if (!self.tableViewModel.isUpdating)
+        [self.tableViewModel.tableView moveRowAtIndexPath:indexPaths[0] toIndexPath:indexPaths[1]];
 }
 
 @end
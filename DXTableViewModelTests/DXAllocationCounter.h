@@ -0,0 +1,48 @@
+//
+//  DXAllocationCounter.h
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/** Counts Objective-C objects allocated and arrays copied on the main thread while counting is on.
+
+ Counter replaces `+[NSObject allocWithZone:]` and copy methods of mutable arrays on first use,
+ so objects created by Core Foundation functions and by C code are not counted.
+ */
+@interface DXAllocationCounter : NSObject
+
+/** Whether allocations are counted now. Stub table view turns counting on only inside of callbacks.
+ */
++ (BOOL)isCounting;
++ (void)setCounting:(BOOL)counting;
+
+/** Number of objects allocated since last reset.
+ */
++ (NSUInteger)allocationCount;
+
+/** Number of copies and mutable copies of arrays made since last reset.
+ */
++ (NSUInteger)arrayCopyCount;
+
+/** Resets both counters.
+ */
++ (void)reset;
+
+/** Peak resident memory of the process in bytes.
+ */
++ (uint64_t)peakResidentMemory;
+
+/** Resident memory of the process in bytes.
+ */
++ (uint64_t)residentMemory;
+
+/** Bytes currently allocated with malloc in all zones. Unlike resident memory it changes with every allocation,
+ so it measures small data structures exactly.
+ */
++ (uint64_t)allocatedMemory;
+
+@end
@@ -0,0 +1,137 @@
+//
+//  DXAllocationCounter.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import "DXAllocationCounter.h"
+#import <objc/runtime.h>
+#import <mach/mach.h>
+#import <pthread.h>
+#import <malloc/malloc.h>
+
+static BOOL DXAllocationCounterCounting = NO;
+static NSUInteger DXAllocationCounterAllocations = 0;
+static NSUInteger DXAllocationCounterArrayCopies = 0;
+
+static id (*DXOriginalAllocWithZone)(id, SEL, NSZone *);
+static id (*DXOriginalArrayCopyWithZone)(id, SEL, NSZone *);
+static id (*DXOriginalArrayMutableCopyWithZone)(id, SEL, NSZone *);
+
+static inline BOOL DXAllocationCounterShouldCount(void)
+{
+    return DXAllocationCounterCounting && pthread_main_np();
+}
+
+static id DXCountingAllocWithZone(id self, SEL _cmd, NSZone *zone)
+{
+    if (DXAllocationCounterShouldCount())
+        DXAllocationCounterAllocations++;
+    return DXOriginalAllocWithZone(self, _cmd, zone);
+}
+
+static id DXCountingArrayCopyWithZone(id self, SEL _cmd, NSZone *zone)
+{
+    if (DXAllocationCounterShouldCount())
+        DXAllocationCounterArrayCopies++;
+    return DXOriginalArrayCopyWithZone(self, _cmd, zone);
+}
+
+static id DXCountingArrayMutableCopyWithZone(id self, SEL _cmd, NSZone *zone)
+{
+    if (DXAllocationCounterShouldCount())
+        DXAllocationCounterArrayCopies++;
+    return DXOriginalArrayMutableCopyWithZone(self, _cmd, zone);
+}
+
+// Adds counting implementation to class itself, so implementation of superclass stays intact
+static IMP DXReplaceInstanceMethod(Class aClass, SEL selector, IMP implementation)
+{
+    Method method = class_getInstanceMethod(aClass, selector);
+    IMP original = method_getImplementation(method);
+    if (!class_addMethod(aClass, selector, implementation, method_getTypeEncoding(method)))
+        method_setImplementation(method, implementation);
+    return original;
+}
+
+@implementation DXAllocationCounter
+
++ (void)install
+{
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        Method method = class_getClassMethod([NSObject class], @selector(allocWithZone:));
+        DXOriginalAllocWithZone = (id (*)(id, SEL, NSZone *))method_setImplementation(method, (IMP)DXCountingAllocWithZone);
+        // mutable arrays of sections and rows belong to private concrete class
+        Class arrayClass = [[NSMutableArray array] class];
+        DXOriginalArrayCopyWithZone = (id (*)(id, SEL, NSZone *))
+            DXReplaceInstanceMethod(arrayClass, @selector(copyWithZone:), (IMP)DXCountingArrayCopyWithZone);
+        DXOriginalArrayMutableCopyWithZone = (id (*)(id, SEL, NSZone *))
+            DXReplaceInstanceMethod(arrayClass, @selector(mutableCopyWithZone:), (IMP)DXCountingArrayMutableCopyWithZone);
+    });
+}
+
++ (BOOL)isCounting
+{
+    return DXAllocationCounterCounting;
+}
+
++ (void)setCounting:(BOOL)counting
+{
+    if (counting)
+        [self install];
+    DXAllocationCounterCounting = counting;
+}
+
++ (NSUInteger)allocationCount
+{
+    return DXAllocationCounterAllocations;
+}
+
++ (NSUInteger)arrayCopyCount
+{
+    return DXAllocationCounterArrayCopies;
+}
+
++ (void)reset
+{
+    DXAllocationCounterAllocations = 0;
+    DXAllocationCounterArrayCopies = 0;
+}
+
++ (uint64_t)peakResidentMemory
+{
+    struct mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (KERN_SUCCESS != task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count))
+        return 0;
+    return info.resident_size_max;
+}
+
++ (uint64_t)residentMemory
+{
+    struct mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (KERN_SUCCESS != task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count))
+        return 0;
+    return info.resident_size;
+}
+
++ (uint64_t)allocatedMemory
+{
+    vm_address_t *zones;
+    unsigned int zoneCount;
+    if (KERN_SUCCESS != malloc_get_all_zones(mach_task_self(), NULL, &zones, &zoneCount))
+        return 0;
+    uint64_t size = 0;
+    for (unsigned int i = 0; i < zoneCount; ++i) {
+        malloc_statistics_t statistics;
+        malloc_zone_statistics((malloc_zone_t *)zones[i], &statistics);
+        size += statistics.size_in_use;
+    }
+    return size;
+}
+
+@end
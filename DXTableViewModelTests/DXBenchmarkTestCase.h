@@ -0,0 +1,28 @@
+//
+//  DXBenchmarkTestCase.h
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+/** Base class of tests that check measured metrics against baselines stored in DXBenchmarkBaselines.plist.
+
+ Baselines file maps benchmark names to dictionaries of metric values. Metric regresses when it exceeds its baseline
+ by more than tolerance given for the metric in `Tolerances` dictionary of the file, count metrics without
+ tolerance have to match their baselines or be less. Set `DX_RECORD_BASELINES` environment variable
+ to write measured values into baselines file of the source tree instead of checking them.
+ */
+@interface DXBenchmarkTestCase : XCTestCase
+
+/** Fails the test when value regresses beyond baseline of given metric of given benchmark.
+ */
+- (void)checkMetric:(NSString *)metric value:(double)value benchmark:(NSString *)benchmark;
+
+/** Returns nanoseconds of one invocation of block averaged over given number of iterations.
+ */
+- (double)nanosecondsPerIteration:(NSUInteger)iterations ofBlock:(void (^)(void))block;
+
+@end
@@ -0,0 +1,75 @@
+//
+//  DXBenchmarkTestCase.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import "DXBenchmarkTestCase.h"
+#import <mach/mach_time.h>
+
+static NSDictionary *DXBenchmarkBaselines(void)
+{
+    static NSDictionary *baselines;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString *path = [[NSBundle bundleForClass:[DXBenchmarkTestCase class]]
+                          pathForResource:@"DXBenchmarkBaselines" ofType:@"plist"];
+        baselines = [NSDictionary dictionaryWithContentsOfFile:path];
+    });
+    return baselines;
+}
+
+// Baselines file of the source tree, simulator shares file system with the machine that builds tests
+static NSString *DXBenchmarkBaselinesSourcePath(void)
+{
+    return [[@(__FILE__) stringByDeletingLastPathComponent] stringByAppendingPathComponent:@"DXBenchmarkBaselines.plist"];
+}
+
+static void DXRecordBaseline(NSString *benchmark, NSString *metric, double value)
+{
+    NSString *path = DXBenchmarkBaselinesSourcePath();
+    NSMutableDictionary *baselines = [NSMutableDictionary dictionaryWithContentsOfFile:path];
+    NSMutableDictionary *benchmarks = [baselines[@"Benchmarks"] mutableCopy] ?: [NSMutableDictionary dictionary];
+    NSMutableDictionary *metrics = [benchmarks[benchmark] mutableCopy] ?: [NSMutableDictionary dictionary];
+    metrics[metric] = @(value);
+    benchmarks[benchmark] = metrics;
+    baselines[@"Benchmarks"] = benchmarks;
+    [baselines writeToFile:path atomically:YES];
+}
+
+@implementation DXBenchmarkTestCase
+
+- (void)checkMetric:(NSString *)metric value:(double)value benchmark:(NSString *)benchmark
+{
+    if (nil != [[NSProcessInfo processInfo] environment][@"DX_RECORD_BASELINES"]) {
+        DXRecordBaseline(benchmark, metric, value);
+        NSLog(@"%@ %@: recorded %g", benchmark, metric, value);
+        return;
+    }
+    NSNumber *baseline = DXBenchmarkBaselines()[@"Benchmarks"][benchmark][metric];
+    if (nil == baseline) {
+        XCTFail(@"No baseline of %@ for %@, measured %g, record it with DX_RECORD_BASELINES=1", metric, benchmark, value);
+        return;
+    }
+    double tolerance = [DXBenchmarkBaselines()[@"Tolerances"][metric] doubleValue];
+    double limit = baseline.doubleValue * (1.0 + tolerance);
+    NSLog(@"%@ %@: %g (baseline %g)", benchmark, metric, value, baseline.doubleValue);
+    XCTAssertTrue(value <= limit, @"%@ of %@ regressed to %g, baseline is %g, limit is %g",
+                  metric, benchmark, value, baseline.doubleValue, limit);
+}
+
+- (double)nanosecondsPerIteration:(NSUInteger)iterations ofBlock:(void (^)(void))block
+{
+    mach_timebase_info_data_t timebase;
+    mach_timebase_info(&timebase);
+    block(); // warm up caches
+    uint64_t startTime = mach_absolute_time();
+    for (NSUInteger i = 0; i < iterations; ++i)
+        block();
+    uint64_t elapsed = (mach_absolute_time() - startTime) * timebase.numer / timebase.denom;
+    return (double)elapsed / iterations;
+}
+
+@end
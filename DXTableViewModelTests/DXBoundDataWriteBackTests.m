@@ -0,0 +1,83 @@
+//
+//  DXBoundDataWriteBackTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "DXTableViewModel.h"
+#import "DXTableViewSection.h"
+#import "DXTableViewRow.h"
+
+@interface DXBoundDataWriteBackTests : XCTestCase
+
+@property (strong, nonatomic) DXTableViewModel *tableViewModel;
+@property (strong, nonatomic) NSArray *items;
+
+@end
+
+@implementation DXBoundDataWriteBackTests
+
+- (void)setUp
+{
+    [super setUp];
+    NSMutableArray *items = [NSMutableArray array];
+    NSMutableArray *rows = [NSMutableArray array];
+    for (NSInteger i = 0; i < 10000; ++i) {
+        NSMutableDictionary *item = [@{@"title": @"title", @"price": @(i)} mutableCopy];
+        DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+        [row bindObject:item withKeyPaths:@[@"title", @"price"]];
+        [items addObject:item];
+        [rows addObject:row];
+    }
+    self.items = items;
+    DXTableViewSection *section = [[DXTableViewSection alloc] initWithName:@"Items"];
+    [section addRows:rows];
+    self.tableViewModel = [[DXTableViewModel alloc] init];
+    [self.tableViewModel addSection:section];
+}
+
+- (void)testOnlyModifiedRowsAreWritten
+{
+    DXTableViewRow *row = [self.tableViewModel rowAtIndex:10 inSectionAtIndex:0];
+    row[@"title"] = @"edited";
+    [self.tableViewModel rowAtIndex:20 inSectionAtIndex:0][@"price"] = @(-1);
+    // equal value is not a modification
+    [self.tableViewModel rowAtIndex:30 inSectionAtIndex:0][@"title"] = @"title";
+
+    NSMapTable *writtenKeyPathsByRow = [self.tableViewModel updateRowObjectsReturningWrittenKeyPaths];
+
+    XCTAssertEqual(writtenKeyPathsByRow.count, (NSUInteger)2);
+    XCTAssertEqualObjects([writtenKeyPathsByRow objectForKey:row], [NSSet setWithObject:@"title"]);
+    XCTAssertEqualObjects(self.items[10][@"title"], @"edited");
+    XCTAssertEqualObjects(self.items[20][@"price"], @(-1));
+    XCTAssertEqual([self.tableViewModel updateRowObjectsReturningWrittenKeyPaths].count, (NSUInteger)0,
+                   @"rows are written once");
+}
+
+- (void)testRowModifiedBeforeInsertionIsWritten
+{
+    NSMutableDictionary *item = [@{@"title": @"title"} mutableCopy];
+    DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+    [row bindObject:item withKeyPath:@"title"];
+    row[@"title"] = @"edited";
+    [self.tableViewModel.sections[0] addRows:@[row]];
+
+    [self.tableViewModel updateRowObjects];
+
+    XCTAssertEqualObjects(item[@"title"], @"edited");
+}
+
+- (void)testRemovedRowIsNotWritten
+{
+    DXTableViewRow *row = [self.tableViewModel rowAtIndex:10 inSectionAtIndex:0];
+    row[@"title"] = @"edited";
+    [self.tableViewModel.sections[0] removeRow:row];
+
+    XCTAssertEqual([self.tableViewModel updateRowObjectsReturningWrittenKeyPaths].count, (NSUInteger)0);
+    XCTAssertEqualObjects(self.items[10][@"title"], @"title");
+}
+
+@end
@@ -0,0 +1,85 @@
+//
+//  DXCellTextHeightTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "DXStubTableView.h"
+#import "DXTableViewModel.h"
+#import "DXTableViewSection.h"
+#import "DXTableViewRow.h"
+
+@interface DXCellTextHeightTests : XCTestCase
+
+@property (strong, nonatomic) DXTableViewModel *tableViewModel;
+@property (strong, nonatomic) DXStubTableView *tableView;
+@property (strong, nonatomic) DXTableViewRow *templateRow;
+
+@end
+
+@implementation DXCellTextHeightTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.templateRow = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+    self.templateRow.cellClass = [UITableViewCell class];
+    self.templateRow.sizesRowHeightToCellText = YES;
+    self.templateRow.cellTextFont = [UIFont systemFontOfSize:15];
+    self.tableViewModel = [[DXTableViewModel alloc] init];
+    [self.tableViewModel addSection:[[DXTableViewSection alloc] initWithName:@"Texts"]];
+    self.tableView = [[DXStubTableView alloc] initWithViewportHeight:568.0];
+    self.tableViewModel.tableView = self.tableView;
+}
+
+- (void)tearDown
+{
+    self.tableViewModel.tableView = nil;
+    self.tableViewModel = nil;
+    self.tableView = nil;
+    self.templateRow = nil;
+    [super tearDown];
+}
+
+- (DXTableViewRow *)rowWithText:(NSString *)text
+{
+    DXTableViewRow *row = [[DXTableViewRow alloc] initWithTemplateRow:self.templateRow];
+    row.cellText = text;
+    [[self.tableViewModel sectionWithName:@"Texts"] addRow:row];
+    return row;
+}
+
+- (NSString *)textOfWords:(NSInteger)numberOfWords
+{
+    NSMutableArray *words = [NSMutableArray arrayWithCapacity:numberOfWords];
+    for (NSInteger i = 0; i < numberOfWords; ++i)
+        [words addObject:@"word"];
+    return [words componentsJoinedByString:@" "];
+}
+
+- (void)testAccessoryAndImageNarrowTexts
+{
+    NSString *text = [self textOfWords:40];
+    DXTableViewRow *plainRow = [self rowWithText:text];
+    DXTableViewRow *decoratedRow = [self rowWithText:text];
+    decoratedRow.cellAccessoryType = UITableViewCellAccessoryDetailDisclosureButton;
+    decoratedRow.cellImageSize = CGSizeMake(60, 60);
+
+    XCTAssertTrue([self.tableViewModel heightForRow:decoratedRow] > [self.tableViewModel heightForRow:plainRow],
+                  @"texts wrap into more lines next to accessory and image");
+}
+
+- (void)testTemplateFontChangeInvalidatesHeights
+{
+    DXTableViewRow *row = [self rowWithText:[self textOfWords:10]];
+    CGFloat height = [self.tableViewModel heightForRow:row];
+
+    self.templateRow.cellTextFont = [UIFont systemFontOfSize:30];
+
+    XCTAssertTrue([self.tableViewModel heightForRow:row] > height);
+}
+
+@end
@@ -0,0 +1,98 @@
+//
+//  DXChangedBoundDataTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "DXStubTableView.h"
+#import "DXTableViewModel.h"
+#import "DXTableViewSection.h"
+#import "DXTableViewRow.h"
+
+static const NSInteger DXChangedBoundDataNumberOfRows = 5000;
+
+@interface DXChangedBoundDataTests : XCTestCase
+
+@property (strong, nonatomic) DXTableViewModel *tableViewModel;
+@property (strong, nonatomic) DXStubTableView *tableView;
+@property (strong, nonatomic) NSArray *items;
+
+@end
+
+@implementation DXChangedBoundDataTests
+
+- (void)setUp
+{
+    [super setUp];
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:DXChangedBoundDataNumberOfRows];
+    NSMutableArray *rows = [NSMutableArray arrayWithCapacity:DXChangedBoundDataNumberOfRows];
+    for (NSInteger i = 0; i < DXChangedBoundDataNumberOfRows; ++i) {
+        NSMutableDictionary *item = [@{@"title": @"title", @"price": @(i)} mutableCopy];
+        DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+        row.cellClass = [UITableViewCell class];
+        row.observesBoundObject = YES;
+        [row bindObject:item withKeyPaths:@[@"title", @"price"]];
+        [items addObject:item];
+        [rows addObject:row];
+    }
+    self.items = items;
+    DXTableViewSection *section = [[DXTableViewSection alloc] initWithName:@"Items"];
+    [section addRows:rows];
+    self.tableViewModel = [[DXTableViewModel alloc] init];
+    [self.tableViewModel addSection:section];
+    self.tableView = [[DXStubTableView alloc] initWithViewportHeight:568.0];
+    self.tableViewModel.tableView = self.tableView;
+    [self.tableView reloadData];
+    [self.tableView scrollToOffset:44.0 * 1000];
+    [self.tableView resetStatistics];
+}
+
+- (void)tearDown
+{
+    self.tableViewModel.tableView = nil;
+    self.tableViewModel = nil;
+    self.tableView = nil;
+    self.items = nil;
+    [super tearDown];
+}
+
+- (void)runLoopTurn
+{
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.05]];
+}
+
+- (void)testChangesOfFewRowsAreReloadedOnceForVisibleRows
+{
+    NSArray *visibleIndexPaths = self.tableView.indexPathsForVisibleRows;
+    NSInteger firstVisibleRow = [visibleIndexPaths.firstObject row];
+    // every 50th row changes, 2% of rows, among them some visible ones
+    NSMutableSet *changedVisibleIndexPaths = [NSMutableSet set];
+    for (NSInteger i = firstVisibleRow % 50; i < DXChangedBoundDataNumberOfRows; i += 50) {
+        [self.items[i] setValue:@(-i) forKey:@"price"];
+        [self.items[i] setValue:@"changed" forKey:@"title"];
+        NSIndexPath *indexPath = [NSIndexPath indexPathForRow:i inSection:0];
+        if ([visibleIndexPaths containsObject:indexPath])
+            [changedVisibleIndexPaths addObject:indexPath];
+    }
+    XCTAssertTrue(changedVisibleIndexPaths.count > 0);
+    XCTAssertEqual(self.tableView.reloadedIndexPathBatches.count, (NSUInteger)0, @"changes are reloaded on the next run loop turn");
+
+    [self runLoopTurn];
+
+    XCTAssertEqual(self.tableView.reloadedIndexPathBatches.count, (NSUInteger)1);
+    XCTAssertEqualObjects([NSSet setWithArray:self.tableView.reloadedIndexPathBatches.firstObject], changedVisibleIndexPaths,
+                          @"only visible changed rows are reloaded, each once");
+    XCTAssertEqual(self.tableView.reloadCount, (NSUInteger)0);
+    DXTableViewRow *invisibleRow = [self.tableViewModel rowAtIndex:(firstVisibleRow + 2500) % DXChangedBoundDataNumberOfRows
+                                                  inSectionAtIndex:0];
+    XCTAssertEqualObjects(invisibleRow[@"title"], @"changed", @"rows which are not visible get new values too");
+
+    [self.tableView resetStatistics];
+    [self runLoopTurn];
+    XCTAssertEqual(self.tableView.reloadedIndexPathBatches.count, (NSUInteger)0, @"nothing is left for the next turn");
+}
+
+@end
@@ -0,0 +1,149 @@
+//
+//  DXFilterTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "DXStubTableView.h"
+#import "DXTableViewModel.h"
+#import "DXTableViewSection.h"
+#import "DXTableViewRow.h"
+
+@interface DXFilterTests : XCTestCase
+
+@property (strong, nonatomic) DXTableViewModel *tableViewModel;
+@property (strong, nonatomic) DXTableViewSection *section;
+@property (strong, nonatomic) DXStubTableView *tableView;
+
+@end
+
+@implementation DXFilterTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.section = [[DXTableViewSection alloc] initWithName:@"Items"];
+    self.tableViewModel = [[DXTableViewModel alloc] init];
+    [self.tableViewModel addSection:self.section];
+    self.tableViewModel.filterPredicate = [NSPredicate predicateWithFormat:@"cellText BEGINSWITH $query"];
+}
+
+- (void)tearDown
+{
+    self.tableViewModel.tableView = nil;
+    self.tableViewModel = nil;
+    self.section = nil;
+    self.tableView = nil;
+    [super tearDown];
+}
+
+- (void)addRowsWithTexts:(NSArray *)texts
+{
+    NSMutableArray *rows = [NSMutableArray arrayWithCapacity:texts.count];
+    for (NSString *text in texts) {
+        DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+        row.cellClass = [UITableViewCell class];
+        row.cellText = text;
+        [rows addObject:row];
+    }
+    [self.section addRows:rows];
+}
+
+- (void)connectTableView
+{
+    self.tableView = [[DXStubTableView alloc] initWithViewportHeight:568.0];
+    self.tableViewModel.tableView = self.tableView;
+    [self.tableView reloadData];
+    [self.tableView resetStatistics];
+}
+
+- (void)filterWithQuery:(NSString *)query
+{
+    __block BOOL filtered = NO;
+    self.tableViewModel.didFilterRowsBlock = ^(DXTableViewModel *tableViewModel) {
+        filtered = YES;
+    };
+    [self.tableViewModel filterRowsWithQuery:query];
+    NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:5.0];
+    while (!filtered && [timeout timeIntervalSinceNow] > 0)
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    XCTAssertTrue(filtered);
+}
+
+- (void)testRowsAreFilteredByCellText
+{
+    [self addRowsWithTexts:@[@"apple", @"banana", @"apricot"]];
+    [self connectTableView];
+
+    [self filterWithQuery:@"ap"];
+
+    XCTAssertEqual(self.section.numberOfRows, (NSInteger)2);
+    XCTAssertEqualObjects([[self.section rowAtIndex:1] cellText], @"apricot");
+    XCTAssertEqual(self.tableView.deletedRowCount, (NSUInteger)1);
+}
+
+- (void)testChangedCellTextIsMatchedByNextFiltering
+{
+    [self addRowsWithTexts:@[@"apple", @"banana"]];
+    [self filterWithQuery:@"ap"];
+    [self filterWithQuery:nil];
+
+    [[self.section rowAtIndex:1] setCellText:@"apricot"];
+    [self filterWithQuery:@"ap"];
+
+    XCTAssertEqual(self.section.numberOfRows, (NSInteger)2);
+}
+
+- (void)testQueryExtendingShownQueryIsEvaluatedAgainstAllRows
+{
+    // exact match isn't narrowed by longer queries, row hidden for a prefix matches the longer query
+    self.tableViewModel.filterPredicate = [NSPredicate predicateWithFormat:@"cellText == $query"];
+    [self addRowsWithTexts:@[@"ap", @"app", @"apple"]];
+    [self connectTableView];
+
+    [self filterWithQuery:@"ap"];
+    XCTAssertEqual(self.section.numberOfRows, (NSInteger)1);
+
+    [self filterWithQuery:@"app"];
+    XCTAssertEqual(self.section.numberOfRows, (NSInteger)1);
+    XCTAssertEqualObjects([[self.section rowAtIndex:0] cellText], @"app");
+}
+
+- (void)testNarrowingFilterEvaluatesOnlyShownRows
+{
+    // filter queue runs one operation at a time and publishes results on main queue, so counter needs no lock
+    __block NSInteger numberOfEvaluations = 0;
+    self.tableViewModel.filterBlock = ^BOOL (NSDictionary *boundData, NSString *query) {
+        numberOfEvaluations++;
+        return [boundData[@"cellText"] hasPrefix:query];
+    };
+    self.tableViewModel.filterNarrowsWithQueryPrefix = YES;
+    [self addRowsWithTexts:@[@"apple", @"banana", @"apricot", @"cherry"]];
+
+    [self filterWithQuery:@"a"];
+    XCTAssertEqual(numberOfEvaluations, (NSInteger)4);
+
+    [self filterWithQuery:@"apr"];
+    XCTAssertEqual(numberOfEvaluations, (NSInteger)6);
+    XCTAssertEqual(self.section.numberOfRows, (NSInteger)1);
+}
+
+- (void)testLargeChangeReloadsTableView
+{
+    NSMutableArray *texts = [NSMutableArray array];
+    for (NSInteger i = 0; i < 5000; ++i)
+        [texts addObject:[NSString stringWithFormat:@"%@ %ld", i % 2 ? @"odd" : @"even", (long)i]];
+    [self addRowsWithTexts:texts];
+    [self connectTableView];
+
+    [self filterWithQuery:@"odd"];
+
+    XCTAssertEqual(self.section.numberOfRows, (NSInteger)2500);
+    XCTAssertEqual(self.tableView.reloadCount, (NSUInteger)1);
+    XCTAssertEqual(self.tableView.deletedRowCount, (NSUInteger)0);
+}
+
+@end
@@ -0,0 +1,139 @@
+//
+//  DXGroupingTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "DXStubTableView.h"
+#import "DXTableViewModel.h"
+#import "DXTableViewSection.h"
+#import "DXTableViewRow.h"
+
+@interface DXGroupingTests : XCTestCase
+
+@property (strong, nonatomic) DXTableViewModel *tableViewModel;
+@property (strong, nonatomic) DXStubTableView *tableView;
+@property (strong, nonatomic) UILocalizedIndexedCollation *collation;
+@property (strong, nonatomic) DXTableViewSection *favoritesSection;
+
+@end
+
+@implementation DXGroupingTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.tableViewModel = [[DXTableViewModel alloc] init];
+    self.tableView = [[DXStubTableView alloc] initWithViewportHeight:568.0];
+    self.collation = [UILocalizedIndexedCollation currentCollation];
+    self.favoritesSection = [[DXTableViewSection alloc] initWithName:@"Favorites"];
+    [self.favoritesSection addRow:[self rowForItem:@"Favorite"]];
+    [self.tableViewModel addSection:self.favoritesSection];
+    [self groupItems:@[@"Alice", @"Amy", @"Bob", @"Bill", @"Carol", @"Frank"]];
+    self.tableViewModel.tableView = self.tableView;
+    [self.tableView resetStatistics];
+}
+
+- (void)tearDown
+{
+    self.tableViewModel.tableView = nil;
+    self.tableViewModel = nil;
+    self.tableView = nil;
+    [super tearDown];
+}
+
+- (DXTableViewRow *)rowForItem:(NSString *)item
+{
+    DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+    row.cellClass = [UITableViewCell class];
+    row.cellText = item;
+    return row;
+}
+
+- (void)groupItems:(NSArray *)items
+{
+    __weak DXGroupingTests *weakSelf = self;
+    [self.tableViewModel groupItems:items withCollation:self.collation keyBlock:^NSString *(NSString *item) {
+        return item;
+    } rowBlock:^DXTableViewRow *(NSString *item) {
+        return [weakSelf rowForItem:item];
+    } animated:YES];
+}
+
+- (NSArray *)sectionNames
+{
+    return [self.tableViewModel.sections valueForKey:@"sectionName"];
+}
+
+- (void)testOtherSectionsStayInPlace
+{
+    XCTAssertEqualObjects([self sectionNames], (@[@"Favorites", @"A", @"B", @"C", @"F"]));
+
+    [self groupItems:@[@"Dave", @"Bob"]];
+
+    XCTAssertEqualObjects([self sectionNames], (@[@"Favorites", @"B", @"D"]));
+    XCTAssertEqual(self.tableViewModel.sections[0], self.favoritesSection);
+    XCTAssertEqual(self.favoritesSection.numberOfRows, (NSInteger)1);
+    XCTAssertEqual(self.tableView.reloadCount, (NSUInteger)0);
+}
+
+- (void)testInsertionOfItemTouchesOneSection
+{
+    [self.tableViewModel insertGroupedItems:@[@"Anna"] withRowAnimation:UITableViewRowAnimationFade];
+
+    XCTAssertEqual(self.tableView.insertedRowCount, (NSUInteger)1);
+    XCTAssertEqual(self.tableView.deletedRowCount, (NSUInteger)0);
+    XCTAssertEqual(self.tableView.reloadedRowCount, (NSUInteger)0);
+    XCTAssertEqual(self.tableView.insertedSectionCount, (NSUInteger)0);
+    XCTAssertEqual(self.tableView.reloadedSectionCount, (NSUInteger)0);
+    XCTAssertEqual(self.tableView.reloadCount, (NSUInteger)0);
+    XCTAssertEqualObjects([self.tableViewModel rowForGroupedItem:@"Anna"].rowIndexPath, [NSIndexPath indexPathForRow:2 inSection:1]);
+
+    // item of an empty group inserts its section only
+    [self.tableView resetStatistics];
+    [self.tableViewModel insertGroupedItems:@[@"Eve"] withRowAnimation:UITableViewRowAnimationFade];
+
+    XCTAssertEqual(self.tableView.insertedSectionCount, (NSUInteger)1);
+    XCTAssertEqual(self.tableView.insertedRowCount, (NSUInteger)0);
+    XCTAssertEqual(self.tableView.reloadCount, (NSUInteger)0);
+    XCTAssertEqualObjects([self sectionNames], (@[@"Favorites", @"A", @"B", @"C", @"E", @"F"]));
+}
+
+- (void)testDeletionOfItemTouchesOneSection
+{
+    [self.tableViewModel deleteGroupedItems:@[@"Bob"] withRowAnimation:UITableViewRowAnimationFade];
+
+    XCTAssertEqual(self.tableView.deletedRowCount, (NSUInteger)1);
+    XCTAssertEqual(self.tableView.insertedRowCount, (NSUInteger)0);
+    XCTAssertEqual(self.tableView.reloadedRowCount, (NSUInteger)0);
+    XCTAssertEqual(self.tableView.deletedSectionCount, (NSUInteger)0);
+    XCTAssertEqual(self.tableView.reloadCount, (NSUInteger)0);
+
+    // last item of a group deletes its section only
+    [self.tableView resetStatistics];
+    [self.tableViewModel deleteGroupedItems:@[@"Carol"] withRowAnimation:UITableViewRowAnimationFade];
+
+    XCTAssertEqual(self.tableView.deletedSectionCount, (NSUInteger)1);
+    XCTAssertEqual(self.tableView.deletedRowCount, (NSUInteger)0);
+    XCTAssertEqual(self.tableView.reloadCount, (NSUInteger)0);
+    XCTAssertEqualObjects([self sectionNames], (@[@"Favorites", @"A", @"B", @"F"]));
+}
+
+- (void)testSectionIndexTitlesResolveToGroupSections
+{
+    NSArray *titles = [self.tableViewModel sectionIndexTitlesForTableView:self.tableView];
+    XCTAssertEqualObjects(titles, self.collation.sectionIndexTitles);
+
+    NSDictionary *expectedSectionNames = @{@"A": @"A", @"B": @"B", @"C": @"C", @"D": @"F", @"E": @"F", @"F": @"F",
+                                           @"Z": @"F"};
+    [expectedSectionNames enumerateKeysAndObjectsUsingBlock:^(NSString *title, NSString *sectionName, BOOL *stop) {
+        NSInteger index = [titles indexOfObject:title];
+        NSInteger section = [self.tableViewModel tableView:self.tableView sectionForSectionIndexTitle:title atIndex:index];
+        XCTAssertEqualObjects([self.tableViewModel.sections[section] sectionName], sectionName, @"%@", title);
+    }];
+}
+
+@end
@@ -0,0 +1,148 @@
+//
+//  DXImageCacheTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "DXStubTableView.h"
+#import "DXTableViewModel.h"
+#import "DXTableViewSection.h"
+#import "DXTableViewRow.h"
+
+// Side of loaded images in points, rows of their bitmaps need no padding
+static const CGFloat DXImageCacheImageSide = 16.0;
+
+@interface DXImageCacheTests : XCTestCase
+
+@property (strong, nonatomic) DXTableViewModel *tableViewModel;
+@property (strong, nonatomic) DXTableViewSection *section;
+@property (strong, nonatomic) NSCountedSet *loadedKeys;
+@property (strong, nonatomic) UIImage *placeholder;
+
+@end
+
+@implementation DXImageCacheTests
+
+// Synthetic bitmap, so tests need neither files nor network
++ (UIImage *)imageWithSide:(CGFloat)side
+{
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(NULL, (size_t)side, (size_t)side, 8, 0, colorSpace,
+                                                 kCGBitmapByteOrder32Host | kCGImageAlphaPremultipliedFirst);
+    CGColorSpaceRelease(colorSpace);
+    CGContextSetRGBFillColor(context, 1.0, 0.0, 0.0, 1.0);
+    CGContextFillRect(context, CGRectMake(0, 0, side, side));
+    CGImageRef imageRef = CGBitmapContextCreateImage(context);
+    CGContextRelease(context);
+    UIImage *image = [UIImage imageWithCGImage:imageRef];
+    CGImageRelease(imageRef);
+    return image;
+}
+
+- (void)setUp
+{
+    [super setUp];
+    NSCountedSet *loadedKeys = [NSCountedSet set];
+    self.loadedKeys = loadedKeys;
+    self.placeholder = [[self class] imageWithSide:1.0];
+    self.section = [[DXTableViewSection alloc] initWithName:@"Images"];
+    self.tableViewModel = [[DXTableViewModel alloc] init];
+    [self.tableViewModel addSection:self.section];
+}
+
+- (void)tearDown
+{
+    self.tableViewModel.tableView = nil;
+    self.tableViewModel = nil;
+    self.section = nil;
+    [super tearDown];
+}
+
+- (NSArray *)addRowsWithKeys:(NSArray *)keys
+{
+    NSCountedSet *loadedKeys = self.loadedKeys;
+    NSMutableArray *rows = [NSMutableArray arrayWithCapacity:keys.count];
+    for (NSString *key in keys) {
+        DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+        row.cellClass = [UITableViewCell class];
+        row.cellImage = self.placeholder;
+        row.cellImageKey = key;
+        row.cellImageSize = CGSizeMake(DXImageCacheImageSide, DXImageCacheImageSide);
+        row.cellImageLoader = ^UIImage *(NSString *key) {
+            @synchronized (loadedKeys) {
+                [loadedKeys addObject:key];
+            }
+            return [DXImageCacheTests imageWithSide:DXImageCacheImageSide * 4];
+        };
+        [rows addObject:row];
+    }
+    [self.section addRows:rows];
+    return rows;
+}
+
+- (NSUInteger)numberOfLoadsOfKey:(NSString *)key
+{
+    @synchronized (self.loadedKeys) {
+        return [self.loadedKeys countForObject:key];
+    }
+}
+
+- (void)waitForLoads
+{
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+}
+
+- (void)testSimultaneousRequestsOfSameImageLoadOnce
+{
+    NSArray *rows = [self addRowsWithKeys:@[@"a", @"a", @"a"]];
+    [rows makeObjectsPerformSelector:@selector(configureCell)];
+    [self waitForLoads];
+
+    XCTAssertEqual([self numberOfLoadsOfKey:@"a"], (NSUInteger)1);
+    [rows makeObjectsPerformSelector:@selector(configureCell)];
+    [self waitForLoads];
+    XCTAssertEqual([self numberOfLoadsOfKey:@"a"], (NSUInteger)1, @"cached image must not be loaded again");
+}
+
+- (void)testLeastRecentlyUsedImageIsEvictedWhenBudgetIsExceeded
+{
+    CGFloat scale = [UIScreen mainScreen].scale;
+    NSUInteger cost = (NSUInteger)(DXImageCacheImageSide * scale * 4 * DXImageCacheImageSide * scale);
+    self.tableViewModel.imageCacheByteBudget = cost * 5 / 2;
+    NSArray *rows = [self addRowsWithKeys:@[@"a", @"b", @"c"]];
+    for (DXTableViewRow *row in rows) {
+        [row configureCell];
+        [self waitForLoads];
+    }
+
+    [rows[0] configureCell];
+    [rows[2] configureCell];
+    [self waitForLoads];
+
+    XCTAssertEqual([self numberOfLoadsOfKey:@"a"], (NSUInteger)2, @"the oldest image has to be evicted");
+    XCTAssertEqual([self numberOfLoadsOfKey:@"c"], (NSUInteger)1);
+}
+
+- (void)testReusedCellShowsPlaceholderUntilItsImageIsLoaded
+{
+    NSMutableArray *keys = [NSMutableArray array];
+    for (NSInteger i = 0; i < 100; ++i)
+        [keys addObject:[NSString stringWithFormat:@"%ld", (long)i]];
+    [self addRowsWithKeys:keys];
+    DXStubTableView *tableView = [[DXStubTableView alloc] initWithViewportHeight:568.0];
+    self.tableViewModel.tableView = tableView;
+    [tableView reloadData];
+    [self waitForLoads];
+
+    // cells of the first screen are reused for rows which images are not loaded yet
+    [tableView scrollToOffset:44.0 * 50];
+    for (NSIndexPath *indexPath in tableView.indexPathsForVisibleRows) {
+        UITableViewCell *cell = [self.tableViewModel rowAtIndexPath:indexPath].cell;
+        XCTAssertEqual(cell.imageView.image, self.placeholder);
+    }
+}
+
+@end
@@ -0,0 +1,131 @@
+//
+//  DXIndexCacheTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "DXTableViewModel.h"
+#import "DXTableViewSection.h"
+#import "DXTableViewRow.h"
+
+static const NSInteger DXIndexCacheNumberOfMutations = 2000;
+
+@interface DXIndexCacheTests : XCTestCase
+
+@property (strong, nonatomic) DXTableViewModel *tableViewModel;
+@property (nonatomic) NSInteger numberOfCreatedSections;
+
+@end
+
+@implementation DXIndexCacheTests
+
+- (void)setUp
+{
+    [super setUp];
+    // fixed seed, so failing sequence of mutations can be replayed
+    srand48(20131017);
+    self.tableViewModel = [[DXTableViewModel alloc] init];
+    for (NSInteger i = 0; i < 5; ++i)
+        [self.tableViewModel addSection:[self sectionWithNumberOfRows:5]];
+}
+
+- (void)tearDown
+{
+    self.tableViewModel = nil;
+    [super tearDown];
+}
+
+- (DXTableViewSection *)sectionWithNumberOfRows:(NSInteger)numberOfRows
+{
+    NSString *name = [NSString stringWithFormat:@"%ld", (long)self.numberOfCreatedSections++];
+    DXTableViewSection *section = [[DXTableViewSection alloc] initWithName:name];
+    for (NSInteger i = 0; i < numberOfRows; ++i)
+        [section addRow:[self row]];
+    return section;
+}
+
+- (DXTableViewRow *)row
+{
+    DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+    row.rowHeight = 20 + [self randomIndexBelow:40];
+    return row;
+}
+
+- (NSInteger)randomIndexBelow:(NSInteger)count
+{
+    return (NSInteger)(drand48() * count);
+}
+
+- (DXTableViewSection *)randomSection
+{
+    NSArray *sections = self.tableViewModel.sections;
+    return sections.count > 0 ? sections[[self randomIndexBelow:sections.count]] : nil;
+}
+
+- (void)applyRandomMutation
+{
+    DXTableViewModel *tableViewModel = self.tableViewModel;
+    DXTableViewSection *section = [self randomSection];
+    switch ([self randomIndexBelow:6]) {
+        case 0:
+            [tableViewModel insertSection:[self sectionWithNumberOfRows:[self randomIndexBelow:5]]
+                                  atIndex:[self randomIndexBelow:tableViewModel.sections.count + 1]];
+            break;
+        case 1:
+            if (tableViewModel.sections.count > 1)
+                [tableViewModel removeSection:section];
+            break;
+        case 2: {
+            DXTableViewSection *destination = [self randomSection];
+            if (nil != section && section != destination)
+                [tableViewModel moveSectionWithName:section.sectionName toSectionWithName:destination.sectionName];
+            break;
+        }
+        case 3:
+            [section insertRow:[self row]
+                       atIndex:[self randomIndexBelow:section.numberOfRows + 1]];
+            break;
+        case 4:
+            if (section.numberOfRows > 0)
+                [section removeRow:[section rowAtIndex:[self randomIndexBelow:section.numberOfRows]]];
+            break;
+        case 5:
+            if (section.numberOfRows > 0) {
+                DXTableViewRow *row = [section rowAtIndex:[self randomIndexBelow:section.numberOfRows]];
+                NSInteger index = [self randomIndexBelow:section.numberOfRows];
+                [section moveRow:row toIndexPath:[NSIndexPath indexPathForRow:index inSection:section.sectionIndex]];
+            }
+            break;
+    }
+}
+
+// Cached positions and heights against positions and heights found by linear search
+- (void)checkPositions
+{
+    NSArray *sections = self.tableViewModel.sections;
+    __block CGFloat contentHeight = 0;
+    [sections enumerateObjectsUsingBlock:^(DXTableViewSection *section, NSUInteger sectionIndex, BOOL *stop) {
+        XCTAssertEqual(section.sectionIndex, (NSInteger)sectionIndex);
+        XCTAssertEqual([self.tableViewModel indexOfSectionWithName:section.sectionName], (NSInteger)sectionIndex);
+        contentHeight += MAX(section.headerHeight, 0) + MAX(section.footerHeight, 0);
+        [section.rows enumerateObjectsUsingBlock:^(DXTableViewRow *row, NSUInteger rowIndex, BOOL *stop) {
+            XCTAssertEqualObjects(row.rowIndexPath, [NSIndexPath indexPathForRow:rowIndex inSection:sectionIndex]);
+            contentHeight += row.rowHeight;
+        }];
+    }];
+    XCTAssertEqualWithAccuracy(self.tableViewModel.contentHeight, contentHeight, 0.001);
+}
+
+- (void)testCachedPositionsMatchLinearSearchAfterRandomMutations
+{
+    for (NSInteger i = 0; i < DXIndexCacheNumberOfMutations; ++i) {
+        [self applyRandomMutation];
+        // positions are read between mutations, so caches filled by previous reads have to be invalidated
+        [self checkPositions];
+    }
+}
+
+@end
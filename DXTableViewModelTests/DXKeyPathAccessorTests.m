@@ -0,0 +1,176 @@
+//
+//  DXKeyPathAccessorTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import "DXBenchmarkTestCase.h"
+#import "DXTableViewModel.h"
+#import "DXTableViewSection.h"
+#import "DXTableViewRow.h"
+
+static const NSInteger DXKeyPathAccessorNumberOfRows = 10000;
+
+@interface DXKeyPathAccessorItem : NSObject
+
+@property (copy, nonatomic) NSString *title;
+@property (copy, nonatomic) NSString *subtitle;
+@property (strong, nonatomic) NSNumber *price;
+@property (strong, nonatomic) NSArray *tags;
+@property (strong, nonatomic) DXKeyPathAccessorItem *owner;
+
+@end
+
+@implementation DXKeyPathAccessorItem
+@end
+
+// Forwards everything to its target as proxies of remote or lazily loaded objects do
+@interface DXKeyPathAccessorProxy : NSProxy
+
+@property (strong, nonatomic) id target;
+
+@end
+
+@implementation DXKeyPathAccessorProxy
+
+- (NSMethodSignature *)methodSignatureForSelector:(SEL)sel
+{
+    return [self.target methodSignatureForSelector:sel];
+}
+
+- (void)forwardInvocation:(NSInvocation *)invocation
+{
+    [invocation invokeWithTarget:self.target];
+}
+
+@end
+
+@interface DXKeyPathAccessorTests : DXBenchmarkTestCase
+@end
+
+@implementation DXKeyPathAccessorTests
+
+- (DXKeyPathAccessorItem *)itemWithIndex:(NSInteger)index
+{
+    DXKeyPathAccessorItem *owner = [[DXKeyPathAccessorItem alloc] init];
+    owner.title = @"owner";
+    owner.subtitle = [NSString stringWithFormat:@"owner %ld", (long)index];
+    DXKeyPathAccessorItem *item = [[DXKeyPathAccessorItem alloc] init];
+    item.title = [NSString stringWithFormat:@"item %ld", (long)index];
+    item.subtitle = @"subtitle";
+    item.price = @(index);
+    item.tags = @[@"a", @"b"];
+    item.owner = owner;
+    return item;
+}
+
+- (void)testDictionaryKeysAreNotResolvedToMethods
+{
+    NSMutableDictionary *object = [@{@"count": @"ten", @"description": @"text"} mutableCopy];
+    DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+    [row bindObject:object withKeyPaths:@[@"count", @"description"]];
+
+    XCTAssertEqualObjects(row[@"count"], @"ten");
+    XCTAssertEqualObjects(row[@"description"], @"text");
+
+    row[@"count"] = @"eleven";
+    [row updateObject];
+    XCTAssertEqualObjects(object[@"count"], @"eleven");
+}
+
+- (void)testProxiedObjectIsAccessedThroughKeyValueCoding
+{
+    DXKeyPathAccessorProxy *proxy = [DXKeyPathAccessorProxy alloc];
+    proxy.target = [self itemWithIndex:7];
+    DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+    [row bindObject:proxy withKeyPaths:@[@"title", @"owner.subtitle"]];
+
+    XCTAssertEqualObjects(row[@"title"], @"item 7");
+    XCTAssertEqualObjects(row[@"owner.subtitle"], @"owner 7");
+
+    row[@"title"] = @"edited";
+    [row updateObject];
+    XCTAssertEqualObjects([proxy.target title], @"edited");
+}
+
+- (void)testCollectionOperatorsAreEvaluated
+{
+    DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+    [row bindObject:[self itemWithIndex:1] withKeyPaths:@[@"tags.@count", @"owner.title"]];
+
+    XCTAssertEqualObjects(row[@"tags.@count"], @2);
+    XCTAssertEqualObjects(row[@"owner.title"], @"owner");
+}
+
+- (void)testKeysOfCollectionsAreMappedOverElements
+{
+    DXKeyPathAccessorItem *item = [self itemWithIndex:1];
+    DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+    [row bindObject:item withKeyPaths:@[@"tags.description", @"tags.uppercaseString"]];
+
+    // NSArray responds to description itself, key-value coding asks elements instead
+    XCTAssertEqualObjects(row[@"tags.description"], (@[@"a", @"b"]));
+    XCTAssertEqualObjects(row[@"tags.uppercaseString"], (@[@"A", @"B"]));
+}
+
+- (void)testIntermediateObjectsOfDifferentClassesAreAccessed
+{
+    DXKeyPathAccessorItem *item = [self itemWithIndex:3];
+    DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+    [row bindObject:item withKeyPaths:@[@"owner.title"]];
+    XCTAssertEqualObjects(row[@"owner.title"], @"owner");
+
+    // owner of another class on the same key path isn't read with the accessor remembered for the first one
+    item.owner = (id)@{@"title": @"dictionary owner"};
+    [row reloadBoundData];
+    XCTAssertEqualObjects(row[@"owner.title"], @"dictionary owner");
+}
+
+// 10k rows by 5 key paths, two of them nested: loading bound data with generic key-value coding against compiled accessors
+- (void)testCompiledAccessorsAgainstKeyValueCoding
+{
+    NSArray *keyPaths = @[@"title", @"subtitle", @"price", @"owner.title", @"owner.subtitle"];
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:DXKeyPathAccessorNumberOfRows];
+    NSMutableArray *rows = [NSMutableArray arrayWithCapacity:DXKeyPathAccessorNumberOfRows];
+    for (NSInteger i = 0; i < DXKeyPathAccessorNumberOfRows; ++i) {
+        DXKeyPathAccessorItem *item = [self itemWithIndex:i];
+        DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+        [row bindObject:item withKeyPaths:keyPaths];
+        [items addObject:item];
+        [rows addObject:row];
+    }
+    DXTableViewSection *section = [[DXTableViewSection alloc] initWithName:@"Items"];
+    [section addRows:rows];
+    DXTableViewModel *tableViewModel = [[DXTableViewModel alloc] init];
+    [tableViewModel addSection:section];
+
+    // same work as reloadBoundData does per row, but with key-value coding
+    NSMutableArray *boundData = [NSMutableArray arrayWithCapacity:DXKeyPathAccessorNumberOfRows];
+    for (NSInteger i = 0; i < DXKeyPathAccessorNumberOfRows; ++i)
+        [boundData addObject:[NSMutableDictionary dictionaryWithCapacity:keyPaths.count]];
+    double keyValueCodingNanoseconds = [self nanosecondsPerIteration:5 ofBlock:^{
+        for (NSInteger i = 0; i < DXKeyPathAccessorNumberOfRows; ++i) {
+            id item = items[i];
+            NSMutableDictionary *data = boundData[i];
+            for (NSString *keyPath in keyPaths) {
+                id value = [[item valueForKeyPath:keyPath] copy];
+                if (nil != value)
+                    data[keyPath] = value;
+            }
+        }
+    }];
+    double compiledNanoseconds = [self nanosecondsPerIteration:5 ofBlock:^{
+        [tableViewModel reloadRowBoundData];
+    }];
+
+    XCTAssertEqualObjects([rows.lastObject objectForKeyedSubscript:@"owner.subtitle"],
+                          ([NSString stringWithFormat:@"owner %ld", (long)DXKeyPathAccessorNumberOfRows - 1]));
+    [self checkMetric:@"nanosecondsPerRow" value:compiledNanoseconds / DXKeyPathAccessorNumberOfRows
+            benchmark:@"KeyPathAccessors10kx5"];
+    [self checkMetric:@"compiledToKeyValueCodingRatio" value:compiledNanoseconds / MAX(keyValueCodingNanoseconds, 1.0)
+            benchmark:@"KeyPathAccessors10kx5"];
+}
+
+@end
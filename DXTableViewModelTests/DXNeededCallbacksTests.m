@@ -0,0 +1,136 @@
+//
+//  DXNeededCallbacksTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "DXStubTableView.h"
+#import "DXTableViewModel.h"
+#import "DXTableViewSection.h"
+#import "DXTableViewRow.h"
+
+static const NSInteger DXNeededCallbacksNumberOfSections = 10;
+static const NSInteger DXNeededCallbacksRowsPerSection = 100;
+
+@interface DXNeededCallbacksTests : XCTestCase
+
+@property (strong, nonatomic) DXTableViewModel *tableViewModel;
+@property (strong, nonatomic) DXStubTableView *tableView;
+
+@end
+
+@implementation DXNeededCallbacksTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.tableViewModel = [[DXTableViewModel alloc] init];
+    for (NSInteger s = 0; s < DXNeededCallbacksNumberOfSections; ++s) {
+        DXTableViewSection *section = [[DXTableViewSection alloc] initWithName:[NSString stringWithFormat:@"%ld", (long)s]];
+        NSMutableArray *rows = [NSMutableArray arrayWithCapacity:DXNeededCallbacksRowsPerSection];
+        for (NSInteger r = 0; r < DXNeededCallbacksRowsPerSection; ++r)
+            [rows addObject:[self rowWithHeight:44.0]];
+        [section addRows:rows];
+        [self.tableViewModel addSection:section];
+    }
+    self.tableView = [[DXStubTableView alloc] initWithViewportHeight:568.0];
+}
+
+- (void)tearDown
+{
+    self.tableViewModel.tableView = nil;
+    self.tableViewModel = nil;
+    self.tableView = nil;
+    [super tearDown];
+}
+
+- (DXTableViewRow *)rowWithHeight:(CGFloat)height
+{
+    DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+    row.cellClass = [UITableViewCell class];
+    row.rowHeight = height;
+    return row;
+}
+
+- (void)connectTableView
+{
+    self.tableViewModel.tableView = self.tableView;
+    [self.tableView reloadData];
+    [self.tableView resetStatistics];
+}
+
+- (void)testUniformRowsAreNotAskedForHeightsOrDisplay
+{
+    [self connectTableView];
+
+    [self.tableView reloadData];
+    [self.tableView scrollThroughContentWithStep:284.0];
+
+    XCTAssertEqual(self.tableView.rowHeight, (CGFloat)44.0);
+    XCTAssertEqual([self.tableView countOfCallback:DXStubTableViewCallbackHeightForRow], (NSUInteger)0);
+    XCTAssertEqual([self.tableView countOfCallback:DXStubTableViewCallbackEstimatedHeightForRow], (NSUInteger)0);
+    XCTAssertEqual([self.tableView countOfCallback:DXStubTableViewCallbackWillDisplayCell], (NSUInteger)0);
+    XCTAssertTrue([self.tableView countOfCallback:DXStubTableViewCallbackCellForRow] > 0);
+}
+
+- (void)testAutomaticDimensionAndEstimatedRowHeightAreLeftToTableView
+{
+    self.tableView.estimatedRowHeight = 60.0;
+    CGFloat headerHeight = self.tableView.sectionHeaderHeight;
+    CGFloat footerHeight = self.tableView.sectionFooterHeight;
+
+    [self connectTableView];
+
+    XCTAssertEqual(self.tableView.estimatedRowHeight, (CGFloat)60.0);
+    XCTAssertEqual(self.tableView.sectionHeaderHeight, headerHeight, @"headers of automatic dimension keep table view's height");
+    XCTAssertEqual(self.tableView.sectionFooterHeight, footerHeight, @"footers of automatic dimension keep table view's height");
+}
+
+- (void)testDelegateIsReassignedOnceAfterTransaction
+{
+    [self connectTableView];
+
+    [self.tableViewModel beginUpdates];
+    for (NSInteger s = 0; s < 3; ++s) {
+        DXTableViewRow *row = [self rowWithHeight:88.0];
+        row.willDisplayCellBlock = ^(DXTableViewRow *row, id cell) {};
+        [[self.tableViewModel sectionWithName:[NSString stringWithFormat:@"%ld", (long)s]] insertRows:@[row] atIndex:0 withRowAnimation:UITableViewRowAnimationFade];
+        XCTAssertEqual(self.tableView.delegateAssignmentCount, (NSUInteger)0, @"delegate is not reassigned amid batch updates");
+    }
+    [self.tableViewModel endUpdates];
+
+    // delegate is reset to nil and assigned back
+    XCTAssertEqual(self.tableView.delegateAssignmentCount, (NSUInteger)2);
+    [self.tableView resetStatistics];
+    [self.tableView reloadData];
+    XCTAssertTrue([self.tableView countOfCallback:DXStubTableViewCallbackHeightForRow] > 0);
+    XCTAssertTrue([self.tableView countOfCallback:DXStubTableViewCallbackWillDisplayCell] > 0);
+}
+
+- (void)testChangesOfTemplateRowAreNoticed
+{
+    DXTableViewRow *templateRow = [self rowWithHeight:44.0];
+    DXTableViewSection *section = [[DXTableViewSection alloc] initWithName:@"Templated"];
+    for (NSInteger r = 0; r < DXNeededCallbacksRowsPerSection; ++r)
+        [section addRow:[[DXTableViewRow alloc] initWithTemplateRow:templateRow]];
+    [self.tableViewModel insertSection:section atIndex:0];
+    [self connectTableView];
+
+    templateRow.rowHeight = 60.0;
+    templateRow.willDisplayCellBlock = ^(DXTableViewRow *row, id cell) {};
+    // uniform heights are not asked for, displayed rows notice the change
+    [self.tableView reloadData];
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+
+    XCTAssertEqual(self.tableView.delegateAssignmentCount, (NSUInteger)2);
+    [self.tableView resetStatistics];
+    [self.tableView reloadData];
+    XCTAssertTrue([self.tableView countOfCallback:DXStubTableViewCallbackHeightForRow] > 0, @"rows are no longer uniform");
+    XCTAssertTrue([self.tableView countOfCallback:DXStubTableViewCallbackWillDisplayCell] > 0);
+    XCTAssertEqual([self.tableViewModel heightForRow:[section rowAtIndex:0]], (CGFloat)60.0);
+}
+
+@end
@@ -0,0 +1,149 @@
+//
+//  DXPagedSectionTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "DXStubTableView.h"
+#import "DXTableViewModel.h"
+#import "DXTableViewSection.h"
+#import "DXTableViewRow.h"
+
+@interface DXTableViewSection (DXPagedSectionTests)
+
+- (void)loadPagesNearRowAtIndex:(NSInteger)index;
+
+@end
+
+@interface DXPagedSectionTests : XCTestCase
+
+@property (strong, nonatomic) DXTableViewModel *tableViewModel;
+@property (strong, nonatomic) DXTableViewSection *section;
+@property (strong, nonatomic) NSMutableArray *completions;
+@property (strong, nonatomic) NSMutableArray *failedPageIndexes;
+
+@end
+
+@implementation DXPagedSectionTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.completions = [NSMutableArray array];
+    self.failedPageIndexes = [NSMutableArray array];
+    self.section = [[DXTableViewSection alloc] initWithName:@"Feed"];
+    NSMutableArray *failedPageIndexes = self.failedPageIndexes;
+    self.section.didFailToLoadPageBlock = ^(DXTableViewSection *section, NSInteger pageIndex) {
+        [failedPageIndexes addObject:@(pageIndex)];
+    };
+    self.tableViewModel = [[DXTableViewModel alloc] init];
+    [self.tableViewModel addSection:self.section];
+}
+
+- (void)tearDown
+{
+    self.tableViewModel.tableView = nil;
+    self.tableViewModel = nil;
+    self.section = nil;
+    [super tearDown];
+}
+
+// Loader keeps completions, so tests decide when and how every page completes
+- (void)pageSection
+{
+    NSMutableArray *completions = self.completions;
+    [self.section pageWithSize:10 prefetchDistance:0 loaderBlock:^(DXTableViewSection *section, NSInteger pageIndex, void (^completion)(NSArray *, BOOL)) {
+        [completions addObject:[completion copy]];
+    }];
+}
+
+- (NSArray *)rowsWithCount:(NSInteger)count
+{
+    NSMutableArray *rows = [NSMutableArray arrayWithCapacity:count];
+    for (NSInteger i = 0; i < count; ++i) {
+        DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+        row.cellClass = [UITableViewCell class];
+        [rows addObject:row];
+    }
+    return rows;
+}
+
+- (void)completeRequest:(NSUInteger)request withRows:(NSArray *)rows
+{
+    void (^completion)(NSArray *, BOOL) = self.completions[request];
+    completion(rows, NO);
+}
+
+- (void)testFailedPageIsReportedAndRequestedAgain
+{
+    [self pageSection];
+
+    [self completeRequest:0 withRows:nil];
+
+    XCTAssertEqualObjects(self.failedPageIndexes, @[@0]);
+    XCTAssertTrue(self.section.hasMorePages);
+    XCTAssertFalse(self.section.isLoadingPages);
+    [self.section loadNextPage];
+    XCTAssertEqual(self.completions.count, (NSUInteger)2);
+    [self completeRequest:1 withRows:[self rowsWithCount:10]];
+    XCTAssertEqual(self.section.numberOfRows, (NSInteger)10);
+}
+
+- (void)testPageRequestTimesOut
+{
+    self.section.pageLoadingTimeout = 0.05;
+    [self pageSection];
+
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+
+    XCTAssertEqualObjects(self.failedPageIndexes, @[@0]);
+    XCTAssertFalse(self.section.isLoadingPages);
+    [self completeRequest:0 withRows:[self rowsWithCount:10]];
+    XCTAssertEqual(self.section.numberOfRows, (NSInteger)0, @"late completion of timed out request is ignored");
+}
+
+- (void)testEvictedPageLoadedWithFewerRowsKeepsPositionsOfOtherPages
+{
+    self.section.maximumNumberOfLoadedPages = 1;
+    [self pageSection];
+    [self completeRequest:0 withRows:[self rowsWithCount:10]];
+    [self.section loadNextPage];
+    // the second page is evicted at once, as the first one is displayed
+    [self completeRequest:1 withRows:[self rowsWithCount:10]];
+
+    [self.section loadPagesNearRowAtIndex:15];
+    NSArray *rows = [self rowsWithCount:5];
+    XCTAssertNoThrow([self completeRequest:2 withRows:rows]);
+
+    XCTAssertEqual(self.section.numberOfRows, (NSInteger)20);
+    XCTAssertEqual([self.section rowAtIndex:10], rows[0]);
+    XCTAssertEqual([self.section rowAtIndex:14], rows[4]);
+}
+
+- (void)testEvictedPageIsReloadedInTableView
+{
+    // viewport shows a couple of rows of the first page only
+    DXStubTableView *tableView = [[DXStubTableView alloc] initWithViewportHeight:88.0];
+    self.section.maximumNumberOfLoadedPages = 1;
+    [self pageSection];
+    self.tableViewModel.tableView = tableView;
+    [self completeRequest:0 withRows:[self rowsWithCount:10]];
+    [self.section loadNextPage];
+    [tableView resetStatistics];
+
+    NSArray *rows = [self rowsWithCount:10];
+    [self completeRequest:1 withRows:rows];
+
+    NSMutableArray *indexPaths = [NSMutableArray array];
+    for (NSInteger i = 10; i < 20; ++i)
+        [indexPaths addObject:[NSIndexPath indexPathForRow:i inSection:0]];
+    XCTAssertEqual(tableView.insertedRowCount, (NSUInteger)10);
+    XCTAssertEqual(tableView.reloadedRowCount, (NSUInteger)10);
+    XCTAssertEqualObjects(tableView.reloadedIndexPathBatches, @[indexPaths]);
+    XCTAssertNotEqual([self.section rowAtIndex:10], rows[0], @"second page is evicted at once");
+}
+
+@end
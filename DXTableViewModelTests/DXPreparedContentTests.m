@@ -0,0 +1,68 @@
+//
+//  DXPreparedContentTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "DXTableViewRow.h"
+
+@interface DXPreparedContentTests : XCTestCase
+
+@property (nonatomic) NSUInteger numberOfPreparations;
+
+@end
+
+@implementation DXPreparedContentTests
+
+- (id (^)(NSDictionary *))prepareContentBlockReturning:(id)content
+{
+    __weak DXPreparedContentTests *weakSelf = self;
+    return ^id(NSDictionary *boundData) {
+        ++weakSelf.numberOfPreparations;
+        return content;
+    };
+}
+
+- (DXTableViewRow *)rowWithTemplateRow:(DXTableViewRow *)templateRow
+{
+    DXTableViewRow *row = [[DXTableViewRow alloc] initWithTemplateRow:templateRow];
+    [row bindObject:[NSMutableDictionary dictionaryWithObject:@"title" forKey:@"title"] withKeyPath:@"title"];
+    return row;
+}
+
+- (void)testNilContentIsPreparedOnce
+{
+    DXTableViewRow *templateRow = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+    templateRow.prepareContentBlock = [self prepareContentBlockReturning:nil];
+    templateRow.applyContentBlock = ^(DXTableViewRow *row, id cell, id content) {
+    };
+    DXTableViewRow *row = [self rowWithTemplateRow:templateRow];
+
+    [row configureCell];
+    [row configureCell];
+
+    XCTAssertEqual(self.numberOfPreparations, (NSUInteger)1, @"nil is prepared content too");
+}
+
+- (void)testContentIsPreparedAgainWhenTemplateBlockChanges
+{
+    DXTableViewRow *templateRow = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+    templateRow.prepareContentBlock = [self prepareContentBlockReturning:@"old"];
+    __block id appliedContent;
+    templateRow.applyContentBlock = ^(DXTableViewRow *row, id cell, id content) {
+        appliedContent = content;
+    };
+    DXTableViewRow *row = [self rowWithTemplateRow:templateRow];
+    [row configureCell];
+
+    templateRow.prepareContentBlock = [self prepareContentBlockReturning:@"new"];
+    [row configureCell];
+
+    XCTAssertEqualObjects(appliedContent, @"new");
+    XCTAssertEqual(self.numberOfPreparations, (NSUInteger)2);
+}
+
+@end
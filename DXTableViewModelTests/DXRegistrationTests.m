@@ -0,0 +1,86 @@
+//
+//  DXRegistrationTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "DXStubTableView.h"
+#import "DXTableViewModel.h"
+#import "DXTableViewSection.h"
+#import "DXTableViewRow.h"
+
+@interface DXRegistrationTests : XCTestCase
+
+@property (strong, nonatomic) DXTableViewModel *tableViewModel;
+@property (strong, nonatomic) DXStubTableView *tableView;
+
+@end
+
+@implementation DXRegistrationTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.tableViewModel = [[DXTableViewModel alloc] init];
+    self.tableView = [[DXStubTableView alloc] initWithViewportHeight:568.0];
+}
+
+- (void)tearDown
+{
+    self.tableViewModel.tableView = nil;
+    self.tableViewModel = nil;
+    self.tableView = nil;
+    [super tearDown];
+}
+
+- (NSArray *)rowsWithCount:(NSInteger)count
+{
+    NSArray *identifiers = @[@"Title", @"Subtitle", @"Value"];
+    NSMutableArray *rows = [NSMutableArray arrayWithCapacity:count];
+    for (NSInteger i = 0; i < count; ++i) {
+        DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:identifiers[i % identifiers.count]];
+        row.cellClass = [UITableViewCell class];
+        [rows addObject:row];
+    }
+    return rows;
+}
+
+- (void)testEachReuseIdentifierIsRegisteredOnce
+{
+    for (NSInteger s = 0; s < 10; ++s) {
+        DXTableViewSection *section = [[DXTableViewSection alloc] initWithName:[NSString stringWithFormat:@"%ld", (long)s]];
+        [section addRows:[self rowsWithCount:1000]];
+        [self.tableViewModel addSection:section];
+    }
+    self.tableViewModel.tableView = self.tableView;
+
+    XCTAssertEqual(self.tableViewModel.numberOfRegistrations, (NSUInteger)3);
+    XCTAssertEqual(self.tableView.registrationCount, (NSUInteger)3);
+
+    // rows inserted later reuse registrations made for their identifiers
+    [[self.tableViewModel sectionWithName:@"0"] addRows:[self rowsWithCount:1000]];
+    [self.tableView reloadData];
+    [self.tableView scrollThroughContentWithStep:284.0];
+
+    XCTAssertEqual(self.tableViewModel.numberOfRegistrations, (NSUInteger)3);
+    XCTAssertEqual(self.tableView.registrationCount, (NSUInteger)3);
+}
+
+- (void)testRegistrationsAreMadeAgainForNewTableView
+{
+    DXTableViewSection *section = [[DXTableViewSection alloc] initWithName:@"Items"];
+    [section addRows:[self rowsWithCount:100]];
+    [self.tableViewModel addSection:section];
+    self.tableViewModel.tableView = self.tableView;
+
+    DXStubTableView *otherTableView = [[DXStubTableView alloc] initWithViewportHeight:568.0];
+    self.tableViewModel.tableView = otherTableView;
+
+    XCTAssertEqual(self.tableViewModel.numberOfRegistrations, (NSUInteger)3);
+    XCTAssertEqual(otherTableView.registrationCount, (NSUInteger)3);
+}
+
+@end
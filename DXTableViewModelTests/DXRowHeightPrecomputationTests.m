@@ -0,0 +1,125 @@
+//
+//  DXRowHeightPrecomputationTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "DXStubTableView.h"
+#import "DXTableViewModel.h"
+#import "DXTableViewSection.h"
+#import "DXTableViewRow.h"
+
+static const NSInteger DXRowHeightPrecomputationNumberOfRows = 1000;
+
+@interface DXRowHeightPrecomputationTests : XCTestCase
+
+@property (strong, nonatomic) DXTableViewModel *tableViewModel;
+@property (strong, nonatomic) DXStubTableView *tableView;
+@property (strong, nonatomic) NSMutableArray *measuredIndexes;
+
+@end
+
+@implementation DXRowHeightPrecomputationTests
+
+- (void)setUp
+{
+    [super setUp];
+    NSMutableArray *measuredIndexes = [NSMutableArray array];
+    self.measuredIndexes = measuredIndexes;
+    DXTableViewRow *templateRow = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+    templateRow.cellClass = [UITableViewCell class];
+    templateRow.estimatedRowHeight = 44.0;
+    templateRow.rowHeightForWidthBlock = ^CGFloat(NSDictionary *boundData, CGFloat width) {
+        @synchronized (measuredIndexes) {
+            [measuredIndexes addObject:boundData[@"index"]];
+        }
+        return 60.0;
+    };
+
+    DXTableViewSection *section = [[DXTableViewSection alloc] initWithName:@"Section"];
+    NSMutableArray *rows = [NSMutableArray array];
+    for (NSInteger i = 0; i < DXRowHeightPrecomputationNumberOfRows; ++i) {
+        DXTableViewRow *row = [[DXTableViewRow alloc] initWithTemplateRow:templateRow];
+        [row bindObject:[NSMutableDictionary dictionaryWithObject:@(i) forKey:@"index"] withKeyPath:@"index"];
+        [rows addObject:row];
+    }
+    [section addRows:rows];
+    self.tableViewModel = [[DXTableViewModel alloc] init];
+    [self.tableViewModel addSection:section];
+    self.tableView = [[DXStubTableView alloc] initWithViewportHeight:568.0];
+    self.tableViewModel.tableView = self.tableView;
+    [self.tableView reloadData];
+}
+
+- (void)tearDown
+{
+    self.tableViewModel.tableView = nil;
+    self.tableViewModel = nil;
+    self.tableView = nil;
+    [super tearDown];
+}
+
+- (NSUInteger)numberOfMeasuredRows
+{
+    @synchronized (self.measuredIndexes) {
+        return self.measuredIndexes.count;
+    }
+}
+
+- (void)waitForMeasurementOfAllRows
+{
+    NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:10.0];
+    while ([self numberOfMeasuredRows] < DXRowHeightPrecomputationNumberOfRows && [deadline timeIntervalSinceNow] > 0)
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    // measurements of the last chunk are applied on the next main queue turn
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+}
+
+- (void)testRowsAroundVisibleWindowAreMeasuredFirst
+{
+    [self.tableView scrollToOffset:44.0 * 500];
+    NSInteger center = [self.tableView.indexPathsForVisibleRows[self.tableView.indexPathsForVisibleRows.count / 2] row];
+    [self.tableViewModel precomputeRowHeights];
+    [self waitForMeasurementOfAllRows];
+
+    XCTAssertEqual([self numberOfMeasuredRows], (NSUInteger)DXRowHeightPrecomputationNumberOfRows,
+                   @"every row has to be measured exactly once");
+    for (NSInteger i = 0; i < 64; ++i) {
+        NSInteger index = [self.measuredIndexes[i] integerValue];
+        XCTAssertTrue(ABS(index - center) <= 32, @"first chunk has to be centered on the visible window");
+    }
+    DXTableViewRow *row = [self.tableViewModel rowAtIndex:0 inSectionAtIndex:0];
+    XCTAssertEqual([self.tableViewModel heightForRow:row], (CGFloat)60.0);
+}
+
+- (void)testMeasurementRestartsAfterWidthChange
+{
+    [self.tableViewModel precomputeRowHeights];
+    [self waitForMeasurementOfAllRows];
+    @synchronized (self.measuredIndexes) {
+        [self.measuredIndexes removeAllObjects];
+    }
+
+    self.tableView.frame = CGRectMake(0, 0, 768.0, 568.0);
+    [self.tableViewModel precomputeRowHeights];
+    [self waitForMeasurementOfAllRows];
+
+    XCTAssertEqual([self numberOfMeasuredRows], (NSUInteger)DXRowHeightPrecomputationNumberOfRows);
+}
+
+- (void)testRelayoutAfterMeasurementWaitsForTransaction
+{
+    [self.tableView resetStatistics];
+    [self.tableViewModel beginUpdates];
+    [self.tableViewModel precomputeRowHeights];
+    [self waitForMeasurementOfAllRows];
+
+    XCTAssertEqual(self.tableView.updateCount, (NSUInteger)0, @"visible rows are not laid out amid transaction");
+    [self.tableViewModel endUpdates];
+    XCTAssertEqual(self.tableView.updateCount, (NSUInteger)1, @"transaction lays out measured rows once");
+}
+
+@end
@@ -0,0 +1,105 @@
+//
+//  DXRowResolutionTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "DXStubTableView.h"
+#import "DXAllocationCounter.h"
+#import "DXTableViewModel.h"
+#import "DXTableViewSection.h"
+#import "DXTableViewRow.h"
+
+@interface DXRowResolutionTests : XCTestCase
+
+@property (strong, nonatomic) DXTableViewModel *tableViewModel;
+@property (strong, nonatomic) DXStubTableView *tableView;
+
+@end
+
+@implementation DXRowResolutionTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.tableViewModel = [[DXTableViewModel alloc] init];
+    for (NSInteger s = 0; s < 2; ++s) {
+        DXTableViewSection *section = [[DXTableViewSection alloc] initWithName:[NSString stringWithFormat:@"Section%ld", (long)s]];
+        section.headerTitle = section.sectionName;
+        section.headerHeight = 28.0;
+        NSMutableArray *rows = [NSMutableArray array];
+        for (NSInteger i = 0; i < 5000; ++i) {
+            DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+            row.cellClass = [UITableViewCell class];
+            // callbacks which make model respond to every per-row delegate method
+            row.rowHeightBlock = ^CGFloat(DXTableViewRow *row) {
+                return 44.0;
+            };
+            row.willDisplayCellBlock = ^(DXTableViewRow *row, UITableViewCell *cell) {
+            };
+            row.didSelectRowBlock = ^(DXTableViewRow *row) {
+            };
+            [rows addObject:row];
+        }
+        [section addRows:rows];
+        [self.tableViewModel addSection:section];
+    }
+    self.tableViewModel.didEndDisplayingCellBlock = ^(DXTableViewModel *tableViewModel, id cell, NSIndexPath *indexPath) {
+    };
+    self.tableView = [[DXStubTableView alloc] initWithViewportHeight:568.0];
+    self.tableViewModel.tableView = self.tableView;
+    [self.tableView reloadData];
+}
+
+- (void)tearDown
+{
+    self.tableViewModel.tableView = nil;
+    self.tableViewModel = nil;
+    self.tableView = nil;
+    [super tearDown];
+}
+
+- (void)testScrollPassMakesNoArrayCopies
+{
+    [DXAllocationCounter reset];
+    [self.tableView resetStatistics];
+    [self.tableView scrollThroughContentWithStep:100.0];
+    [self.tableView simulateSelectionOfRowAtIndexPath:[NSIndexPath indexPathForRow:2000 inSection:1]];
+
+    XCTAssertTrue([self.tableView countOfCallback:DXStubTableViewCallbackCellForRow] > 9000);
+    XCTAssertTrue([self.tableView countOfCallback:DXStubTableViewCallbackHeightForRow] > 9000,
+                  @"model estimates heights, so heights of rows are asked when rows are displayed");
+    XCTAssertTrue([self.tableView countOfCallback:DXStubTableViewCallbackWillDisplayCell] > 9000);
+    XCTAssertTrue([self.tableView countOfCallback:DXStubTableViewCallbackDidEndDisplayingCell] > 9000);
+    XCTAssertEqual([DXAllocationCounter arrayCopyCount], (NSUInteger)0,
+                   @"resolving rows in data source and delegate methods must not copy rows of section");
+}
+
+- (void)testReloadMakesNoArrayCopies
+{
+    [DXAllocationCounter reset];
+    [self.tableView resetStatistics];
+    [self.tableView reloadData];
+
+    XCTAssertEqual([self.tableView countOfCallback:DXStubTableViewCallbackEstimatedHeightForRow], (NSUInteger)10000);
+    XCTAssertEqual([DXAllocationCounter arrayCopyCount], (NSUInteger)0);
+}
+
+- (void)testRowAtIndexInSectionAtIndexMakesNoArrayCopies
+{
+    [DXAllocationCounter reset];
+    [DXAllocationCounter setCounting:YES];
+    DXTableViewRow *row;
+    for (NSInteger i = 0; i < 5000; ++i)
+        row = [self.tableViewModel rowAtIndex:i inSectionAtIndex:1];
+    [DXAllocationCounter setCounting:NO];
+
+    XCTAssertEqual(row, [self.tableViewModel.sections[1] rows].lastObject);
+    XCTAssertEqual([DXAllocationCounter arrayCopyCount], (NSUInteger)0);
+    XCTAssertEqual([DXAllocationCounter allocationCount], (NSUInteger)0);
+}
+
+@end
@@ -0,0 +1,125 @@
+//
+//  DXScrollBenchmarkTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import "DXBenchmarkTestCase.h"
+#import "DXStubTableView.h"
+#import "DXAllocationCounter.h"
+#import "DXTableViewModel.h"
+#import "DXTableViewSection.h"
+#import "DXTableViewRow.h"
+
+static const CGFloat DXScrollBenchmarkViewportHeight = 568.0;
+// half of the viewport per frame, as fast fling does
+static const CGFloat DXScrollBenchmarkStep = 284.0;
+
+@interface DXScrollBenchmarkTests : DXBenchmarkTestCase
+@end
+
+@implementation DXScrollBenchmarkTests
+
+- (DXTableViewModel *)tableViewModelWithNumberOfRows:(NSInteger)numberOfRows rowsPerSection:(NSInteger)rowsPerSection
+{
+    DXTableViewRow *templateRow = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+    templateRow.cellClass = [UITableViewCell class];
+    templateRow.configureCellBlock = ^(DXTableViewRow *row, UITableViewCell *cell) {
+        cell.accessoryType = UITableViewCellAccessoryNone;
+    };
+    DXTableViewModel *tableViewModel = [[DXTableViewModel alloc] init];
+    NSMutableArray *sections = [NSMutableArray array];
+    for (NSInteger first = 0; first < numberOfRows; first += rowsPerSection) {
+        DXTableViewSection *section = [[DXTableViewSection alloc] initWithName:[NSString stringWithFormat:@"%ld", (long)first]];
+        NSMutableArray *rows = [NSMutableArray array];
+        for (NSInteger i = first; i < MIN(first + rowsPerSection, numberOfRows); ++i)
+            [rows addObject:[[DXTableViewRow alloc] initWithTemplateRow:templateRow]];
+        [section addRows:rows];
+        [sections addObject:section];
+    }
+    [tableViewModel addSections:sections];
+    return tableViewModel;
+}
+
+- (void)runBenchmark:(NSString *)benchmark numberOfRows:(NSInteger)numberOfRows rowsPerSection:(NSInteger)rowsPerSection
+{
+    uint64_t memoryBefore = [DXAllocationCounter residentMemory];
+    DXTableViewModel *tableViewModel = [self tableViewModelWithNumberOfRows:numberOfRows rowsPerSection:rowsPerSection];
+    DXStubTableView *tableView = [[DXStubTableView alloc] initWithViewportHeight:DXScrollBenchmarkViewportHeight];
+    tableViewModel.tableView = tableView;
+    [tableView reloadData];
+    NSUInteger firstScreenRows = [tableView countOfCallback:DXStubTableViewCallbackCellForRow];
+    [tableView resetStatistics];
+    [DXAllocationCounter reset];
+
+    uint64_t peakMemory = [DXAllocationCounter residentMemory];
+    [tableView scrollThroughContentWithStep:DXScrollBenchmarkStep];
+    peakMemory = MAX(peakMemory, [DXAllocationCounter residentMemory]);
+
+    XCTAssertEqual(firstScreenRows + [tableView countOfCallback:DXStubTableViewCallbackCellForRow], (NSUInteger)numberOfRows,
+                   @"Every row has to be displayed exactly once");
+    double frames = tableView.frameCount;
+    [self checkMetric:@"callbacksPerFrame" value:tableView.callbackCount / frames benchmark:benchmark];
+    [self checkMetric:@"nanosecondsPerCallback"
+                value:(double)tableView.callbackNanoseconds / MAX(tableView.callbackCount, (NSUInteger)1)
+            benchmark:benchmark];
+    [self checkMetric:@"allocationsPerFrame" value:[DXAllocationCounter allocationCount] / frames benchmark:benchmark];
+    [self checkMetric:@"peakMemoryBytes" value:peakMemory > memoryBefore ? peakMemory - memoryBefore : 0
+            benchmark:benchmark];
+    tableViewModel.tableView = nil;
+}
+
+#pragma mark - One section
+
+- (void)testScrollThrough1kRowsInOneSection
+{
+    [self runBenchmark:@"OneSection1k" numberOfRows:1000 rowsPerSection:1000];
+}
+
+- (void)testScrollThrough10kRowsInOneSection
+{
+    [self runBenchmark:@"OneSection10k" numberOfRows:10000 rowsPerSection:10000];
+}
+
+- (void)testScrollThrough100kRowsInOneSection
+{
+    [self runBenchmark:@"OneSection100k" numberOfRows:100000 rowsPerSection:100000];
+}
+
+#pragma mark - Sections of 100 rows
+
+- (void)testScrollThrough1kRowsInSectionsOf100Rows
+{
+    [self runBenchmark:@"Sections100x1k" numberOfRows:1000 rowsPerSection:100];
+}
+
+- (void)testScrollThrough10kRowsInSectionsOf100Rows
+{
+    [self runBenchmark:@"Sections100x10k" numberOfRows:10000 rowsPerSection:100];
+}
+
+- (void)testScrollThrough100kRowsInSectionsOf100Rows
+{
+    [self runBenchmark:@"Sections100x100k" numberOfRows:100000 rowsPerSection:100];
+}
+
+#pragma mark - Sections of 5 rows
+
+- (void)testScrollThrough1kRowsInSectionsOf5Rows
+{
+    [self runBenchmark:@"Sections5x1k" numberOfRows:1000 rowsPerSection:5];
+}
+
+- (void)testScrollThrough10kRowsInSectionsOf5Rows
+{
+    [self runBenchmark:@"Sections5x10k" numberOfRows:10000 rowsPerSection:5];
+}
+
+- (void)testScrollThrough100kRowsInSectionsOf5Rows
+{
+    [self runBenchmark:@"Sections5x100k" numberOfRows:100000 rowsPerSection:5];
+}
+
+@end
@@ -0,0 +1,62 @@
+//
+//  DXSectionLookupTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import "DXBenchmarkTestCase.h"
+#import "DXTableViewModel.h"
+#import "DXTableViewSection.h"
+
+static const NSUInteger DXSectionLookupNumberOfLookups = 10000;
+
+@interface DXSectionLookupTests : DXBenchmarkTestCase
+@end
+
+@implementation DXSectionLookupTests
+
+- (DXTableViewModel *)tableViewModelWithNumberOfSections:(NSInteger)numberOfSections names:(NSMutableArray *)names
+{
+    DXTableViewModel *tableViewModel = [[DXTableViewModel alloc] init];
+    NSMutableArray *sections = [NSMutableArray arrayWithCapacity:numberOfSections];
+    for (NSInteger i = 0; i < numberOfSections; ++i) {
+        NSString *name = [NSString stringWithFormat:@"Section %ld", (long)i];
+        [sections addObject:[[DXTableViewSection alloc] initWithName:name]];
+        [names addObject:name];
+    }
+    [tableViewModel addSections:sections];
+    return tableViewModel;
+}
+
+// Lookups of names spread over all sections, so linear search would cost as much as half of the sections
+- (double)nanosecondsPerLookupWithNumberOfSections:(NSInteger)numberOfSections
+{
+    NSMutableArray *names = [NSMutableArray arrayWithCapacity:numberOfSections];
+    DXTableViewModel *tableViewModel = [self tableViewModelWithNumberOfSections:numberOfSections names:names];
+    __block NSInteger checksum = 0;
+    double nanoseconds = [self nanosecondsPerIteration:5 ofBlock:^{
+        for (NSUInteger i = 0; i < DXSectionLookupNumberOfLookups; ++i) {
+            NSString *name = names[(i * 7919) % names.count];
+            checksum += [tableViewModel indexOfSectionWithName:name];
+            checksum += nil != [tableViewModel sectionWithName:name];
+        }
+    }];
+    XCTAssertTrue(checksum > 0);
+    return nanoseconds / DXSectionLookupNumberOfLookups;
+}
+
+- (void)testSectionLookupsDoNotGrowWithNumberOfSections
+{
+    double fewSectionsNanoseconds = [self nanosecondsPerLookupWithNumberOfSections:10];
+    double manySectionsNanoseconds = [self nanosecondsPerLookupWithNumberOfSections:10000];
+
+    // hashing longer names and colder caches allow some growth, linear search would be a thousand times slower
+    XCTAssertTrue(manySectionsNanoseconds < fewSectionsNanoseconds * 4.0, @"%g ns with 10k sections, %g ns with 10",
+                  manySectionsNanoseconds, fewSectionsNanoseconds);
+    [self checkMetric:@"nanosecondsPerLookup" value:fewSectionsNanoseconds benchmark:@"SectionLookup10"];
+    [self checkMetric:@"nanosecondsPerLookup" value:manySectionsNanoseconds benchmark:@"SectionLookup10k"];
+}
+
+@end
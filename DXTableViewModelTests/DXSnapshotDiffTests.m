@@ -0,0 +1,152 @@
+//
+//  DXSnapshotDiffTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import "DXBenchmarkTestCase.h"
+#import "DXStubTableView.h"
+#import "DXTableViewModel.h"
+#import "DXTableViewSection.h"
+#import "DXTableViewRow.h"
+
+@interface DXSnapshotDiffTests : DXBenchmarkTestCase
+
+@property (strong, nonatomic) DXTableViewModel *tableViewModel;
+@property (strong, nonatomic) DXStubTableView *tableView;
+
+@end
+
+@implementation DXSnapshotDiffTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.tableViewModel = [[DXTableViewModel alloc] init];
+    self.tableView = [[DXStubTableView alloc] initWithViewportHeight:568.0];
+    self.tableViewModel.tableView = self.tableView;
+}
+
+- (void)tearDown
+{
+    self.tableViewModel.tableView = nil;
+    self.tableViewModel = nil;
+    self.tableView = nil;
+    [super tearDown];
+}
+
+- (DXTableViewSection *)sectionWithName:(NSString *)name identifiers:(NSArray *)identifiers
+{
+    DXTableViewSection *section = [[DXTableViewSection alloc] initWithName:name];
+    NSMutableArray *rows = [NSMutableArray arrayWithCapacity:identifiers.count];
+    for (id identifier in identifiers) {
+        DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+        row.cellClass = [UITableViewCell class];
+        row.rowIdentifier = identifier;
+        [rows addObject:row];
+    }
+    [section addRows:rows];
+    return section;
+}
+
+- (NSMutableArray *)identifiersWithCount:(NSInteger)count
+{
+    NSMutableArray *identifiers = [NSMutableArray arrayWithCapacity:count];
+    for (NSInteger i = 0; i < count; ++i)
+        [identifiers addObject:@(i)];
+    return identifiers;
+}
+
+- (void)applyIdentifiers:(NSArray *)identifiers
+{
+    [self.tableViewModel applySnapshot:@[[self sectionWithName:@"Section" identifiers:identifiers]]
+                      withRowAnimation:UITableViewRowAnimationNone];
+}
+
+- (void)testInsertionAtTopMovesNoRows
+{
+    NSMutableArray *identifiers = [self identifiersWithCount:1000];
+    [self applyIdentifiers:identifiers];
+    [self.tableView resetStatistics];
+
+    [identifiers insertObject:@(-1) atIndex:0];
+    [self applyIdentifiers:identifiers];
+
+    XCTAssertEqual(self.tableView.insertedRowCount, (NSUInteger)1);
+    XCTAssertEqual(self.tableView.deletedRowCount, (NSUInteger)0);
+    XCTAssertEqual(self.tableView.movedRowCount, (NSUInteger)0,
+                   @"rows shifted by insertion keep their relative order and must not be moved");
+}
+
+- (void)testMoveOfLastRowToTopMovesOneRow
+{
+    NSMutableArray *identifiers = [self identifiersWithCount:1000];
+    [self applyIdentifiers:identifiers];
+    [self.tableView resetStatistics];
+
+    id last = identifiers.lastObject;
+    [identifiers removeLastObject];
+    [identifiers insertObject:last atIndex:0];
+    [self applyIdentifiers:identifiers];
+
+    XCTAssertEqual(self.tableView.movedRowCount, (NSUInteger)1);
+    XCTAssertEqual(self.tableView.insertedRowCount, (NSUInteger)0);
+    XCTAssertEqual(self.tableView.deletedRowCount, (NSUInteger)0);
+}
+
+- (void)testSwapOfSectionsMovesOneSection
+{
+    NSArray *sections = @[[self sectionWithName:@"A" identifiers:@[@1, @2]],
+                          [self sectionWithName:@"B" identifiers:@[@3]],
+                          [self sectionWithName:@"C" identifiers:@[@4]]];
+    [self.tableViewModel applySnapshot:sections withRowAnimation:UITableViewRowAnimationNone];
+    [self.tableView resetStatistics];
+
+    sections = @[[self sectionWithName:@"C" identifiers:@[@4]],
+                 [self sectionWithName:@"A" identifiers:@[@1, @2]],
+                 [self sectionWithName:@"B" identifiers:@[@3]]];
+    [self.tableViewModel applySnapshot:sections withRowAnimation:UITableViewRowAnimationNone];
+
+    XCTAssertEqual(self.tableView.movedSectionCount, (NSUInteger)1);
+    XCTAssertEqual(self.tableView.movedRowCount, (NSUInteger)0);
+}
+
+- (void)testAnimationIsPassedToTableView
+{
+    [self applyIdentifiers:[self identifiersWithCount:10]];
+    [self.tableView resetStatistics];
+
+    [self.tableViewModel applySnapshot:@[[self sectionWithName:@"Section" identifiers:@[@0, @1, @2]]]
+                      withRowAnimation:UITableViewRowAnimationFade];
+
+    XCTAssertEqual(self.tableView.deletedRowCount, (NSUInteger)7);
+    XCTAssertEqual(self.tableView.lastRowAnimation, UITableViewRowAnimationFade);
+}
+
+- (void)testDiffOf10kRowsWithFewMoves
+{
+    NSMutableArray *identifiers = [self identifiersWithCount:10000];
+    [self applyIdentifiers:identifiers];
+
+    __block NSUInteger diffs = 0;
+    __block NSUInteger movedRows = 0;
+    double nanoseconds = [self nanosecondsPerIteration:10 ofBlock:^{
+        // ten rows from the bottom jump to random positions, as live updated feed does
+        for (NSInteger i = 0; i < 10; ++i) {
+            id identifier = identifiers.lastObject;
+            [identifiers removeLastObject];
+            [identifiers insertObject:identifier atIndex:arc4random_uniform((u_int32_t)identifiers.count)];
+        }
+        [self.tableView resetStatistics];
+        [self applyIdentifiers:identifiers];
+        movedRows += self.tableView.movedRowCount;
+        ++diffs;
+    }];
+
+    [self checkMetric:@"nanosecondsPerDiff" value:nanoseconds benchmark:@"SnapshotDiff10k"];
+    [self checkMetric:@"movedRowsPerDiff" value:(double)movedRows / diffs benchmark:@"SnapshotDiff10k"];
+}
+
+@end
@@ -0,0 +1,150 @@
+//
+//  DXSortedSectionTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "DXStubTableView.h"
+#import "DXTableViewModel.h"
+#import "DXTableViewSection.h"
+#import "DXTableViewRow.h"
+
+@interface DXSortedSectionTests : XCTestCase
+
+@property (strong, nonatomic) DXTableViewModel *tableViewModel;
+@property (strong, nonatomic) DXTableViewSection *section;
+@property (strong, nonatomic) DXStubTableView *tableView;
+
+@end
+
+@implementation DXSortedSectionTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.section = [[DXTableViewSection alloc] initWithName:@"Items"];
+    NSMutableArray *rows = [NSMutableArray array];
+    for (NSString *name in @[@"c", @"a", @"d", @"b"]) {
+        DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+        row.cellClass = [UITableViewCell class];
+        row.cellText = name;
+        row[@"owner.name"] = name;
+        [rows addObject:row];
+    }
+    [self.section addRows:rows];
+    self.tableViewModel = [[DXTableViewModel alloc] init];
+    [self.tableViewModel addSection:self.section];
+    self.tableView = [[DXStubTableView alloc] initWithViewportHeight:568.0];
+    self.tableViewModel.tableView = self.tableView;
+    [self.tableView reloadData];
+    [self.tableView resetStatistics];
+}
+
+- (void)tearDown
+{
+    self.tableViewModel.tableView = nil;
+    self.tableViewModel = nil;
+    self.section = nil;
+    self.tableView = nil;
+    [super tearDown];
+}
+
+- (NSArray *)names
+{
+    return [self.section.rows valueForKey:@"cellText"];
+}
+
+- (void)testSortDescriptorKeyIsBoundKeyNotKeyPath
+{
+    self.section.sortDescriptors = @[[NSSortDescriptor sortDescriptorWithKey:@"owner.name" ascending:YES]];
+
+    XCTAssertEqualObjects([self names], (@[@"a", @"b", @"c", @"d"]));
+}
+
+- (void)testSettingSortDescriptorsMovesRowsInTableView
+{
+    self.section.sortDescriptors = @[[NSSortDescriptor sortDescriptorWithKey:@"owner.name" ascending:NO]];
+
+    XCTAssertEqualObjects([self names], (@[@"d", @"c", @"b", @"a"]));
+    XCTAssertTrue(self.tableView.movedRowCount > 0);
+    XCTAssertEqual(self.tableView.insertedRowCount, (NSUInteger)0);
+    XCTAssertEqual(self.tableView.deletedRowCount, (NSUInteger)0);
+}
+
+- (DXTableViewRow *)rowWithName:(NSString *)name
+{
+    DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+    row.cellClass = [UITableViewCell class];
+    row.cellText = name;
+    row[@"owner.name"] = name;
+    return row;
+}
+
+- (void)testRowsCanOnlyBeAddedToSortedSection
+{
+    self.section.sortDescriptors = @[[NSSortDescriptor sortDescriptorWithKey:@"owner.name" ascending:YES]];
+
+    XCTAssertThrowsSpecificNamed([self.section insertRow:[self rowWithName:@"e"] atIndex:0],
+                                 NSException, NSInvalidArgumentException);
+    XCTAssertThrowsSpecificNamed([self.section insertRows:@[[self rowWithName:@"f"]] atIndex:1
+                                         withRowAnimation:UITableViewRowAnimationFade],
+                                 NSException, NSInvalidArgumentException);
+    XCTAssertEqualObjects([self names], (@[@"a", @"b", @"c", @"d"]));
+
+    [self.tableView resetStatistics];
+    [self.section insertRows:@[[self rowWithName:@"bb"]] afterRow:nil withRowAnimation:UITableViewRowAnimationFade];
+
+    XCTAssertEqualObjects([self names], (@[@"a", @"b", @"bb", @"c", @"d"]));
+    XCTAssertEqual(self.tableView.insertedRowCount, (NSUInteger)1);
+}
+
+- (void)testRowsOfSortedSectionCannotBeReordered
+{
+    self.section.sortDescriptors = @[[NSSortDescriptor sortDescriptorWithKey:@"owner.name" ascending:YES]];
+    DXTableViewSection *otherSection = [[DXTableViewSection alloc] initWithName:@"Other"];
+    DXTableViewRow *otherRow = [self rowWithName:@"z"];
+    otherRow.canMoveRow = YES;
+    [otherSection addRow:otherRow];
+    [self.tableViewModel addSection:otherSection];
+    for (DXTableViewRow *row in self.section.rows)
+        row.canMoveRow = YES;
+    NSIndexPath *indexPath = [NSIndexPath indexPathForRow:0 inSection:0];
+    NSIndexPath *otherIndexPath = [NSIndexPath indexPathForRow:0 inSection:1];
+
+    XCTAssertFalse([self.tableViewModel tableView:self.tableView canMoveRowAtIndexPath:indexPath]);
+    XCTAssertTrue([self.tableViewModel tableView:self.tableView canMoveRowAtIndexPath:otherIndexPath]);
+    XCTAssertEqualObjects([self.tableViewModel tableView:self.tableView targetIndexPathForMoveFromRowAtIndexPath:otherIndexPath
+                                                                                            toProposedIndexPath:indexPath],
+                          otherIndexPath);
+    XCTAssertThrowsSpecificNamed([self.tableViewModel tableView:self.tableView moveRowAtIndexPath:otherIndexPath
+                                                    toIndexPath:indexPath],
+                                 NSException, NSInternalInconsistencyException);
+    XCTAssertThrowsSpecificNamed([self.section moveRow:self.section.rows[0] toIndexPath:[NSIndexPath indexPathForRow:3 inSection:0]],
+                                 NSException, NSInternalInconsistencyException);
+    XCTAssertEqualObjects([self names], (@[@"a", @"b", @"c", @"d"]));
+    XCTAssertEqual(otherSection.numberOfRows, (NSInteger)1);
+}
+
+- (void)testRowsSortedWhileFilteredAreSortedWhenFilterIsRemoved
+{
+    __block BOOL filtered = NO;
+    self.tableViewModel.filterPredicate = [NSPredicate predicateWithFormat:@"cellText != $query"];
+    self.tableViewModel.didFilterRowsBlock = ^(DXTableViewModel *tableViewModel) {
+        filtered = YES;
+    };
+    [self.tableViewModel filterRowsWithQuery:@"d"];
+    NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:5.0];
+    while (!filtered && [timeout timeIntervalSinceNow] > 0)
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    XCTAssertEqual(self.section.numberOfRows, (NSInteger)3);
+
+    self.section.sortDescriptors = @[[NSSortDescriptor sortDescriptorWithKey:@"owner.name" ascending:YES]];
+    [self.tableViewModel filterRowsWithQuery:nil];
+
+    XCTAssertEqualObjects([self names], (@[@"a", @"b", @"c", @"d"]));
+}
+
+@end
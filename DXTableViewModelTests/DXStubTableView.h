@@ -0,0 +1,148 @@
+//
+//  DXStubTableView.h
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+
+/** Data source and delegate methods which stub table view sends and counts.
+ */
+typedef NS_ENUM(NSUInteger, DXStubTableViewCallback) {
+    DXStubTableViewCallbackNumberOfSections = 0,
+    DXStubTableViewCallbackNumberOfRows,
+    DXStubTableViewCallbackTitleForHeader,
+    DXStubTableViewCallbackTitleForFooter,
+    DXStubTableViewCallbackHeightForRow,
+    DXStubTableViewCallbackEstimatedHeightForRow,
+    DXStubTableViewCallbackHeightForHeader,
+    DXStubTableViewCallbackHeightForFooter,
+    DXStubTableViewCallbackCellForRow,
+    DXStubTableViewCallbackWillDisplayCell,
+    DXStubTableViewCallbackDidEndDisplayingCell,
+    DXStubTableViewCallbackViewForHeader,
+    DXStubTableViewCallbackViewForFooter,
+    DXStubTableViewCallbackWillDisplayHeaderView,
+    DXStubTableViewCallbackWillDisplayFooterView,
+    DXStubTableViewCallbackDidEndDisplayingHeaderView,
+    DXStubTableViewCallbackDidEndDisplayingFooterView,
+    DXStubTableViewCallbackPrefetchRows,
+    DXStubTableViewCallbackCancelPrefetching,
+    DXStubTableViewCallbackDidSelectRow,
+    DXStubTableViewCallbackCount
+};
+
+/** Table view which never lays out and never draws, but sends data source and delegate methods in the same order
+ as UIKit does while its viewport is scrolled by a test.
+
+ Stub asks for numbers of rows and for heights on reloadData, then sends `tableView:cellForRowAtIndexPath:`,
+ `tableView:willDisplayCell:forRowAtIndexPath:` and `tableView:didEndDisplayingCell:forRowAtIndexPath:`
+ for rows entering and leaving the viewport. Like UIKit it checks which optional methods delegate and data source
+ respond to only when they are assigned.
+
+ Rows stay at their estimated offsets when estimated heights are in use. Cells are kept in reuse pools
+ and are never added to view hierarchy.
+ */
+@interface DXStubTableView : UITableView
+
+/** Initializes stub with viewport of given height.
+ */
+- (instancetype)initWithViewportHeight:(CGFloat)viewportHeight;
+
+/// @name Scrolling
+
+/** Height of scrollable content computed on last reload or update.
+ */
+@property (nonatomic, readonly) CGFloat simulatedContentHeight;
+
+/** Offset of the top of the viewport.
+ */
+@property (nonatomic, readonly) CGFloat simulatedContentOffset;
+
+/** Number of rows to ask prefetching data source for below the viewport, default is 10.
+ */
+@property (nonatomic) NSUInteger prefetchDistance;
+
+/** Moves the viewport to given offset displaying rows entering it and ending display of rows leaving it.
+ Every call counts as one frame.
+ */
+- (void)scrollToOffset:(CGFloat)offset;
+
+/** Scrolls from the top to the bottom of the content by steps of given height.
+ @return Number of simulated frames.
+ */
+- (NSUInteger)scrollThroughContentWithStep:(CGFloat)step;
+
+/** Sends `tableView:didSelectRowAtIndexPath:` like a tap on the row does.
+ */
+- (void)simulateSelectionOfRowAtIndexPath:(NSIndexPath *)indexPath;
+
+/// @name Statistics
+
+/** Number of times given callback was sent since last resetStatistics.
+ */
+- (NSUInteger)countOfCallback:(DXStubTableViewCallback)callback;
+
+/** Total number of callbacks sent since last resetStatistics.
+ */
+@property (nonatomic, readonly) NSUInteger callbackCount;
+
+/** Time spent inside of data source and delegate since last resetStatistics.
+ */
+@property (nonatomic, readonly) uint64_t callbackNanoseconds;
+
+/** Number of frames simulated since last resetStatistics.
+ */
+@property (nonatomic, readonly) NSUInteger frameCount;
+
+/** Number of cells created because reuse pool was empty.
+ */
+@property (nonatomic, readonly) NSUInteger createdCellCount;
+
+/** Number of times delegate or data source was assigned, including assignments of nil.
+ */
+@property (nonatomic, readonly) NSUInteger delegateAssignmentCount;
+
+/** Number of batch and single row or section updates applied to stub.
+ */
+@property (nonatomic, readonly) NSUInteger updateCount;
+
+/** Number of rows and sections inserted, deleted, reloaded and moved by updates.
+ */
+@property (nonatomic, readonly) NSUInteger insertedRowCount;
+@property (nonatomic, readonly) NSUInteger deletedRowCount;
+@property (nonatomic, readonly) NSUInteger reloadedRowCount;
+@property (nonatomic, readonly) NSUInteger movedRowCount;
+@property (nonatomic, readonly) NSUInteger insertedSectionCount;
+@property (nonatomic, readonly) NSUInteger deletedSectionCount;
+@property (nonatomic, readonly) NSUInteger reloadedSectionCount;
+@property (nonatomic, readonly) NSUInteger movedSectionCount;
+
+/** Index paths given to every `reloadRowsAtIndexPaths:withRowAnimation:` call since last resetStatistics, as arrays.
+ */
+@property (nonatomic, readonly) NSArray *reloadedIndexPathBatches;
+
+/** Animation given to the last insertion, deletion or reload of rows or sections.
+ */
+@property (nonatomic, readonly) UITableViewRowAnimation lastRowAnimation;
+
+/** Animations given to insertions, deletions and reloads of rows or sections since last resetStatistics, as NSNumbers.
+ */
+@property (nonatomic, readonly) NSSet *rowAnimations;
+
+/** Number of full reloads.
+ */
+@property (nonatomic, readonly) NSUInteger reloadCount;
+
+/** Number of classes and nibs registered for cells and header-footer views since stub was created,
+ resetStatistics keeps it.
+ */
+@property (nonatomic, readonly) NSUInteger registrationCount;
+
+/** Resets all counters, but keeps the viewport where it is.
+ */
+- (void)resetStatistics;
+
+@end
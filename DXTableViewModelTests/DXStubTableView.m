@@ -0,0 +1,769 @@
+//
+//  DXStubTableView.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import "DXStubTableView.h"
+#import "DXAllocationCounter.h"
+#import <mach/mach_time.h>
+
+// Selectors of optional callbacks which stub checks on assignment of delegate and data source, like UIKit does
+static SEL DXStubTableViewSelectors[DXStubTableViewCallbackCount];
+
+static void DXStubTableViewInitializeSelectors(void)
+{
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        DXStubTableViewSelectors[DXStubTableViewCallbackNumberOfSections] = @selector(numberOfSectionsInTableView:);
+        DXStubTableViewSelectors[DXStubTableViewCallbackNumberOfRows] = @selector(tableView:numberOfRowsInSection:);
+        DXStubTableViewSelectors[DXStubTableViewCallbackTitleForHeader] = @selector(tableView:titleForHeaderInSection:);
+        DXStubTableViewSelectors[DXStubTableViewCallbackTitleForFooter] = @selector(tableView:titleForFooterInSection:);
+        DXStubTableViewSelectors[DXStubTableViewCallbackHeightForRow] = @selector(tableView:heightForRowAtIndexPath:);
+        DXStubTableViewSelectors[DXStubTableViewCallbackEstimatedHeightForRow] =
+            @selector(tableView:estimatedHeightForRowAtIndexPath:);
+        DXStubTableViewSelectors[DXStubTableViewCallbackHeightForHeader] = @selector(tableView:heightForHeaderInSection:);
+        DXStubTableViewSelectors[DXStubTableViewCallbackHeightForFooter] = @selector(tableView:heightForFooterInSection:);
+        DXStubTableViewSelectors[DXStubTableViewCallbackCellForRow] = @selector(tableView:cellForRowAtIndexPath:);
+        DXStubTableViewSelectors[DXStubTableViewCallbackWillDisplayCell] =
+            @selector(tableView:willDisplayCell:forRowAtIndexPath:);
+        DXStubTableViewSelectors[DXStubTableViewCallbackDidEndDisplayingCell] =
+            @selector(tableView:didEndDisplayingCell:forRowAtIndexPath:);
+        DXStubTableViewSelectors[DXStubTableViewCallbackViewForHeader] = @selector(tableView:viewForHeaderInSection:);
+        DXStubTableViewSelectors[DXStubTableViewCallbackViewForFooter] = @selector(tableView:viewForFooterInSection:);
+        DXStubTableViewSelectors[DXStubTableViewCallbackWillDisplayHeaderView] =
+            @selector(tableView:willDisplayHeaderView:forSection:);
+        DXStubTableViewSelectors[DXStubTableViewCallbackWillDisplayFooterView] =
+            @selector(tableView:willDisplayFooterView:forSection:);
+        DXStubTableViewSelectors[DXStubTableViewCallbackDidEndDisplayingHeaderView] =
+            @selector(tableView:didEndDisplayingHeaderView:forSection:);
+        DXStubTableViewSelectors[DXStubTableViewCallbackDidEndDisplayingFooterView] =
+            @selector(tableView:didEndDisplayingFooterView:forSection:);
+        DXStubTableViewSelectors[DXStubTableViewCallbackPrefetchRows] = @selector(tableView:prefetchRowsAtIndexPaths:);
+        DXStubTableViewSelectors[DXStubTableViewCallbackCancelPrefetching] =
+            @selector(tableView:cancelPrefetchingForRowsAtIndexPaths:);
+        DXStubTableViewSelectors[DXStubTableViewCallbackDidSelectRow] = @selector(tableView:didSelectRowAtIndexPath:);
+    });
+}
+
+static uint64_t DXStubTableViewNanoseconds(uint64_t machTime)
+{
+    static mach_timebase_info_data_t timebase;
+    if (0 == timebase.denom)
+        mach_timebase_info(&timebase);
+    return machTime * timebase.numer / timebase.denom;
+}
+
+@interface DXStubTableView ()
+{
+    // which optional callbacks delegate, data source and prefetching data source answered on assignment
+    BOOL _responds[DXStubTableViewCallbackCount];
+    NSUInteger _callbackCounts[DXStubTableViewCallbackCount];
+    NSInteger _numberOfSections;
+    NSInteger *_numberOfRows;
+    // every section occupies header item, its rows and footer item
+    NSInteger *_sectionFirstItems;
+    CGFloat *_itemOffsets;
+    NSInteger _itemCount;
+    NSInteger _firstVisibleItem;
+    NSInteger _lastVisibleItem;
+    BOOL _estimatesHeights;
+    NSInteger _updatesDepth;
+}
+
+@property (nonatomic) CGFloat viewportHeight;
+@property (nonatomic, readwrite) CGFloat simulatedContentHeight;
+@property (nonatomic, readwrite) CGFloat simulatedContentOffset;
+@property (nonatomic, readwrite) NSUInteger callbackCount;
+@property (nonatomic, readwrite) uint64_t callbackNanoseconds;
+@property (nonatomic, readwrite) NSUInteger frameCount;
+@property (nonatomic, readwrite) NSUInteger createdCellCount;
+@property (nonatomic, readwrite) NSUInteger delegateAssignmentCount;
+@property (nonatomic, readwrite) NSUInteger registrationCount;
+@property (nonatomic, readwrite) NSUInteger updateCount;
+@property (nonatomic, readwrite) NSUInteger insertedRowCount;
+@property (nonatomic, readwrite) NSUInteger deletedRowCount;
+@property (nonatomic, readwrite) NSUInteger reloadedRowCount;
+@property (nonatomic, readwrite) NSUInteger movedRowCount;
+@property (nonatomic, readwrite) NSUInteger insertedSectionCount;
+@property (nonatomic, readwrite) NSUInteger deletedSectionCount;
+@property (nonatomic, readwrite) NSUInteger reloadedSectionCount;
+@property (nonatomic, readwrite) NSUInteger movedSectionCount;
+@property (nonatomic, readwrite) NSUInteger reloadCount;
+@property (nonatomic, readwrite) UITableViewRowAnimation lastRowAnimation;
+@property (nonatomic, strong) NSMutableSet *usedRowAnimations;
+@property (nonatomic, strong) NSMutableArray *mutableReloadedIndexPathBatches;
+
+@property (nonatomic, strong) NSMutableDictionary *cellClasses;
+@property (nonatomic, strong) NSMutableDictionary *cellNibs;
+@property (nonatomic, strong) NSMutableDictionary *headerFooterClasses;
+@property (nonatomic, strong) NSMutableDictionary *reusableCells;
+@property (nonatomic, strong) NSMutableDictionary *displayedCells;
+@property (nonatomic, strong) NSMutableDictionary *visibleHeaderFooterViews;
+@property (nonatomic, strong) NSMutableSet *prefetchedIndexPaths;
+
+@end
+
+@implementation DXStubTableView
+
+- (instancetype)initWithViewportHeight:(CGFloat)viewportHeight
+{
+    self = [super initWithFrame:CGRectMake(0, 0, 320, viewportHeight) style:UITableViewStylePlain];
+    if (self) {
+        _viewportHeight = viewportHeight;
+        _prefetchDistance = 10;
+        _cellClasses = [NSMutableDictionary dictionary];
+        _cellNibs = [NSMutableDictionary dictionary];
+        _headerFooterClasses = [NSMutableDictionary dictionary];
+        _reusableCells = [NSMutableDictionary dictionary];
+        _displayedCells = [NSMutableDictionary dictionary];
+        _visibleHeaderFooterViews = [NSMutableDictionary dictionary];
+        _prefetchedIndexPaths = [NSMutableSet set];
+        // heights UIKit used before self-sizing became the default
+        self.rowHeight = 44.0;
+        self.estimatedRowHeight = 0.0;
+        self.sectionHeaderHeight = 0.0;
+        self.sectionFooterHeight = 0.0;
+        self.estimatedSectionHeaderHeight = 0.0;
+        self.estimatedSectionFooterHeight = 0.0;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_numberOfRows);
+    free(_sectionFirstItems);
+    free(_itemOffsets);
+}
+
+- (void)layoutSubviews
+{
+    // stub is laid out only by scrollToOffset:
+}
+
+#pragma mark - Delegate and data source
+
+- (void)setDataSource:(id<UITableViewDataSource>)dataSource
+{
+    [super setDataSource:dataSource];
+    self.delegateAssignmentCount++;
+    [self updateRespondedCallbacks];
+}
+
+- (void)setDelegate:(id<UITableViewDelegate>)delegate
+{
+    [super setDelegate:delegate];
+    self.delegateAssignmentCount++;
+    [self updateRespondedCallbacks];
+}
+
+- (void)setPrefetchDataSource:(id<UITableViewDataSourcePrefetching>)prefetchDataSource
+{
+    [super setPrefetchDataSource:prefetchDataSource];
+    self.delegateAssignmentCount++;
+    [self updateRespondedCallbacks];
+}
+
+- (id)receiverOfCallback:(DXStubTableViewCallback)callback
+{
+    switch (callback) {
+        case DXStubTableViewCallbackNumberOfSections:
+        case DXStubTableViewCallbackNumberOfRows:
+        case DXStubTableViewCallbackTitleForHeader:
+        case DXStubTableViewCallbackTitleForFooter:
+        case DXStubTableViewCallbackCellForRow:
+            return self.dataSource;
+        case DXStubTableViewCallbackPrefetchRows:
+        case DXStubTableViewCallbackCancelPrefetching:
+            return self.prefetchDataSource;
+        default:
+            return self.delegate;
+    }
+}
+
+- (void)updateRespondedCallbacks
+{
+    DXStubTableViewInitializeSelectors();
+    for (NSUInteger callback = 0; callback < DXStubTableViewCallbackCount; ++callback)
+        _responds[callback] = [[self receiverOfCallback:callback] respondsToSelector:DXStubTableViewSelectors[callback]];
+}
+
+#pragma mark - Statistics
+
+- (NSUInteger)countOfCallback:(DXStubTableViewCallback)callback
+{
+    return _callbackCounts[callback];
+}
+
+- (void)resetStatistics
+{
+    memset(_callbackCounts, 0, sizeof(_callbackCounts));
+    self.callbackCount = 0;
+    self.callbackNanoseconds = 0;
+    self.frameCount = 0;
+    self.createdCellCount = 0;
+    self.delegateAssignmentCount = 0;
+    self.updateCount = 0;
+    self.insertedRowCount = 0;
+    self.deletedRowCount = 0;
+    self.reloadedRowCount = 0;
+    self.movedRowCount = 0;
+    self.insertedSectionCount = 0;
+    self.deletedSectionCount = 0;
+    self.reloadedSectionCount = 0;
+    self.movedSectionCount = 0;
+    self.reloadCount = 0;
+    [self.usedRowAnimations removeAllObjects];
+    [self.mutableReloadedIndexPathBatches removeAllObjects];
+}
+
+- (NSSet *)rowAnimations
+{
+    return self.usedRowAnimations.copy ?: [NSSet set];
+}
+
+- (NSArray *)reloadedIndexPathBatches
+{
+    return self.mutableReloadedIndexPathBatches.copy ?: @[];
+}
+
+// Every callback runs between these two calls, allocations are counted only inside of callbacks
+- (uint64_t)willSendCallback
+{
+    [DXAllocationCounter setCounting:YES];
+    return mach_absolute_time();
+}
+
+- (void)didSendCallback:(DXStubTableViewCallback)callback startTime:(uint64_t)startTime
+{
+    uint64_t endTime = mach_absolute_time();
+    [DXAllocationCounter setCounting:NO];
+    _callbackCounts[callback]++;
+    _callbackCount++;
+    _callbackNanoseconds += DXStubTableViewNanoseconds(endTime - startTime);
+}
+
+#pragma mark - Layout
+
+- (NSInteger)sectionOfItem:(NSInteger)item
+{
+    NSInteger low = 0, high = _numberOfSections - 1;
+    while (low < high) {
+        NSInteger middle = (low + high + 1) / 2;
+        if (_sectionFirstItems[middle] <= item)
+            low = middle;
+        else
+            high = middle - 1;
+    }
+    return low;
+}
+
+// Returns NSNotFound for header and NSIntegerMax for footer
+- (NSInteger)rowOfItem:(NSInteger)item inSection:(NSInteger)section
+{
+    NSInteger row = item - _sectionFirstItems[section] - 1;
+    if (row < 0)
+        return NSNotFound;
+    if (row >= _numberOfRows[section])
+        return NSIntegerMax;
+    return row;
+}
+
+- (CGFloat)heightOfHeaderOrFooter:(BOOL)header inSection:(NSInteger)section
+{
+    DXStubTableViewCallback callback = header ?
+        DXStubTableViewCallbackHeightForHeader : DXStubTableViewCallbackHeightForFooter;
+    CGFloat height = header ? self.sectionHeaderHeight : self.sectionFooterHeight;
+    if (_responds[callback]) {
+        uint64_t startTime = [self willSendCallback];
+        height = header ? [self.delegate tableView:self heightForHeaderInSection:section] :
+            [self.delegate tableView:self heightForFooterInSection:section];
+        [self didSendCallback:callback startTime:startTime];
+    }
+    return MAX(height, 0.0);
+}
+
+- (CGFloat)layoutHeightOfRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    CGFloat height;
+    uint64_t startTime;
+    if (_estimatesHeights) {
+        height = self.estimatedRowHeight;
+        if (_responds[DXStubTableViewCallbackEstimatedHeightForRow]) {
+            startTime = [self willSendCallback];
+            height = [self.delegate tableView:self estimatedHeightForRowAtIndexPath:indexPath];
+            [self didSendCallback:DXStubTableViewCallbackEstimatedHeightForRow startTime:startTime];
+        }
+    }
+    else {
+        height = self.rowHeight;
+        if (_responds[DXStubTableViewCallbackHeightForRow]) {
+            startTime = [self willSendCallback];
+            height = [self.delegate tableView:self heightForRowAtIndexPath:indexPath];
+            [self didSendCallback:DXStubTableViewCallbackHeightForRow startTime:startTime];
+        }
+    }
+    return height < 0.0 ? 44.0 : height;
+}
+
+// Asks for numbers of sections and rows, titles and heights
+- (void)layoutContents
+{
+    uint64_t startTime;
+    NSInteger numberOfSections = 1;
+    if (_responds[DXStubTableViewCallbackNumberOfSections]) {
+        startTime = [self willSendCallback];
+        numberOfSections = [self.dataSource numberOfSectionsInTableView:self];
+        [self didSendCallback:DXStubTableViewCallbackNumberOfSections startTime:startTime];
+    }
+    free(_numberOfRows);
+    free(_sectionFirstItems);
+    _numberOfSections = numberOfSections;
+    _numberOfRows = calloc(MAX(numberOfSections, 1), sizeof(NSInteger));
+    _sectionFirstItems = calloc(MAX(numberOfSections, 1), sizeof(NSInteger));
+    _itemCount = 0;
+    for (NSInteger section = 0; section < numberOfSections; ++section) {
+        startTime = [self willSendCallback];
+        _numberOfRows[section] = [self.dataSource tableView:self numberOfRowsInSection:section];
+        [self didSendCallback:DXStubTableViewCallbackNumberOfRows startTime:startTime];
+        _sectionFirstItems[section] = _itemCount;
+        _itemCount += _numberOfRows[section] + 2;
+        if (_responds[DXStubTableViewCallbackTitleForHeader]) {
+            startTime = [self willSendCallback];
+            [self.dataSource tableView:self titleForHeaderInSection:section];
+            [self didSendCallback:DXStubTableViewCallbackTitleForHeader startTime:startTime];
+        }
+        if (_responds[DXStubTableViewCallbackTitleForFooter]) {
+            startTime = [self willSendCallback];
+            [self.dataSource tableView:self titleForFooterInSection:section];
+            [self didSendCallback:DXStubTableViewCallbackTitleForFooter startTime:startTime];
+        }
+    }
+    _estimatesHeights = self.estimatedRowHeight > 0.0 || _responds[DXStubTableViewCallbackEstimatedHeightForRow];
+    free(_itemOffsets);
+    _itemOffsets = malloc((_itemCount + 1) * sizeof(CGFloat));
+    CGFloat offset = 0.0;
+    NSInteger item = 0;
+    for (NSInteger section = 0; section < numberOfSections; ++section) {
+        _itemOffsets[item++] = offset;
+        offset += [self heightOfHeaderOrFooter:YES inSection:section];
+        for (NSInteger row = 0; row < _numberOfRows[section]; ++row) {
+            _itemOffsets[item++] = offset;
+            offset += [self layoutHeightOfRowAtIndexPath:[NSIndexPath indexPathForRow:row inSection:section]];
+        }
+        _itemOffsets[item++] = offset;
+        offset += [self heightOfHeaderOrFooter:NO inSection:section];
+    }
+    _itemOffsets[item] = offset;
+    self.simulatedContentHeight = offset;
+}
+
+// Index of first item whose bottom is below given offset
+- (NSInteger)itemEndingBelowOffset:(CGFloat)offset
+{
+    NSInteger low = 0, high = _itemCount;
+    while (low < high) {
+        NSInteger middle = (low + high) / 2;
+        if (_itemOffsets[middle + 1] > offset)
+            high = middle;
+        else
+            low = middle + 1;
+    }
+    return low;
+}
+
+// Index of first item whose top is at or below given offset
+- (NSInteger)itemStartingAtOrBelowOffset:(CGFloat)offset
+{
+    NSInteger low = 0, high = _itemCount;
+    while (low < high) {
+        NSInteger middle = (low + high) / 2;
+        if (_itemOffsets[middle] >= offset)
+            high = middle;
+        else
+            low = middle + 1;
+    }
+    return low;
+}
+
+#pragma mark - Displaying
+
+- (void)displayItem:(NSInteger)item
+{
+    if (_itemOffsets[item + 1] <= _itemOffsets[item])
+        return;
+    NSInteger section = [self sectionOfItem:item];
+    NSInteger row = [self rowOfItem:item inSection:section];
+    uint64_t startTime;
+    if (NSNotFound == row || NSIntegerMax == row) {
+        BOOL header = NSNotFound == row;
+        UIView *view;
+        DXStubTableViewCallback callback = header ?
+            DXStubTableViewCallbackViewForHeader : DXStubTableViewCallbackViewForFooter;
+        if (_responds[callback]) {
+            startTime = [self willSendCallback];
+            view = header ? [self.delegate tableView:self viewForHeaderInSection:section] :
+                [self.delegate tableView:self viewForFooterInSection:section];
+            [self didSendCallback:callback startTime:startTime];
+        }
+        if (nil == view)
+            view = [[UITableViewHeaderFooterView alloc] initWithReuseIdentifier:nil];
+        self.visibleHeaderFooterViews[@(item)] = view;
+        callback = header ? DXStubTableViewCallbackWillDisplayHeaderView : DXStubTableViewCallbackWillDisplayFooterView;
+        if (_responds[callback]) {
+            startTime = [self willSendCallback];
+            if (header)
+                [self.delegate tableView:self willDisplayHeaderView:view forSection:section];
+            else
+                [self.delegate tableView:self willDisplayFooterView:view forSection:section];
+            [self didSendCallback:callback startTime:startTime];
+        }
+        return;
+    }
+    NSIndexPath *indexPath = [NSIndexPath indexPathForRow:row inSection:section];
+    [self.prefetchedIndexPaths removeObject:indexPath];
+    if (_estimatesHeights && _responds[DXStubTableViewCallbackHeightForRow]) {
+        startTime = [self willSendCallback];
+        [self.delegate tableView:self heightForRowAtIndexPath:indexPath];
+        [self didSendCallback:DXStubTableViewCallbackHeightForRow startTime:startTime];
+    }
+    startTime = [self willSendCallback];
+    UITableViewCell *cell = [self.dataSource tableView:self cellForRowAtIndexPath:indexPath];
+    [self didSendCallback:DXStubTableViewCallbackCellForRow startTime:startTime];
+    if (nil == cell)
+        [NSException raise:NSInternalInconsistencyException
+                    format:@"Data source returned nil cell for row at %@", indexPath];
+    self.displayedCells[indexPath] = cell;
+    if (_responds[DXStubTableViewCallbackWillDisplayCell]) {
+        startTime = [self willSendCallback];
+        [self.delegate tableView:self willDisplayCell:cell forRowAtIndexPath:indexPath];
+        [self didSendCallback:DXStubTableViewCallbackWillDisplayCell startTime:startTime];
+    }
+}
+
+- (void)endDisplayingItem:(NSInteger)item
+{
+    if (_itemOffsets[item + 1] <= _itemOffsets[item])
+        return;
+    NSInteger section = [self sectionOfItem:item];
+    NSInteger row = [self rowOfItem:item inSection:section];
+    uint64_t startTime;
+    if (NSNotFound == row || NSIntegerMax == row) {
+        BOOL header = NSNotFound == row;
+        UIView *view = self.visibleHeaderFooterViews[@(item)];
+        [self.visibleHeaderFooterViews removeObjectForKey:@(item)];
+        DXStubTableViewCallback callback = header ?
+            DXStubTableViewCallbackDidEndDisplayingHeaderView : DXStubTableViewCallbackDidEndDisplayingFooterView;
+        if (nil != view && _responds[callback]) {
+            startTime = [self willSendCallback];
+            if (header)
+                [self.delegate tableView:self didEndDisplayingHeaderView:view forSection:section];
+            else
+                [self.delegate tableView:self didEndDisplayingFooterView:view forSection:section];
+            [self didSendCallback:callback startTime:startTime];
+        }
+        return;
+    }
+    NSIndexPath *indexPath = [NSIndexPath indexPathForRow:row inSection:section];
+    UITableViewCell *cell = self.displayedCells[indexPath];
+    if (nil == cell)
+        return;
+    [self.displayedCells removeObjectForKey:indexPath];
+    if (_responds[DXStubTableViewCallbackDidEndDisplayingCell]) {
+        startTime = [self willSendCallback];
+        [self.delegate tableView:self didEndDisplayingCell:cell forRowAtIndexPath:indexPath];
+        [self didSendCallback:DXStubTableViewCallbackDidEndDisplayingCell startTime:startTime];
+    }
+    if (nil != cell.reuseIdentifier)
+        [[self reusePoolForIdentifier:cell.reuseIdentifier] addObject:cell];
+}
+
+- (void)prefetchBelowItem:(NSInteger)item
+{
+    if (nil == self.prefetchDataSource)
+        return;
+    NSMutableSet *window = [NSMutableSet set];
+    for (NSInteger next = item; next < _itemCount && window.count < self.prefetchDistance; ++next) {
+        NSInteger section = [self sectionOfItem:next];
+        NSInteger row = [self rowOfItem:next inSection:section];
+        if (NSNotFound != row && NSIntegerMax != row)
+            [window addObject:[NSIndexPath indexPathForRow:row inSection:section]];
+    }
+    NSMutableSet *cancelled = [self.prefetchedIndexPaths mutableCopy];
+    [cancelled minusSet:window];
+    [window minusSet:self.prefetchedIndexPaths];
+    uint64_t startTime;
+    if (0 != cancelled.count && _responds[DXStubTableViewCallbackCancelPrefetching]) {
+        NSArray *indexPaths = [cancelled.allObjects sortedArrayUsingSelector:@selector(compare:)];
+        startTime = [self willSendCallback];
+        [self.prefetchDataSource tableView:self cancelPrefetchingForRowsAtIndexPaths:indexPaths];
+        [self didSendCallback:DXStubTableViewCallbackCancelPrefetching startTime:startTime];
+    }
+    if (0 != window.count) {
+        NSArray *indexPaths = [window.allObjects sortedArrayUsingSelector:@selector(compare:)];
+        startTime = [self willSendCallback];
+        [self.prefetchDataSource tableView:self prefetchRowsAtIndexPaths:indexPaths];
+        [self didSendCallback:DXStubTableViewCallbackPrefetchRows startTime:startTime];
+    }
+    [self.prefetchedIndexPaths minusSet:cancelled];
+    [self.prefetchedIndexPaths unionSet:window];
+}
+
+#pragma mark - Scrolling
+
+- (void)scrollToOffset:(CGFloat)offset
+{
+    self.frameCount++;
+    self.simulatedContentOffset = offset;
+    NSInteger firstItem = [self itemEndingBelowOffset:offset];
+    NSInteger lastItem = [self itemStartingAtOrBelowOffset:offset + self.viewportHeight];
+    for (NSInteger item = _firstVisibleItem; item < _lastVisibleItem; ++item) {
+        if (item < firstItem || item >= lastItem)
+            [self endDisplayingItem:item];
+    }
+    for (NSInteger item = firstItem; item < lastItem; ++item) {
+        if (item < _firstVisibleItem || item >= _lastVisibleItem)
+            [self displayItem:item];
+    }
+    _firstVisibleItem = firstItem;
+    _lastVisibleItem = lastItem;
+    [self prefetchBelowItem:lastItem];
+}
+
+- (NSUInteger)scrollThroughContentWithStep:(CGFloat)step
+{
+    NSUInteger frames = 0;
+    CGFloat maximumOffset = MAX(self.simulatedContentHeight - self.viewportHeight, 0.0);
+    for (CGFloat offset = 0.0; offset < maximumOffset; offset += step, ++frames)
+        [self scrollToOffset:offset];
+    [self scrollToOffset:maximumOffset];
+    return frames + 1;
+}
+
+- (void)endDisplayingAllItems
+{
+    for (NSInteger item = _firstVisibleItem; item < _lastVisibleItem; ++item)
+        [self endDisplayingItem:item];
+    _firstVisibleItem = _lastVisibleItem = 0;
+}
+
+- (void)simulateSelectionOfRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    if (!_responds[DXStubTableViewCallbackDidSelectRow])
+        return;
+    uint64_t startTime = [self willSendCallback];
+    [self.delegate tableView:self didSelectRowAtIndexPath:indexPath];
+    [self didSendCallback:DXStubTableViewCallbackDidSelectRow startTime:startTime];
+}
+
+#pragma mark - Visible rows
+
+- (NSArray *)indexPathsForVisibleRows
+{
+    BOOL counting = [DXAllocationCounter isCounting];
+    [DXAllocationCounter setCounting:NO];
+    NSMutableArray *indexPaths = [NSMutableArray array];
+    for (NSInteger item = _firstVisibleItem; item < _lastVisibleItem; ++item) {
+        NSInteger section = [self sectionOfItem:item];
+        NSInteger row = [self rowOfItem:item inSection:section];
+        if (NSNotFound != row && NSIntegerMax != row && _itemOffsets[item + 1] > _itemOffsets[item])
+            [indexPaths addObject:[NSIndexPath indexPathForRow:row inSection:section]];
+    }
+    [DXAllocationCounter setCounting:counting];
+    return indexPaths;
+}
+
+- (NSArray *)visibleCells
+{
+    return self.displayedCells.allValues;
+}
+
+- (UITableViewCell *)cellForRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    return self.displayedCells[indexPath];
+}
+
+#pragma mark - Reloading and updates
+
+- (void)reloadData
+{
+    self.reloadCount++;
+    [self endDisplayingAllItems];
+    [self.prefetchedIndexPaths removeAllObjects];
+    [self layoutContents];
+    [self scrollToOffset:MIN(self.simulatedContentOffset, MAX(self.simulatedContentHeight - self.viewportHeight, 0.0))];
+}
+
+- (void)beginUpdates
+{
+    _updatesDepth++;
+}
+
+- (void)endUpdates
+{
+    if (0 == --_updatesDepth)
+        [self applyUpdates];
+}
+
+- (void)recordRowAnimation:(UITableViewRowAnimation)animation
+{
+    self.lastRowAnimation = animation;
+    if (nil == self.usedRowAnimations)
+        self.usedRowAnimations = [NSMutableSet set];
+    [self.usedRowAnimations addObject:@(animation)];
+}
+
+// UIKit asks for contents again after every update, displayed rows are asked for their cells once more
+- (void)applyUpdates
+{
+    if (0 != _updatesDepth)
+        return;
+    self.updateCount++;
+    [self endDisplayingAllItems];
+    [self layoutContents];
+    [self scrollToOffset:MIN(self.simulatedContentOffset, MAX(self.simulatedContentHeight - self.viewportHeight, 0.0))];
+}
+
+- (void)insertSections:(NSIndexSet *)sections withRowAnimation:(UITableViewRowAnimation)animation
+{
+    [self recordRowAnimation:animation];
+    self.insertedSectionCount += sections.count;
+    [self applyUpdates];
+}
+
+- (void)deleteSections:(NSIndexSet *)sections withRowAnimation:(UITableViewRowAnimation)animation
+{
+    [self recordRowAnimation:animation];
+    self.deletedSectionCount += sections.count;
+    [self applyUpdates];
+}
+
+- (void)reloadSections:(NSIndexSet *)sections withRowAnimation:(UITableViewRowAnimation)animation
+{
+    [self recordRowAnimation:animation];
+    self.reloadedSectionCount += sections.count;
+    [self applyUpdates];
+}
+
+- (void)moveSection:(NSInteger)section toSection:(NSInteger)newSection
+{
+    self.movedSectionCount++;
+    [self applyUpdates];
+}
+
+- (void)insertRowsAtIndexPaths:(NSArray *)indexPaths withRowAnimation:(UITableViewRowAnimation)animation
+{
+    [self recordRowAnimation:animation];
+    self.insertedRowCount += indexPaths.count;
+    [self applyUpdates];
+}
+
+- (void)deleteRowsAtIndexPaths:(NSArray *)indexPaths withRowAnimation:(UITableViewRowAnimation)animation
+{
+    [self recordRowAnimation:animation];
+    self.deletedRowCount += indexPaths.count;
+    [self applyUpdates];
+}
+
+- (void)reloadRowsAtIndexPaths:(NSArray *)indexPaths withRowAnimation:(UITableViewRowAnimation)animation
+{
+    [self recordRowAnimation:animation];
+    self.reloadedRowCount += indexPaths.count;
+    if (nil == self.mutableReloadedIndexPathBatches)
+        self.mutableReloadedIndexPathBatches = [NSMutableArray array];
+    [self.mutableReloadedIndexPathBatches addObject:indexPaths.copy];
+    [self applyUpdates];
+}
+
+- (void)moveRowAtIndexPath:(NSIndexPath *)indexPath toIndexPath:(NSIndexPath *)newIndexPath
+{
+    self.movedRowCount++;
+    [self applyUpdates];
+}
+
+- (void)deselectRowAtIndexPath:(NSIndexPath *)indexPath animated:(BOOL)animated
+{
+}
+
+#pragma mark - Reuse
+
+- (NSMutableArray *)reusePoolForIdentifier:(NSString *)identifier
+{
+    NSMutableArray *pool = self.reusableCells[identifier];
+    if (nil == pool) {
+        pool = [NSMutableArray array];
+        self.reusableCells[identifier] = pool;
+    }
+    return pool;
+}
+
+- (void)registerClass:(Class)cellClass forCellReuseIdentifier:(NSString *)identifier
+{
+    self.cellClasses[identifier] = cellClass;
+    ++self.registrationCount;
+}
+
+- (void)registerNib:(UINib *)nib forCellReuseIdentifier:(NSString *)identifier
+{
+    self.cellNibs[identifier] = nib;
+    ++self.registrationCount;
+}
+
+- (void)registerClass:(Class)aClass forHeaderFooterViewReuseIdentifier:(NSString *)identifier
+{
+    self.headerFooterClasses[identifier] = aClass;
+    ++self.registrationCount;
+}
+
+- (void)registerNib:(UINib *)nib forHeaderFooterViewReuseIdentifier:(NSString *)identifier
+{
+    ++self.registrationCount;
+}
+
+- (id)dequeueReusableCellWithIdentifier:(NSString *)identifier
+{
+    BOOL counting = [DXAllocationCounter isCounting];
+    [DXAllocationCounter setCounting:NO];
+    NSMutableArray *pool = [self reusePoolForIdentifier:identifier];
+    UITableViewCell *cell = pool.lastObject;
+    if (nil != cell) {
+        [pool removeLastObject];
+        [cell prepareForReuse];
+    }
+    else if (nil != self.cellNibs[identifier]) {
+        cell = [[self.cellNibs[identifier] instantiateWithOwner:nil options:nil] firstObject];
+        self.createdCellCount++;
+    }
+    else if (nil != self.cellClasses[identifier]) {
+        cell = [[self.cellClasses[identifier] alloc] initWithStyle:UITableViewCellStyleDefault reuseIdentifier:identifier];
+        self.createdCellCount++;
+    }
+    [DXAllocationCounter setCounting:counting];
+    return cell;
+}
+
+- (id)dequeueReusableCellWithIdentifier:(NSString *)identifier forIndexPath:(NSIndexPath *)indexPath
+{
+    UITableViewCell *cell = [self dequeueReusableCellWithIdentifier:identifier];
+    if (nil == cell)
+        [NSException raise:NSInternalInconsistencyException
+                    format:@"Unable to dequeue a cell with identifier %@", identifier];
+    return cell;
+}
+
+- (id)dequeueReusableHeaderFooterViewWithIdentifier:(NSString *)identifier
+{
+    Class viewClass = self.headerFooterClasses[identifier];
+    if (Nil == viewClass)
+        return nil;
+    BOOL counting = [DXAllocationCounter isCounting];
+    [DXAllocationCounter setCounting:NO];
+    UITableViewHeaderFooterView *view = [[viewClass alloc] initWithReuseIdentifier:identifier];
+    [DXAllocationCounter setCounting:counting];
+    return view;
+}
+
+@end
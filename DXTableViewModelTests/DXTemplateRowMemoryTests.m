@@ -0,0 +1,69 @@
+//
+//  DXTemplateRowMemoryTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import "DXBenchmarkTestCase.h"
+#import "DXAllocationCounter.h"
+#import "DXTableViewRow.h"
+
+static const NSInteger DXTemplateRowMemoryNumberOfRows = 10000;
+
+@interface DXTemplateRowMemoryTests : DXBenchmarkTestCase
+@end
+
+@implementation DXTemplateRowMemoryTests
+
+// Sets properties rows of the same kind usually share
+- (void)configureRow:(DXTableViewRow *)row configureCellBlock:(void (^)(DXTableViewRow *, id))configureCellBlock
+{
+    row.cellClass = [UITableViewCell class];
+    row.rowHeight = 60.0;
+    row.estimatedRowHeight = 60.0;
+    row.editingStyle = UITableViewCellEditingStyleDelete;
+    row.configureCellBlock = configureCellBlock;
+    row.didSelectRowBlock = ^(DXTableViewRow *row) {
+    };
+}
+
+- (double)bytesPerRowOfRowsBuiltWithBlock:(DXTableViewRow *(^)(void))block
+{
+    NSMutableArray *rows = [NSMutableArray arrayWithCapacity:DXTemplateRowMemoryNumberOfRows];
+    uint64_t memoryBefore = [DXAllocationCounter allocatedMemory];
+    for (NSInteger i = 0; i < DXTemplateRowMemoryNumberOfRows; ++i)
+        [rows addObject:block()];
+    uint64_t memoryAfter = [DXAllocationCounter allocatedMemory];
+    XCTAssertEqual(rows.count, (NSUInteger)DXTemplateRowMemoryNumberOfRows);
+    return memoryAfter > memoryBefore ? (double)(memoryAfter - memoryBefore) / DXTemplateRowMemoryNumberOfRows : 0;
+}
+
+- (void)testMemoryOfTemplatedRowsComparedToStandaloneRows
+{
+    __block NSUInteger configuredCells = 0;
+    void (^configureCellBlock)(DXTableViewRow *, id) = ^(DXTableViewRow *row, UITableViewCell *cell) {
+        ++configuredCells;
+    };
+
+    double standaloneBytes = [self bytesPerRowOfRowsBuiltWithBlock:^DXTableViewRow *{
+        DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+        [self configureRow:row configureCellBlock:configureCellBlock];
+        return row;
+    }];
+
+    DXTableViewRow *templateRow = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+    [self configureRow:templateRow configureCellBlock:configureCellBlock];
+    double templatedBytes = [self bytesPerRowOfRowsBuiltWithBlock:^DXTableViewRow *{
+        return [[DXTableViewRow alloc] initWithTemplateRow:templateRow];
+    }];
+
+    XCTAssertTrue(templatedBytes < standaloneBytes, @"templated rows must not keep their own copies of shared properties");
+    [self checkMetric:@"bytesPerStandaloneRow" value:standaloneBytes benchmark:@"TemplateRowMemory10k"];
+    [self checkMetric:@"bytesPerTemplatedRow" value:templatedBytes benchmark:@"TemplateRowMemory10k"];
+    [self checkMetric:@"templatedToStandaloneRatio" value:templatedBytes / MAX(standaloneBytes, 1.0)
+            benchmark:@"TemplateRowMemory10k"];
+}
+
+@end
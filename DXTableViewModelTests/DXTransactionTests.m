@@ -0,0 +1,105 @@
+//
+//  DXTransactionTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import "DXBenchmarkTestCase.h"
+#import "DXStubTableView.h"
+#import "DXTableViewModel.h"
+#import "DXTableViewSection.h"
+#import "DXTableViewRow.h"
+
+static const NSInteger DXTransactionNumberOfSections = 100;
+static const NSInteger DXTransactionRowsPerSection = 100;
+
+@interface DXTransactionTests : DXBenchmarkTestCase
+
+@property (strong, nonatomic) DXTableViewModel *tableViewModel;
+@property (strong, nonatomic) DXStubTableView *tableView;
+
+@end
+
+@implementation DXTransactionTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.tableViewModel = [[DXTableViewModel alloc] init];
+    for (NSInteger s = 0; s < DXTransactionNumberOfSections; ++s) {
+        DXTableViewSection *section = [[DXTableViewSection alloc] initWithName:[NSString stringWithFormat:@"%ld", (long)s]];
+        NSMutableArray *rows = [NSMutableArray arrayWithCapacity:DXTransactionRowsPerSection];
+        for (NSInteger r = 0; r < DXTransactionRowsPerSection; ++r)
+            [rows addObject:[self row]];
+        [section addRows:rows];
+        [self.tableViewModel addSection:section];
+    }
+    self.tableView = [[DXStubTableView alloc] initWithViewportHeight:568.0];
+    self.tableViewModel.tableView = self.tableView;
+    [self.tableView reloadData];
+    [self.tableView resetStatistics];
+}
+
+- (void)tearDown
+{
+    self.tableViewModel.tableView = nil;
+    self.tableViewModel = nil;
+    self.tableView = nil;
+    [super tearDown];
+}
+
+- (DXTableViewRow *)row
+{
+    DXTableViewRow *row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+    row.cellClass = [UITableViewCell class];
+    return row;
+}
+
+- (void)testEachManipulationKeepsItsAnimation
+{
+    DXTableViewSection *first = [self.tableViewModel sectionWithName:@"0"];
+    DXTableViewSection *second = [self.tableViewModel sectionWithName:@"1"];
+
+    [self.tableViewModel beginUpdates];
+    [first insertRows:@[[self row]] atIndex:0 withRowAnimation:UITableViewRowAnimationFade];
+    [second deleteRows:@[[second rowAtIndex:0]] withRowAnimation:UITableViewRowAnimationLeft];
+    [self.tableViewModel endUpdates];
+
+    XCTAssertEqual(self.tableView.insertedRowCount, (NSUInteger)1);
+    XCTAssertEqual(self.tableView.deletedRowCount, (NSUInteger)1);
+    XCTAssertEqualObjects(self.tableView.rowAnimations,
+                          ([NSSet setWithObjects:@(UITableViewRowAnimationFade), @(UITableViewRowAnimationLeft), nil]));
+}
+
+- (void)testManipulationWithoutAnimationIsAppliedOnce
+{
+    DXTableViewSection *section = [self.tableViewModel sectionWithName:@"50"];
+
+    [self.tableViewModel beginUpdates];
+    [section addRows:@[[self row], [self row]]];
+    [self.tableViewModel endUpdates];
+
+    XCTAssertEqual(self.tableView.insertedRowCount, (NSUInteger)2);
+    XCTAssertEqual(self.tableView.deletedRowCount, (NSUInteger)0);
+    XCTAssertEqual(self.tableView.movedRowCount, (NSUInteger)0);
+    XCTAssertEqual(section.numberOfRows, DXTransactionRowsPerSection + 2);
+}
+
+// One row inserted into one of 100 sections of 100 rows: transaction diffs only the changed section
+- (void)testTransactionCostsAsMuchAsSectionsItTouches
+{
+    DXTableViewSection *section = [self.tableViewModel sectionWithName:@"50"];
+    double nanoseconds = [self nanosecondsPerIteration:20 ofBlock:^{
+        [self.tableViewModel beginUpdates];
+        [section insertRows:@[[self row]] atIndex:0 withRowAnimation:UITableViewRowAnimationFade];
+        [self.tableViewModel endUpdates];
+    }];
+
+    XCTAssertEqual(self.tableView.movedRowCount, (NSUInteger)0);
+    XCTAssertEqual(self.tableView.deletedRowCount, (NSUInteger)0);
+    [self checkMetric:@"nanosecondsPerTransaction" value:nanoseconds benchmark:@"Transaction100x100"];
+}
+
+@end
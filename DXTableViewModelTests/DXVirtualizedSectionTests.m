@@ -0,0 +1,145 @@
+//
+//  DXVirtualizedSectionTests.m
+//  DXTableViewModel
+//
+//  Created by Alexander Ignatenko on 10/17/13.
+//  Copyright (c) 2013 Alexander Ignatenko. All rights reserved.
+//
+
+#import "DXBenchmarkTestCase.h"
+#import "DXStubTableView.h"
+#import "DXAllocationCounter.h"
+#import "DXTableViewModel.h"
+#import "DXTableViewSection.h"
+#import "DXTableViewRow.h"
+
+@interface DXVirtualizedSectionTests : DXBenchmarkTestCase
+@end
+
+@implementation DXVirtualizedSectionTests
+
+- (DXTableViewSection *)virtualizedSectionWithItems:(NSArray *)items
+{
+    DXTableViewSection *section = [[DXTableViewSection alloc] initWithName:@"Items"];
+    section.headerHeight = 28.0;
+    section.footerHeight = 0.0;
+    [section virtualizeWithNumberOfRows:items.count rowBlock:^DXTableViewRow *(DXTableViewSection *section, NSInteger index, DXTableViewRow *reusableRow) {
+        DXTableViewRow *row = reusableRow;
+        if (nil == row) {
+            row = [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+            row.cellClass = [UITableViewCell class];
+        }
+        [row bindObject:items[index] withKeyPath:@"title"];
+        return row;
+    }];
+    return section;
+}
+
+- (NSArray *)itemsWithCount:(NSInteger)count
+{
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:count];
+    for (NSInteger i = 0; i < count; ++i)
+        [items addObject:[NSMutableDictionary dictionaryWithObject:[NSString stringWithFormat:@"%ld", (long)i] forKey:@"title"]];
+    return items;
+}
+
+- (void)testUpdateRowObjectsWritesMaterializedRows
+{
+    NSArray *items = [self itemsWithCount:1000];
+    DXTableViewModel *tableViewModel = [[DXTableViewModel alloc] init];
+    [tableViewModel addSection:[self virtualizedSectionWithItems:items]];
+
+    DXTableViewRow *row = [tableViewModel rowAtIndex:500 inSectionAtIndex:0];
+    row[@"title"] = @"edited";
+    NSMapTable *writtenKeyPathsByRow = [tableViewModel updateRowObjectsReturningWrittenKeyPaths];
+
+    XCTAssertEqualObjects(items[500][@"title"], @"edited");
+    XCTAssertEqualObjects([writtenKeyPathsByRow objectForKey:row], [NSSet setWithObject:@"title"]);
+
+    items[500][@"title"] = @"reloaded";
+    [tableViewModel reloadRowBoundData];
+    XCTAssertEqualObjects(row[@"title"], @"reloaded");
+}
+
+- (void)testReusedRowDoesNotKeepPrefetchOfPreviousObject
+{
+    NSArray *items = [self itemsWithCount:1000];
+    DXTableViewModel *tableViewModel = [[DXTableViewModel alloc] init];
+    DXTableViewSection *section = [self virtualizedSectionWithItems:items];
+    section.maximumNumberOfMaterializedRows = 40;
+    NSMutableArray *completions = [NSMutableArray array];
+    __block NSUInteger cancelledPrefetches = 0;
+    section.prefetchRowBlock = ^(DXTableViewRow *row, void (^completion)(NSDictionary *)) {
+        [completions addObject:[completion copy]];
+    };
+    section.cancelPrefetchRowBlock = ^(DXTableViewRow *row) {
+        ++cancelledPrefetches;
+    };
+    [tableViewModel addSection:section];
+    DXStubTableView *tableView = [[DXStubTableView alloc] initWithViewportHeight:568.0];
+    tableViewModel.tableView = tableView;
+    [tableView reloadData];
+    NSArray *firstScreenCompletions = completions.copy;
+    XCTAssertTrue(firstScreenCompletions.count > 0);
+
+    // rows of the first screen are evicted and reused while their prefetches are still loading
+    [tableView scrollToOffset:44.0 * 500];
+    XCTAssertTrue(cancelledPrefetches > 0, @"loading prefetches of detached rows have to be cancelled");
+    for (void (^completion)(NSDictionary *) in firstScreenCompletions)
+        completion(@{@"avatar": @"stale"});
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+
+    for (NSIndexPath *indexPath in tableView.indexPathsForVisibleRows) {
+        DXTableViewRow *row = [tableViewModel rowAtIndexPath:indexPath];
+        XCTAssertNil(row[@"avatar"], @"data prefetched for previous object must not reach reused row");
+    }
+    tableViewModel.tableView = nil;
+}
+
+- (void)testVirtualizedSectionIsSingleSpanOfEstimatedHeights
+{
+    DXTableViewModel *tableViewModel = [[DXTableViewModel alloc] init];
+    DXTableViewSection *section = [[DXTableViewSection alloc] initWithName:@"Items"];
+    section.headerHeight = 28.0;
+    section.footerHeight = 0.0;
+    [section virtualizeWithNumberOfRows:1000000 rowBlock:^DXTableViewRow *(DXTableViewSection *section, NSInteger index, DXTableViewRow *reusableRow) {
+        return reusableRow ?: [[DXTableViewRow alloc] initWithCellReuseIdentifier:@"Cell"];
+    }];
+    [tableViewModel addSection:section];
+    DXStubTableView *tableView = [[DXStubTableView alloc] initWithViewportHeight:568.0];
+    tableViewModel.tableView = tableView;
+
+    XCTAssertEqualWithAccuracy(tableViewModel.contentHeight, 28.0 + 1000000 * 44.0, 1.0);
+    XCTAssertNil([tableViewModel indexPathForRowAtOffset:10.0], @"offset of header");
+    XCTAssertEqual([[tableViewModel indexPathForRowAtOffset:28.0 + 44.0 * 500000 + 1.0] row], (NSInteger)500000);
+    XCTAssertEqual([[tableViewModel indexPathForRowAtOffset:28.0 + 44.0 * 1000000 - 1.0] row], (NSInteger)999999);
+    tableViewModel.tableView = nil;
+}
+
+- (void)testMemoryOfScrollingMillionVirtualizedRows
+{
+    NSArray *items = [self itemsWithCount:1000000];
+    uint64_t memoryBefore = [DXAllocationCounter residentMemory];
+    DXTableViewModel *tableViewModel = [[DXTableViewModel alloc] init];
+    [tableViewModel addSection:[self virtualizedSectionWithItems:items]];
+    DXStubTableView *tableView = [[DXStubTableView alloc] initWithViewportHeight:568.0];
+    tableViewModel.tableView = tableView;
+    [tableView reloadData];
+
+    uint64_t peakMemory = [DXAllocationCounter residentMemory];
+    // a few seconds of fast fling in the middle of the section
+    CGFloat offset = 44.0 * 500000;
+    for (NSInteger frame = 0; frame < 300; ++frame, offset += 284.0) {
+        [tableView scrollToOffset:offset];
+        (void)tableViewModel.contentHeight;
+        if (0 == frame % 50)
+            peakMemory = MAX(peakMemory, [DXAllocationCounter residentMemory]);
+    }
+    peakMemory = MAX(peakMemory, [DXAllocationCounter residentMemory]);
+
+    [self checkMetric:@"peakMemoryBytes" value:peakMemory > memoryBefore ? peakMemory - memoryBefore : 0
+            benchmark:@"VirtualizedSection1M"];
+    tableViewModel.tableView = nil;
+}
+
+@end